@@ -0,0 +1,407 @@
+/**
+ * @author Sebastiaan Heins
+ * @file allocator.h
+ * @brief A slab allocator for the small values the interpreter creates all the time, like the payloads of numbers and temporary variables
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the scalar payloads (up to a LONG or DOUBLE) and strings up to 7 characters fit in the first class,
+// strings up to 15 characters in the second, a Variable struct or a string up to 31 characters in the third
+#define ALLOCATOR_CLASS_COUNT 3
+#define ALLOCATOR_SLAB_SIZE 65536
+#define ALLOCATOR_TRIM_THRESHOLD (1024 * 1024) // the default amount of free slot memory before empty slabs are released
+#define ALLOCATOR_TRIM_STEP 4 // the most empty slabs released at once, the rest waits for the next scope that ends
+
+static const size_t ALLOCATOR_CLASS_SIZES[ALLOCATOR_CLASS_COUNT] = { 8, 16, 32 };
+
+/**
+ * @brief A block of memory cut into slots of one size, it keeps the slots that were freed
+*/
+typedef struct Slab Slab;
+struct Slab {
+    char* memory;
+    int size_class;
+    void* free_list; // every free slot stores the pointer to the next one
+    int free_count;
+    Slab* previous; // the neighbours in the list the slab is in, a slab without free slots is in no list
+    Slab* next;
+};
+
+/**
+ * @brief The slots of one size, the slabs with free slots hand them out before a slab is cut up further
+*/
+typedef struct {
+    Slab* partial; // the slabs with free slots that still have slots in use
+    Slab* current; // the slab that is being cut up
+    char* next_slot; // the untouched part of the current slab
+    char* slab_end;
+} SizeClass;
+
+/**
+ * @brief An allocator owned by a process, all of it's memory is released at once when the process is destroyed
+*/
+typedef struct Allocator Allocator;
+struct Allocator {
+    SizeClass classes[ALLOCATOR_CLASS_COUNT];
+    Slab** slabs; // sorted by address, so freeValue can find the slab a pointer belongs to
+    char** addresses; // the memory of every slab in slabs, kept next to it so a search doesn't touch the slabs themselves
+    int slab_count;
+    Slab* empty; // the slabs that only have free slots, they're cut up again or released by a trim
+    size_t free_bytes; // the memory of the free slots
+    size_t trim_threshold; // the least amount of free memory before empty slabs are released
+    Allocator* parent; // the allocator of the process a worker thread runs for, NULL when there is none
+    void* deferred; // the values of the parent the worker freed, every one stores the pointer to the next one
+};
+
+// the allocator used by allocValue and freeValue, NULL falls back to malloc and free, every thread has it's own
+_Thread_local Allocator* active_allocator = NULL;
+
+/**
+ * @brief Create an allocator
+ * @return The allocator
+ * @warning The allocator must be destroyed after use
+*/
+Allocator* createAllocator ();
+
+/**
+ * @brief Destroy an allocator, releasing all of it's slabs at once
+ * @param allocator The allocator to destroy
+ * @warning Everything allocated from it is gone, also the values that weren't freed
+*/
+void destroyAllocator (Allocator* allocator);
+
+/**
+ * @brief Allocate a small value from the active allocator
+ * @param size The size of the value, values larger than the biggest class are allocated with malloc
+ * @return The pointer to the value (must be freed with freeValue)
+*/
+void* allocValue (size_t size);
+
+/**
+ * @brief Copy a string into a value from the active allocator, short strings don't need a malloc
+ * @param str The string to copy
+ * @return The copy (must be freed with freeValue, and never be reallocated)
+*/
+char* allocString (const char* str);
+
+/**
+ * @brief Free a value, either from allocValue or malloc
+ * @param ptr The pointer to the value
+*/
+void freeValue (void* ptr);
+
+/**
+ * @brief Give a slot back to the slab it belongs to
+ * @param allocator The allocator the slab belongs to
+ * @param slab The slab
+ * @param ptr The slot
+*/
+void freeSlot (Allocator* allocator, Slab* slab, void* ptr);
+
+/**
+ * @brief Release empty slabs back to the system
+ * @param allocator The allocator
+ * @param limit The most slabs to release
+ * @return The amount of released slabs
+ * @note The empty slabs are kept in a list, so the work doesn't grow with the size of the heap
+*/
+int trimAllocator (Allocator* allocator, int limit);
+
+/**
+ * @brief Move the slabs of a worker allocator into the allocator of it's parent, so the values the worker made outlive it
+ * @param allocator The parent allocator
+ * @param worker The worker allocator, it's freed
+ * @note The values of the parent the worker freed are given back to the parent now, no other thread may use either allocator while they're merged
+*/
+void mergeAllocator (Allocator* allocator, Allocator* worker);
+
+/**
+ * @brief Give a size class a new slab to cut up, an empty slab is reused before a new one is made
+ * @param allocator The allocator
+ * @param size_class The index of the size class
+*/
+void addSlab (Allocator* allocator, int size_class);
+
+/**
+ * @brief Find the slab a pointer belongs to
+ * @param allocator The allocator
+ * @param ptr The pointer
+ * @return The slab, or NULL when the pointer isn't from this allocator
+*/
+Slab* findSlab (Allocator* allocator, const void* ptr);
+
+/**
+ * @brief Add a slab to the front of a list of slabs
+ * @param list The first slab of the list
+ * @param slab The slab
+*/
+void linkSlab (Slab** list, Slab* slab);
+
+/**
+ * @brief Take a slab out of a list of slabs
+ * @param list The first slab of the list
+ * @param slab The slab
+*/
+void unlinkSlab (Slab** list, Slab* slab);
+
+
+Allocator* createAllocator () {
+    Allocator* allocator = malloc(sizeof(Allocator));
+    for (int i = 0; i < ALLOCATOR_CLASS_COUNT; i++) {
+        allocator->classes[i].partial = NULL;
+        allocator->classes[i].current = NULL;
+        allocator->classes[i].next_slot = NULL;
+        allocator->classes[i].slab_end = NULL;
+    }
+    allocator->slabs = NULL;
+    allocator->addresses = NULL;
+    allocator->slab_count = 0;
+    allocator->empty = NULL;
+    allocator->free_bytes = 0;
+    allocator->trim_threshold = ALLOCATOR_TRIM_THRESHOLD;
+    allocator->parent = NULL;
+    allocator->deferred = NULL;
+    return allocator;
+}
+
+void destroyAllocator (Allocator* allocator) {
+    if (active_allocator == allocator) active_allocator = NULL;
+    for (int i = 0; i < allocator->slab_count; i++) {
+        free(allocator->slabs[i]->memory);
+        free(allocator->slabs[i]);
+    }
+    free(allocator->slabs);
+    free(allocator->addresses);
+    free(allocator);
+}
+
+void* allocValue (size_t size) {
+    Allocator* allocator = active_allocator;
+    if (allocator == NULL) return malloc(size);
+
+    for (int i = 0; i < ALLOCATOR_CLASS_COUNT; i++) {
+        if (size > ALLOCATOR_CLASS_SIZES[i]) continue;
+
+        SizeClass* size_class = &allocator->classes[i];
+        Slab* slab = size_class->partial;
+        if (slab != NULL) {
+            void* slot = slab->free_list;
+            slab->free_list = *(void**)slot;
+            slab->free_count--;
+            if (slab->free_count == 0) unlinkSlab(&size_class->partial, slab);
+            allocator->free_bytes -= ALLOCATOR_CLASS_SIZES[i];
+            return slot;
+        }
+        if (size_class->next_slot == size_class->slab_end) {
+            addSlab(allocator, i);
+        }
+        void* slot = size_class->next_slot;
+        size_class->next_slot += ALLOCATOR_CLASS_SIZES[i];
+        return slot;
+    }
+    return malloc(size);
+}
+
+char* allocString (const char* str) {
+    size_t size = strlen(str) + 1;
+    char* copy = allocValue(size);
+    memcpy(copy, str, size);
+    return copy;
+}
+
+void freeValue (void* ptr) {
+    if (ptr == NULL) return;
+    Allocator* allocator = active_allocator;
+    Slab* slab = allocator == NULL ? NULL : findSlab(allocator, ptr);
+    if (slab == NULL) {
+        if (allocator != NULL && allocator->parent != NULL && findSlab(allocator->parent, ptr) != NULL) {
+            // the parent isn't thread safe, it gets the value back when the worker is merged into it
+            *(void**)ptr = allocator->deferred;
+            allocator->deferred = ptr;
+            return;
+        }
+        free(ptr);
+        return;
+    }
+    freeSlot(allocator, slab, ptr);
+}
+
+void freeSlot (Allocator* allocator, Slab* slab, void* ptr) {
+    SizeClass* size_class = &allocator->classes[slab->size_class];
+    *(void**)ptr = slab->free_list;
+    slab->free_list = ptr;
+    slab->free_count++;
+    allocator->free_bytes += ALLOCATOR_CLASS_SIZES[slab->size_class];
+    if (slab->free_count == 1) linkSlab(&size_class->partial, slab);
+
+    // a slab that is no longer being cut up is empty when all of it's slots are free
+    if (slab != size_class->current && slab->free_count == (int)(ALLOCATOR_SLAB_SIZE / ALLOCATOR_CLASS_SIZES[slab->size_class])) {
+        unlinkSlab(&size_class->partial, slab);
+        linkSlab(&allocator->empty, slab);
+    }
+}
+
+int trimAllocator (Allocator* allocator, int limit) {
+    int released = 0;
+    while (released < limit && allocator->empty != NULL) {
+        Slab* slab = allocator->empty;
+        unlinkSlab(&allocator->empty, slab);
+        allocator->free_bytes -= slab->free_count * ALLOCATOR_CLASS_SIZES[slab->size_class];
+
+        // the slab is found like freeValue finds it, the slabs after it move back one place
+        int index = 0;
+        int high = allocator->slab_count - 1;
+        while (index < high) {
+            int middle = (index + high) / 2;
+            if (allocator->addresses[middle] < slab->memory) index = middle + 1;
+            else high = middle;
+        }
+        memmove(&allocator->slabs[index], &allocator->slabs[index + 1], sizeof(Slab*) * (allocator->slab_count - index - 1));
+        memmove(&allocator->addresses[index], &allocator->addresses[index + 1], sizeof(char*) * (allocator->slab_count - index - 1));
+        allocator->slab_count--;
+        free(slab->memory);
+        free(slab);
+        released++;
+    }
+    return released;
+}
+
+void mergeAllocator (Allocator* allocator, Allocator* worker) {
+    for (int i = 0; i < ALLOCATOR_CLASS_COUNT; i++) {
+        // the slots the worker never handed out become free slots, so it's slabs can be emptied and released like the others
+        SizeClass* size_class = &worker->classes[i];
+        Slab* current = size_class->current;
+        size_class->current = NULL;
+        while (size_class->next_slot != size_class->slab_end) {
+            freeSlot(worker, current, size_class->next_slot);
+            size_class->next_slot += ALLOCATOR_CLASS_SIZES[i];
+        }
+        while (size_class->partial != NULL) {
+            Slab* slab = size_class->partial;
+            unlinkSlab(&size_class->partial, slab);
+            linkSlab(&allocator->classes[i].partial, slab);
+        }
+    }
+    while (worker->empty != NULL) {
+        Slab* slab = worker->empty;
+        unlinkSlab(&worker->empty, slab);
+        linkSlab(&allocator->empty, slab);
+    }
+    allocator->free_bytes += worker->free_bytes;
+
+    // both lists of slabs are sorted by address, they're merged from the back
+    int length = allocator->slab_count + worker->slab_count;
+    allocator->slabs = realloc(allocator->slabs, sizeof(Slab*) * (length + 1));
+    allocator->addresses = realloc(allocator->addresses, sizeof(char*) * (length + 1));
+    int left = allocator->slab_count - 1;
+    int right = worker->slab_count - 1;
+    for (int i = length - 1; right >= 0; i--) {
+        if (left >= 0 && allocator->addresses[left] > worker->addresses[right]) {
+            allocator->addresses[i] = allocator->addresses[left];
+            allocator->slabs[i] = allocator->slabs[left--];
+        } else {
+            allocator->addresses[i] = worker->addresses[right];
+            allocator->slabs[i] = worker->slabs[right--];
+        }
+    }
+    allocator->slab_count = length;
+
+    void* slot = worker->deferred;
+    while (slot != NULL) {
+        void* next_slot = *(void**)slot;
+        freeSlot(allocator, findSlab(allocator, slot), slot);
+        slot = next_slot;
+    }
+
+    if (active_allocator == worker) active_allocator = allocator;
+    free(worker->slabs);
+    free(worker->addresses);
+    free(worker);
+}
+
+void addSlab (Allocator* allocator, int size_class) {
+    SizeClass* classes = &allocator->classes[size_class];
+
+    // the slab that was cut up to the end may have been emptied in the meantime
+    Slab* previous = classes->current;
+    classes->current = NULL;
+    if (previous != NULL && previous->free_count == (int)(ALLOCATOR_SLAB_SIZE / ALLOCATOR_CLASS_SIZES[previous->size_class])) {
+        unlinkSlab(&classes->partial, previous);
+        linkSlab(&allocator->empty, previous);
+    }
+
+    Slab* slab = allocator->empty;
+    if (slab != NULL) {
+        // an empty slab is cut up again, it may have held slots of another size
+        unlinkSlab(&allocator->empty, slab);
+        allocator->free_bytes -= slab->free_count * ALLOCATOR_CLASS_SIZES[slab->size_class];
+    } else {
+        slab = malloc(sizeof(Slab));
+        slab->memory = malloc(ALLOCATOR_SLAB_SIZE);
+
+        // keep the slabs sorted by address
+        allocator->slabs = realloc(allocator->slabs, sizeof(Slab*) * (allocator->slab_count + 1));
+        allocator->addresses = realloc(allocator->addresses, sizeof(char*) * (allocator->slab_count + 1));
+        int index = allocator->slab_count;
+        while (index > 0 && allocator->addresses[index - 1] > slab->memory) {
+            allocator->slabs[index] = allocator->slabs[index - 1];
+            allocator->addresses[index] = allocator->addresses[index - 1];
+            index--;
+        }
+        allocator->slabs[index] = slab;
+        allocator->addresses[index] = slab->memory;
+        allocator->slab_count++;
+    }
+    slab->size_class = size_class;
+    slab->free_list = NULL;
+    slab->free_count = 0;
+    slab->previous = NULL;
+    slab->next = NULL;
+
+    // the slots at the end that don't fill a whole slot are left unused
+    classes->current = slab;
+    classes->next_slot = slab->memory;
+    classes->slab_end = slab->memory + ALLOCATOR_SLAB_SIZE - ALLOCATOR_SLAB_SIZE % ALLOCATOR_CLASS_SIZES[size_class];
+}
+
+Slab* findSlab (Allocator* allocator, const void* ptr) {
+    const char* address = ptr;
+    int low = 0;
+    int high = allocator->slab_count - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        if (address < allocator->addresses[middle]) {
+            high = middle - 1;
+        } else if (address >= allocator->addresses[middle] + ALLOCATOR_SLAB_SIZE) {
+            low = middle + 1;
+        } else {
+            return allocator->slabs[middle];
+        }
+    }
+    return NULL;
+}
+
+void linkSlab (Slab** list, Slab* slab) {
+    slab->previous = NULL;
+    slab->next = *list;
+    if (*list != NULL) (*list)->previous = slab;
+    *list = slab;
+}
+
+void unlinkSlab (Slab** list, Slab* slab) {
+    if (slab->previous != NULL) slab->previous->next = slab->next;
+    else *list = slab->next;
+    if (slab->next != NULL) slab->next->previous = slab->previous;
+    slab->previous = NULL;
+    slab->next = NULL;
+}
+
+#endif
@@ -13,12 +13,27 @@
 #include "node.h"
 #include "parser.h"
 #include "lexer.h"
+#include "variable.h"
+
+/**
+ * @brief The value of an expression the optimizer hoisted out of a loop, it's evaluated the first time it's needed in every run of the loop
+*/
+typedef struct {
+    Variable value;
+    long long int bound; // on the first slot of a FOR loop the largest index the loop variable takes (-1 when it isn't always an index), on a bounds slot whether the index is in bounds
+    int loop; // the first slot of the loop this slot belongs to, the slots of a loop are next to each other
+    int valid; // whether the value has been evaluated in this run of the loop
+} InvariantSlot;
 
 typedef struct {
     char* full_code;
     Token* tokens;
+    int token_count;
     Node root;
     char* filename;
+    Variable* constants; // the constant pool, holds the values of nodes folded by the optimizer
+    InvariantSlot* invariants; // the values of the expressions hoisted out of loops by the optimizer
+    int invariant_count;
 } AST;
 
 /**
@@ -91,7 +106,12 @@ AST loadAST (const char* filename, const char* full_code) {
     ast.tokens = NULL;
     tokenise(&ast.tokens, ast.full_code, strlen(ast.full_code));
 
-    ast.root = parse(ast.full_code, ast.tokens, 0, getTokenAmount(ast.tokens)-1, NODE_PROGRAM);
+    ast.token_count = getTokenAmount(ast.tokens);
+
+    ast.root = parse(ast.full_code, ast.tokens, 0, ast.token_count-1, NODE_PROGRAM);
+    ast.constants = NULL;
+    ast.invariants = NULL;
+    ast.invariant_count = 0;
 
     return ast;
 }
@@ -99,6 +119,16 @@ AST loadAST (const char* filename, const char* full_code) {
 void destroyAST (AST* ast) {
     if (ast->filename == NULL) return;
     destroyNode(&ast->root);
+    if (ast->constants != NULL) {
+        for (int i = 0; i < getVariablesLength(ast->constants); i++) {
+            destroyVariable(&ast->constants[i]);
+        }
+        free(ast->constants);
+    }
+    for (int i = 0; i < ast->invariant_count; i++) {
+        if (ast->invariants[i].valid) destroyVariable(&ast->invariants[i].value);
+    }
+    free(ast->invariants);
     free(ast->tokens);
     free(ast->full_code);
     free(ast->filename);
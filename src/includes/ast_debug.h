@@ -108,6 +108,18 @@ char* getNodeTypeString(NodeType type) {
 
         case NODE_BLOCK_EXPRESSION:
             return "block_expression";
+
+        case NODE_UNPARSED_BLOCK:
+            return "unparsed_block";
+
+        case NODE_IMPORT:
+            return "import";
+
+        case NODE_INLINE_CALL:
+            return "inline_call";
+
+        case NODE_INLINE_ARGUMENT:
+            return "inline_argument";
             
         case NODE_WHEN:
             return "when";
@@ -132,6 +144,9 @@ char* getNodeTypeString(NodeType type) {
 
         case NODE_IF:
             return "if";
+
+        case NODE_PFOR:
+            return "pfor";
             
         case NODE_END:
             return "NODE_END";
@@ -145,7 +160,9 @@ char* getNodeTypeString(NodeType type) {
 char* getStringFromNode (const char* full_code, const Token* tokens, const Node* node) {
     char* string = NULL;
     if (node->start > node->end) {
-        return "-invalid";
+        string = malloc(sizeof(char) * 9);
+        strcpy(string, "-invalid");
+        return string;
     }
     int string_length = tokens[node->end].end - tokens[node->start].start + 2;
     string = malloc(sizeof(char) * string_length);
@@ -187,6 +204,35 @@ void printNode (const char* full_code, const Token* tokens, const Node* node, in
     }
     printf("\"text\": \"%s\"", node->text);
 
+    if (node->constant != -1) {
+        printf(",\n");
+        for (int i = 0; i < depth+1; i++) {
+            printf("  ");
+        }
+        printf("\"constant\": %i", node->constant);
+    }
+    if (node->kernel != -1) {
+        printf(",\n");
+        for (int i = 0; i < depth+1; i++) {
+            printf("  ");
+        }
+        printf("\"kernel\": %i", node->kernel);
+    }
+    if (node->invariant != -1) {
+        printf(",\n");
+        for (int i = 0; i < depth+1; i++) {
+            printf("  ");
+        }
+        printf("\"invariant\": %i", node->invariant);
+    }
+    if (node->bounds != -1) {
+        printf(",\n");
+        for (int i = 0; i < depth+1; i++) {
+            printf("  ");
+        }
+        printf("\"bounds_check\": %i", node->bounds);
+    }
+
     if (node->body != NULL) {
         printf(",\n");
         for (int i = 0; i < depth +1; i++) {
@@ -0,0 +1,446 @@
+/**
+ * @author Sebastiaan Heins
+ * @file astcache.h
+ * @brief Stores parsed programs on disk, so unchanged scripts skip the lexer and parser on the next run
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef AST_CACHE_H
+#define AST_CACHE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <limits.h>
+#endif
+
+#include "token.h"
+#include "node.h"
+#include "parser.h"
+#include "ast.h"
+
+// bump this when the layout of the cache files or the shape of the AST changes
+#define AST_CACHE_FORMAT 6
+#define AST_CACHE_MAGIC "DAST"
+#define AST_CACHE_EXTENSION ".dast"
+#define AST_CACHE_HASH_OFFSET 14695981039346656037ULL
+#define AST_CACHE_HASH_PRIME 1099511628211ULL
+
+/**
+ * @brief The header at the start of every cache file
+*/
+typedef struct {
+    char magic[4];
+    int format;
+    unsigned long long int hash;
+    int code_length;
+    int token_count;
+    int node_count;
+    unsigned long long int checksum; // the hash of everything after the header, a file that was damaged on disk doesn't match it
+} ASTCacheHeader;
+
+/**
+ * @brief A node as stored in a cache file, the nodes are stored in preorder
+*/
+typedef struct {
+    int start, end;
+    int type;
+    int body_length;
+} ASTCacheNode;
+
+/**
+ * @brief Load an AST, reusing the cached version when the code hasn't changed since it was cached
+ * @param filename The name of the file
+ * @param full_code The full code of the file
+ * @param cache_dir The directory to keep the cache files in, NULL to disable the cache
+ * @param version The version of the interpreter, cache files of other versions are ignored
+ * @return The AST
+ * @warning The AST must be destroyed after use
+*/
+AST loadCachedAST (const char* filename, const char* full_code, const char* cache_dir, const char* version);
+
+/**
+ * @brief Get the default cache directory of the current user
+ * @return The path to the directory (don't forget to free it), or NULL when there is no home directory
+*/
+char* getDefaultASTCacheDir ();
+
+/**
+ * @brief Hash the full path of a script, the cache files of one script share it so the old ones can be removed
+ * @param filename The name of the file
+ * @return The hash
+*/
+unsigned long long int hashASTPath (const char* filename);
+
+/**
+ * @brief Add bytes to a hash (FNV-1a)
+ * @param hash The hash so far
+ * @param bytes The bytes
+ * @param size The amount of bytes
+ * @return The new hash
+*/
+unsigned long long int hashASTCacheBytes (unsigned long long int hash, const void* bytes, size_t size);
+
+/**
+ * @brief Remove the cache files of a script, except the current one
+ * @param cache_dir The directory of the cache files
+ * @param path_hash The hash of the path of the script
+ * @param keep The name of the cache file to keep
+*/
+void evictASTCache (const char* cache_dir, unsigned long long int path_hash, const char* keep);
+
+/**
+ * @brief Check if the tokens of a cache file fit the code they were read from
+ * @param tokens The tokens, terminated by a TOKEN_END
+ * @param token_count The amount of tokens
+ * @param code_length The length of the code
+ * @return 0 when the tokens are valid, 1 when they're malformed
+*/
+int checkCachedTokens (const Token* tokens, int token_count, int code_length);
+
+/**
+ * @brief Hash the code of a script together with the interpreter version (FNV-1a)
+ * @param full_code The full code
+ * @param version The version of the interpreter
+ * @return The hash
+*/
+unsigned long long int hashASTSource (const char* full_code, const char* version);
+
+/**
+ * @brief Read a cache file into an AST
+ * @param ast The AST to fill, its filename and full_code must already be set
+ * @param path The path of the cache file
+ * @param hash The expected hash of the code
+ * @return 0 on success, 1 when the file is missing or doesn't match
+*/
+int readASTCache (AST* ast, const char* path, unsigned long long int hash);
+
+/**
+ * @brief Write an AST to a cache file, the file is replaced atomically
+ * @param ast The AST to write
+ * @param path The path of the cache file
+ * @param hash The hash of the code
+ * @return 0 on success, 1 when the file couldn't be written
+*/
+int writeASTCache (const AST* ast, const char* path, unsigned long long int hash);
+
+/**
+ * @brief Rebuild a node and its children from the nodes of a cache file
+ * @param ast The AST the node belongs to
+ * @param nodes The stored nodes
+ * @param index The index of the next stored node, moved past the node and its children
+ * @param count The amount of stored nodes
+ * @param node The node to fill
+ * @return 0 on success, 1 when the stored nodes are malformed
+*/
+int readCachedNode (const AST* ast, const ASTCacheNode* nodes, int* index, const int count, Node* node);
+
+/**
+ * @brief Count the nodes in a tree
+ * @param node The root of the tree
+ * @return The amount of nodes, including the root
+*/
+int countNodes (const Node* node);
+
+/**
+ * @brief Write a node and its children to a cache file in preorder
+ * @param file The file to write to
+ * @param node The node to write
+ * @param checksum The hash of what has been written so far, the node is added to it
+*/
+void writeCachedNode (FILE* file, const Node* node, unsigned long long int* checksum);
+
+
+AST loadCachedAST (const char* filename, const char* full_code, const char* cache_dir, const char* version) {
+    if (cache_dir == NULL) return loadAST(filename, full_code);
+
+    unsigned long long int hash = hashASTSource(full_code, version);
+    unsigned long long int path_hash = hashASTPath(filename);
+    char name[64];
+    sprintf(name, "%016llx-%016llx%s", path_hash, hash, AST_CACHE_EXTENSION);
+    char* path = malloc(strlen(cache_dir) + strlen(name) + 2);
+    sprintf(path, "%s/%s", cache_dir, name);
+
+    AST ast;
+    ast.filename = malloc(strlen(filename)+1);
+    strcpy(ast.filename, filename);
+    ast.full_code = malloc(strlen(full_code)+1);
+    strcpy(ast.full_code, full_code);
+    ast.constants = NULL;
+    ast.invariants = NULL;
+    ast.invariant_count = 0;
+
+    if (readASTCache(&ast, path, hash)) {
+        free(ast.filename);
+        free(ast.full_code);
+        ast = loadAST(filename, full_code);
+        // a failed write only costs the next run a parse, a new file replaces the ones of older versions of the script
+        if (!writeASTCache(&ast, path, hash)) evictASTCache(cache_dir, path_hash, name);
+    }
+    free(path);
+    return ast;
+}
+
+char* getDefaultASTCacheDir () {
+    #ifdef _WIN32
+    const char* home = getenv("LOCALAPPDATA");
+    const char* sub = "/dosato";
+    #else
+    const char* home = getenv("HOME");
+    const char* sub = "/.cache/dosato";
+    #endif
+    if (home == NULL || home[0] == '\0') return NULL;
+    char* dir = malloc(strlen(home) + strlen(sub) + 1);
+    strcpy(dir, home);
+    strcat(dir, sub);
+    return dir;
+}
+
+unsigned long long int hashASTSource (const char* full_code, const char* version) {
+    unsigned long long int hash = AST_CACHE_HASH_OFFSET;
+    hash = hashASTCacheBytes(hash, version, strlen(version));
+    hash = hashASTCacheBytes(hash, "\n", 1);
+    hash = hashASTCacheBytes(hash, full_code, strlen(full_code));
+    // different layouts of the structs can't share cache files
+    hash ^= AST_CACHE_FORMAT * 31 + sizeof(Token) * 7 + sizeof(int);
+    hash *= AST_CACHE_HASH_PRIME;
+    return hash;
+}
+
+unsigned long long int hashASTPath (const char* filename) {
+    #ifdef _WIN32
+    char* full_path = _fullpath(NULL, filename, 0);
+    #else
+    char* full_path = realpath(filename, NULL);
+    #endif
+    unsigned long long int hash = hashASTCacheBytes(AST_CACHE_HASH_OFFSET, full_path != NULL ? full_path : filename, strlen(full_path != NULL ? full_path : filename));
+    free(full_path);
+    return hash;
+}
+
+unsigned long long int hashASTCacheBytes (unsigned long long int hash, const void* bytes, size_t size) {
+    const unsigned char* data = (const unsigned char*)bytes;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= AST_CACHE_HASH_PRIME;
+    }
+    return hash;
+}
+
+void evictASTCache (const char* cache_dir, unsigned long long int path_hash, const char* keep) {
+    char prefix[24];
+    sprintf(prefix, "%016llx-", path_hash);
+    size_t prefix_length = strlen(prefix);
+    size_t extension_length = strlen(AST_CACHE_EXTENSION);
+    char* path = malloc(strlen(cache_dir) + strlen(keep) + 2);
+
+    // the other files of the script have the same length, so the path fits them too
+    #ifdef _WIN32
+    char* pattern = malloc(strlen(cache_dir) + prefix_length + extension_length + 3);
+    sprintf(pattern, "%s/%s*%s", cache_dir, prefix, AST_CACHE_EXTENSION);
+    struct _finddata_t entry;
+    intptr_t search = _findfirst(pattern, &entry);
+    free(pattern);
+    if (search != -1) {
+        do {
+            const char* name = entry.name;
+    #else
+    DIR* dir = opendir(cache_dir);
+    if (dir != NULL) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            const char* name = entry->d_name;
+    #endif
+            size_t length = strlen(name);
+            if (length != strlen(keep) || strncmp(name, prefix, prefix_length) || strcmp(name + length - extension_length, AST_CACHE_EXTENSION) || !strcmp(name, keep)) continue;
+            sprintf(path, "%s/%s", cache_dir, name);
+            remove(path); // another run may have removed it already
+    #ifdef _WIN32
+        } while (_findnext(search, &entry) == 0);
+        _findclose(search);
+    }
+    #else
+        }
+        closedir(dir);
+    }
+    #endif
+    free(path);
+}
+
+int readASTCache (AST* ast, const char* path, unsigned long long int hash) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return 1;
+    fseek(file, 0, SEEK_END);
+    long int size = ftell(file);
+    if (size < (long int)sizeof(ASTCacheHeader)) {
+        fclose(file);
+        return 1;
+    }
+
+    #ifdef _WIN32
+    char* image = malloc(size);
+    fseek(file, 0, SEEK_SET);
+    int read_fail = fread(image, 1, size, file) != size;
+    fclose(file);
+    if (read_fail) {
+        free(image);
+        return 1;
+    }
+    #else
+    char* image = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    fclose(file); // the mapping stays valid after the file is closed
+    if (image == MAP_FAILED) return 1;
+    #endif
+
+    int result = 1;
+    ASTCacheHeader header;
+    memcpy(&header, image, sizeof(ASTCacheHeader));
+    long long int expected_size = sizeof(ASTCacheHeader) + sizeof(Token) * ((long long int)header.token_count + 1) + sizeof(ASTCacheNode) * (long long int)header.node_count;
+    if (!memcmp(header.magic, AST_CACHE_MAGIC, 4) && header.format == AST_CACHE_FORMAT && header.hash == hash
+        && header.code_length == (int)strlen(ast->full_code) && header.token_count >= 0 && header.node_count > 0 && expected_size == size
+        && hashASTCacheBytes(AST_CACHE_HASH_OFFSET, image + sizeof(ASTCacheHeader), size - sizeof(ASTCacheHeader)) == header.checksum
+        && !checkCachedTokens((const Token*)(image + sizeof(ASTCacheHeader)), header.token_count, header.code_length)) {
+
+        ast->token_count = header.token_count;
+        ast->tokens = malloc(sizeof(Token) * (header.token_count + 1));
+        memcpy(ast->tokens, image + sizeof(ASTCacheHeader), sizeof(Token) * (header.token_count + 1));
+
+        const ASTCacheNode* nodes = (const ASTCacheNode*)(image + sizeof(ASTCacheHeader) + sizeof(Token) * (header.token_count + 1));
+        int index = 0;
+        result = readCachedNode(ast, nodes, &index, header.node_count, &ast->root) || index != header.node_count;
+        if (result) {
+            destroyNode(&ast->root);
+            free(ast->tokens);
+        }
+    }
+
+    #ifdef _WIN32
+    free(image);
+    #else
+    munmap(image, size);
+    #endif
+    return result;
+}
+
+int readCachedNode (const AST* ast, const ASTCacheNode* nodes, int* index, const int count, Node* node) {
+    *node = createNullTerminatedNode();
+    if (*index >= count) return 1;
+    ASTCacheNode stored = nodes[(*index)++];
+    if (stored.type < NODE_NULL || stored.type > NODE_PFOR || stored.body_length < 0 || stored.body_length >= count) return 1;
+    if (stored.start < 0 || stored.end >= ast->token_count || stored.start > stored.end + 1) return 1; // an empty node ends right before it starts
+
+    *node = createNode(ast->full_code, ast->tokens, stored.start, stored.end, stored.type);
+    if (stored.body_length == 0) return 0;
+
+    node->body = malloc(sizeof(Node) * (stored.body_length + 1));
+    for (int i = 0; i <= stored.body_length; i++) {
+        node->body[i] = createNullTerminatedNode();
+    }
+    for (int i = 0; i < stored.body_length; i++) {
+        if (readCachedNode(ast, nodes, index, count, &node->body[i])) return 1;
+    }
+    return 0;
+}
+
+int checkCachedTokens (const Token* tokens, int token_count, int code_length) {
+    if (tokens[token_count].type != TOKEN_END) return 1;
+    for (int i = 0; i < token_count; i++) {
+        const Token* token = &tokens[i];
+        if (token->type < 0 || token->type > TOKEN_SEPARATOR) return 1;
+        if (token->start < 0 || token->end >= code_length || token->start > token->end + 1) return 1;
+        if (token->block < 0 || token->block >= token_count || tokens[token->block].block != i) return 1;
+    }
+    return 0;
+}
+
+int countNodes (const Node* node) {
+    int count = 1;
+    int length = getNodeBodyLength(node->body);
+    for (int i = 0; i < length; i++) {
+        count += countNodes(&node->body[i]);
+    }
+    return count;
+}
+
+void writeCachedNode (FILE* file, const Node* node, unsigned long long int* checksum) {
+    ASTCacheNode stored = { node->start, node->end, node->type, getNodeBodyLength(node->body) };
+    fwrite(&stored, sizeof(ASTCacheNode), 1, file);
+    *checksum = hashASTCacheBytes(*checksum, &stored, sizeof(ASTCacheNode));
+    for (int i = 0; i < stored.body_length; i++) {
+        writeCachedNode(file, &node->body[i], checksum);
+    }
+}
+
+int writeASTCache (const AST* ast, const char* path, unsigned long long int hash) {
+    // create the cache directory and its parents
+    char* dir = malloc(strlen(path) + 1);
+    strcpy(dir, path);
+    for (char* c = dir + 1; *c != '\0'; c++) {
+        if (*c != '/') continue;
+        *c = '\0';
+        #ifdef _WIN32
+        _mkdir(dir);
+        #else
+        mkdir(dir, 0755);
+        #endif
+        *c = '/';
+    }
+    free(dir);
+
+    // write to a temporary file first, so other runs never read a half written cache (the AST tells threads apart)
+    char* temp_path = malloc(strlen(path) + 64);
+    #ifdef _WIN32
+    sprintf(temp_path, "%s.%d.%p.tmp", path, _getpid(), (void*)ast);
+    #else
+    sprintf(temp_path, "%s.%d.%p.tmp", path, (int)getpid(), (void*)ast);
+    #endif
+    FILE* file = fopen(temp_path, "wb");
+    if (file == NULL) {
+        free(temp_path);
+        return 1;
+    }
+
+    ASTCacheHeader header;
+    memcpy(header.magic, AST_CACHE_MAGIC, 4);
+    header.format = AST_CACHE_FORMAT;
+    header.hash = hash;
+    header.code_length = strlen(ast->full_code);
+    header.token_count = ast->token_count;
+    header.node_count = countNodes(&ast->root);
+    header.checksum = 0;
+    fwrite(&header, sizeof(ASTCacheHeader), 1, file);
+    fwrite(ast->tokens, sizeof(Token), ast->token_count + 1, file);
+    header.checksum = hashASTCacheBytes(AST_CACHE_HASH_OFFSET, ast->tokens, sizeof(Token) * (ast->token_count + 1));
+    writeCachedNode(file, &ast->root, &header.checksum);
+
+    // the header is written again once the checksum is known
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(ASTCacheHeader), 1, file);
+
+    int failed = ferror(file);
+    failed = fclose(file) || failed;
+    #ifdef _WIN32
+    remove(path); // rename doesn't replace existing files on windows
+    #endif
+    if (failed || rename(temp_path, path)) {
+        remove(temp_path);
+        free(temp_path);
+        return 1;
+    }
+    free(temp_path);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,263 @@
+/**
+ * @author Sebastiaan Heins
+ * @file bitarray.h
+ * @brief Stores the BOOL arrays kept in variables as packed bits, one bit per element instead of a whole variable
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef BITARRAY_H
+#define BITARRAY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "token.h"
+
+#define BITS_PER_WORD 64
+
+/**
+ * @brief The value of a packed BOOL array, it starts like a variable so getVariablesLength can tell it apart from a list of variables
+*/
+typedef struct {
+    char* name; // always NULL
+    Type type; // always TYPE_BITS
+    int length;
+    unsigned long long int words[]; // the bits past the length are always 0, so whole words can be counted
+} BitArray;
+
+/**
+ * @brief Create a packed array with all bits set to FALSE
+ * @param length The amount of bits
+ * @return The packed array (free it with freeValue)
+*/
+BitArray* createBitArray (int length);
+
+/**
+ * @brief Get whether or not the value of a variable is a packed array
+ * @param variable The variable to check
+ * @return Whether or not the variable is packed
+*/
+int isBitArray (const Variable* variable);
+
+/**
+ * @brief Get the amount of words needed to store a number of bits
+ * @param length The amount of bits
+ * @return The amount of words
+*/
+int getBitWordCount (int length);
+
+/**
+ * @brief Get the position of an index in a packed array, negative indices count from the end like they do for other arrays
+ * @param bits The packed array
+ * @param index The index
+ * @return The position, or -1 when it's out of bounds
+*/
+int getBitIndex (const BitArray* bits, long long int index);
+
+/**
+ * @brief Get a bit of a packed array
+ * @param bits The packed array
+ * @param index The position of the bit
+ * @return The bit
+*/
+int getBit (const BitArray* bits, int index);
+
+/**
+ * @brief Set a bit of a packed array
+ * @param bits The packed array
+ * @param index The position of the bit
+ * @param value The value of the bit
+*/
+void setBit (BitArray* bits, int index, int value);
+
+/**
+ * @brief Pack a BOOL array into bits
+ * @param variable The BOOL array to pack, it's left untouched when one of the elements isn't a BOOL
+*/
+void packBits (Variable* variable);
+
+/**
+ * @brief Turn a packed BOOL array back into a list of variables
+ * @param variable The packed array
+*/
+void unpackBits (Variable* variable);
+
+/**
+ * @brief Clone a packed array
+ * @param bits The packed array
+ * @return The clone (free it with freeValue)
+*/
+BitArray* cloneBitArray (const BitArray* bits);
+
+/**
+ * @brief Convert a packed array to a string, the same way an unpacked array is converted
+ * @param bits The packed array
+ * @return The string (must be freed after use)
+*/
+char* bitArrayToString (const BitArray* bits);
+
+/**
+ * @brief Count the bits of a word that are set
+ * @param word The word
+ * @return The amount of set bits
+*/
+int countWordBits (unsigned long long int word);
+
+/**
+ * @brief Count the set bits of a packed array
+ * @param bits The packed array
+ * @return The amount of TRUE elements
+*/
+long long int countBits (const BitArray* bits);
+
+/**
+ * @brief Combine two packed arrays of the same length a word at a time
+ * @param left The left packed array
+ * @param right The right packed array
+ * @param operator OPERATOR_AND, OPERATOR_OR or OPERATOR_XOR
+ * @return The combined array (free it with freeValue)
+*/
+BitArray* combineBitArrays (const BitArray* left, const BitArray* right, OperatorType operator);
+
+
+BitArray* createBitArray (int length) {
+    BitArray* bits = calloc(1, sizeof(BitArray) + sizeof(unsigned long long int) * getBitWordCount(length));
+    bits->name = NULL;
+    bits->type = (Type){TYPE_BITS, 0};
+    bits->length = length;
+    return bits;
+}
+
+int isBitArray (const Variable* variable) {
+    return variable->type.array == 1 && variable->value != NULL && ((BitArray*)variable->value)->type.dataType == TYPE_BITS;
+}
+
+int getBitWordCount (int length) {
+    return (length + BITS_PER_WORD - 1) / BITS_PER_WORD;
+}
+
+int getBitIndex (const BitArray* bits, long long int index) {
+    if (index >= 0) return index < bits->length ? index : -1;
+    if (-index >= bits->length) return -1;
+    return bits->length + index;
+}
+
+int getBit (const BitArray* bits, int index) {
+    return (bits->words[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1;
+}
+
+void setBit (BitArray* bits, int index, int value) {
+    unsigned long long int mask = 1ULL << (index % BITS_PER_WORD);
+    if (value) {
+        bits->words[index / BITS_PER_WORD] |= mask;
+    } else {
+        bits->words[index / BITS_PER_WORD] &= ~mask;
+    }
+}
+
+void packBits (Variable* variable) {
+    Variable* array = (Variable*)variable->value;
+    int length = getVariablesLength(array);
+    BitArray* bits = createBitArray(length);
+    for (int i = 0; i < length; i++) {
+        if (array[i].type.dataType != TYPE_BOOL || array[i].type.array || array[i].value == NULL) {
+            // not a plain BOOL array after all, leave it as it is
+            freeValue(bits);
+            return;
+        }
+        setBit(bits, i, *(int*)array[i].value != 0);
+    }
+    for (int i = 0; i < length; i++) {
+        destroyVariable(&array[i]);
+    }
+    freeValue(array);
+    variable->value = bits;
+}
+
+void unpackBits (Variable* variable) {
+    BitArray* bits = (BitArray*)variable->value;
+    Variable* array = malloc(sizeof(Variable) * (bits->length + 1));
+    for (int i = 0; i < bits->length; i++) {
+        int* value = allocValue(sizeof(int));
+        *value = getBit(bits, i);
+        array[i] = createLiteral(TYPE_BOOL, value, 0, 0);
+    }
+    array[bits->length] = createNullTerminatedVariable();
+    freeValue(bits);
+    variable->value = array;
+}
+
+BitArray* cloneBitArray (const BitArray* bits) {
+    size_t size = sizeof(BitArray) + sizeof(unsigned long long int) * getBitWordCount(bits->length);
+    BitArray* clone = malloc(size);
+    memcpy(clone, bits, size);
+    return clone;
+}
+
+char* bitArrayToString (const BitArray* bits) {
+    // every element is at most "FALSE, "
+    char* str = malloc(sizeof(char) * (bits->length * 7 + 3));
+    char* end = str;
+    *end++ = '[';
+    for (int i = 0; i < bits->length; i++) {
+        const char* value = getBit(bits, i) ? "TRUE" : "FALSE";
+        strcpy(end, value);
+        end += strlen(value);
+        if (i < bits->length - 1) {
+            strcpy(end, ", ");
+            end += 2;
+        }
+    }
+    strcpy(end, "]");
+    return str;
+}
+
+int countWordBits (unsigned long long int word) {
+    #ifdef __GNUC__
+    return __builtin_popcountll(word);
+    #else
+    int count = 0;
+    while (word) {
+        word &= word - 1; // clear the lowest set bit
+        count++;
+    }
+    return count;
+    #endif
+}
+
+long long int countBits (const BitArray* bits) {
+    long long int count = 0;
+    int words = getBitWordCount(bits->length);
+    for (int i = 0; i < words; i++) {
+        count += countWordBits(bits->words[i]);
+    }
+    return count;
+}
+
+BitArray* combineBitArrays (const BitArray* left, const BitArray* right, OperatorType operator) {
+    BitArray* result = createBitArray(left->length);
+    int words = getBitWordCount(left->length);
+    const unsigned long long int* a = left->words;
+    const unsigned long long int* b = right->words;
+    unsigned long long int* c = result->words;
+
+    // plain loops over the words, so the compiler can vectorize them
+    switch (operator) {
+        case OPERATOR_AND:
+            for (int i = 0; i < words; i++) c[i] = a[i] & b[i];
+            break;
+        case OPERATOR_OR:
+            for (int i = 0; i < words; i++) c[i] = a[i] | b[i];
+            break;
+        case OPERATOR_XOR:
+            for (int i = 0; i < words; i++) c[i] = a[i] ^ b[i];
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+#endif
@@ -32,6 +32,34 @@
 */
 int parseExpression (Variable* var, Process* process, Node* node);
 
+/**
+ * @brief Evaluate an expression, without looking at the value the optimizer hoisted out of a loop
+ * @param var The variable to set the return value to
+ * @param process The process to run
+ * @param node The node to evaluate
+ * @return The status
+*/
+int evaluateExpression (Variable* var, Process* process, Node* node);
+
+/**
+ * @brief Evaluate a call that was replaced with the expression the function returns, without entering the function
+ * @param var The variable to set the return value to
+ * @param process The process to run
+ * @param node The inline call
+ * @return The status
+ * @note The arguments are evaluated and cast like they are for a normal call, and the result is left in _ like RETURN does
+*/
+int parseInlineCall (Variable* var, Process* process, Node* node);
+
+/**
+ * @brief Check if an index the optimizer marked stays in bounds for the whole loop, the array is only measured the first time in every run of the loop
+ * @param process The process to run
+ * @param slot The bounds slot of the index
+ * @param container The array that is indexed
+ * @return Whether or not the element can be read without checking the index
+*/
+int checkLoopBounds (Process* process, int slot, Variable* container);
+
 /**
  * @brief Parse a refrence expression
  * @param process The process to run
@@ -40,6 +68,65 @@ int parseExpression (Variable* var, Process* process, Node* node);
 */
 int parseRefrenceExpression (Variable** var, Process* process, Node* node);
 
+/**
+ * @brief Move the element refrenced by parseRefrenceExpression out of the process, so evaluating other expressions can't overwrite it
+ * @param process The process to run
+ * @param ref The variable returned by parseRefrenceExpression
+ * @param element Filled with the refrence, it's target is NULL when the variable isn't an element of a packed array
+ * @return The variable to write to, commit the refrence with commitRefrence afterwards
+*/
+Variable* holdElementRefrence (Process* process, Variable* ref, ElementRefrence* element);
+
+/**
+ * @brief Get the depth of an index chain (a#i#j) that starts at a variable
+ * @param process The process to run
+ * @param node The node to check
+ * @return The amount of indices in the chain, 0 for a plain identifier, or -1 when the node isn't an index chain
+*/
+int getIndexChainDepth (Process* process, Node* node);
+
+/**
+ * @brief Parse an index chain (a#i#j) by refrence, only the final element is copied
+ * @param var The variable to set the return value to
+ * @param process The process to run
+ * @param node The node to parse
+ * @param depth The depth of the chain (from getIndexChainDepth)
+ * @return The status
+ * @note All indices are evaluated before the arrays are read, so an index can't free the array that's being walked
+*/
+int parseIndexChain (Variable* var, Process* process, Node* node, int depth);
+
+/**
+ * @brief Parse an index chain (a#i#j) as a refrence, matrices are only unpacked when a part of them is refrenced instead of an element
+ * @param var The variable to set the refrence to
+ * @param process The process to run
+ * @param node The node to parse
+ * @param depth The depth of the chain (from getIndexChainDepth)
+ * @return The status
+*/
+int parseRefrenceChain (Variable** var, Process* process, Node* node, int depth);
+
+/**
+ * @brief Evaluate the indices of an index chain
+ * @param process The process to run
+ * @param node The node of the chain
+ * @param depth The depth of the chain (from getIndexChainDepth)
+ * @param levels Filled with the node of every level, innermost first (must be freed after use)
+ * @param indices Filled with the indices (must be destroyed and freed after use)
+ * @param evaluated Filled with the amount of evaluated indices
+ * @param identifier Filled with the identifier the chain starts at
+ * @return The status
+*/
+int evaluateIndexChain (Process* process, Node* node, int depth, Node*** levels, Variable** indices, int* evaluated, Node** identifier);
+
+/**
+ * @brief Get the variable an index chain starts at
+ * @param process The process to run
+ * @param identifier The identifier the chain starts at, or an argument of an inlined call
+ * @return The variable, or NULL when it doesn't exist
+*/
+Variable* getChainRoot (Process* process, Node* identifier);
+
 /**
  * @brief Parse a literal
  * @param var The variable to set the return value to (make sure to free it, the old value is destroyed)
@@ -49,6 +136,14 @@ int parseRefrenceExpression (Variable** var, Process* process, Node* node);
 */
 int parseLiteral (Variable* var, Process* process, Node* literal);
 
+/**
+ * @brief Parse the source text of a literal, without a process (used by the optimizer as well)
+ * @param var The variable to set the value to (the old value is destroyed)
+ * @param text The source text of the literal
+ * @return The error code
+*/
+int parseLiteralText (Variable* var, const char* text);
+
 /**
  * @brief Set the value of a variable
  * @param left The variable to set the value of
@@ -71,9 +166,35 @@ int parseArrayExpression (Variable* var, Process* process, Node* node);
 
 
 int parseExpression (Variable* var, Process* process, Node* node) {
-    if (!strcmp(node->text, "-invalid")) return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->start));
-    Variable* left;
-    Variable* right;
+    // nodes folded by the optimizer are copied straight from the constant pool
+    if (node->constant != -1) {
+        destroyVariable(var);
+        *var = cloneVariable(&process->code[process->running_ast].constants[node->constant]);
+        return 0;
+    }
+    // the workers of a PFOR share the slots, so they evaluate the expression every time
+    if (node->invariant == -1 || process->worker) return evaluateExpression(var, process, node);
+
+    // values hoisted out of a loop are evaluated the first time they're needed in every run of the loop
+    InvariantSlot* slot = &process->code[process->running_ast].invariants[node->invariant];
+    if (slot->valid) {
+        destroyVariable(var);
+        *var = cloneVariable(&slot->value);
+        if (node->type == NODE_FUNCTION_IDENTIFIER) setReturnValue(process, &slot->value); // the call still leaves it's result in _
+        return 0;
+    }
+    int code = evaluateExpression(var, process, node);
+    if (code) return code;
+    slot = &process->code[process->running_ast].invariants[node->invariant];
+    slot->value = cloneVariable(var);
+    slot->value.literal = 0; // the value is owned by the slot
+    slot->valid = 1;
+    return 0;
+}
+
+int evaluateExpression (Variable* var, Process* process, Node* node) {
+    Variable left;
+    Variable right;
     OperatorType operator;
     int oRes = 0;
     switch (node->type)
@@ -98,179 +219,114 @@ int parseExpression (Variable* var, Process* process, Node* node) {
             || node->body[0].type == NODE_UNARY_EXPRESSION 
             || node->body[0].type == NODE_ARRAY_EXPRESSION 
             || node->body[0].type == NODE_BLOCK_EXPRESSION 
-            || node->body[0].type == NODE_FUNCTION_IDENTIFIER)) {
+            || node->body[0].type == NODE_FUNCTION_IDENTIFIER
+            || node->body[0].type == NODE_INLINE_CALL
+            || node->body[0].type == NODE_INLINE_ARGUMENT)) {
                 int oRes = parseExpression(var, process, &node->body[0]);
                 if (oRes) return oRes;
                 return 0;
             }
 
-            left = malloc(sizeof(Variable));
-            right = malloc(sizeof(Variable));
-            *left = createNullTerminatedVariable();
-            *right = createNullTerminatedVariable();
-            int left_parse = parseExpression(left,  process, &node->body[0]);
-            if (left_parse) return left_parse;
-            if (left->type.dataType == D_NULL) {
+            // indexing a variable walks the arrays in place instead of copying every level
+            if (node->body[1].type == NODE_OPERATOR && process->code[process->running_ast].tokens[node->body[1].start].carry == OPERATOR_HASH) {
+                int depth = getIndexChainDepth(process, node);
+                if (depth > 0) return parseIndexChain(var, process, node, depth);
+            }
+
+            left = createNullTerminatedVariable();
+            right = createNullTerminatedVariable();
+            int left_parse = parseExpression(&left, process, &node->body[0]);
+            if (left_parse) {
+                destroyLiteral(&left);
+                return left_parse;
+            }
+            if (left.type.dataType == D_NULL) {
+                destroyLiteral(&left);
                 return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->body[0].start));
             }
-            int right_parse = parseExpression(right, process, &node->body[2]);
-            if (right_parse) return right_parse;
-            if (right->type.dataType == D_NULL) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->body[2].start));
+            operator = process->code[process->running_ast].tokens[node->body[1].start].carry;
+
+            // && and || only evaluate the right side when the left side doesn't decide the result
+            if ((operator == OPERATOR_AND_AND || operator == OPERATOR_OR_OR) && !process->eager_logic) {
+                int truth = getTruthValue(&left);
+                destroyLiteral(&left);
+                if (truth == (operator == OPERATOR_OR_OR)) {
+                    int* value = allocValue(sizeof(int));
+                    *value = truth;
+                    destroyVariable(var);
+                    *var = createLiteral(TYPE_BOOL, value, 1, 0);
+                    return 0;
+                }
+                int right_parse = parseExpression(&right, process, &node->body[2]);
+                if (right_parse) {
+                    destroyLiteral(&right);
+                    return right_parse;
+                }
+                if (right.type.dataType == D_NULL) {
+                    destroyLiteral(&right);
+                    return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->body[2].start));
+                }
+                int* value = allocValue(sizeof(int));
+                *value = getTruthValue(&right);
+                destroyLiteral(&right);
+                destroyVariable(var);
+                *var = createLiteral(TYPE_BOOL, value, 1, 0);
+                return 0;
             }
-            operator = process->code->tokens[node->body[1].start].carry;
 
-            if (left->type.dataType == D_NULL || right->type.dataType == D_NULL) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->start));
-            }
-            switch (operator) {
-                default:
-                    return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_OPERATOR, getTokenStart(process, node->start));
-
-                // arithmetic operators
-                case OPERATOR_ADD:
-                    oRes = add(var, left, right);
-                    break;
-                case OPERATOR_SUBTRACT:
-                    oRes = subtract(var, left, right);
-                    break;
-                case OPERATOR_MULTIPLY:
-                    oRes = multiply(var, left, right);
-                    break;
-                case OPERATOR_POWER:
-                    oRes = pow_op(var, left, right);
-                    break;
-                case OPERATOR_DIVIDE:
-                    oRes = divide(var, left, right);
-                    break;
-                case OPERATOR_ROOT:
-                    oRes = root(var, left, right);
-                    break;
-                case OPERATOR_MODULO:
-                    oRes = modulo(var, left, right);
-                    break;
-                case OPERATOR_XOR:
-                    oRes = xor(var, left, right);
-                    break;
-                case OPERATOR_AND:
-                    oRes = and(var, left, right);
-                    break;
-                case OPERATOR_OR:
-                    oRes = or(var, left, right);
-                    break;
-                case OPERATOR_SHIFT_LEFT:
-                    oRes = bitshift_left(var, left, right);
-                    break;
-                case OPERATOR_SHIFT_RIGHT:
-                    oRes = bitshift_right(var, left, right);
-                    break;
-
-                // logical operators
-                case OPERATOR_OR_OR:
-                    oRes = logic_or(var, left, right);
-                    break;
-                case OPERATOR_AND_AND:
-                    oRes = logic_and(var, left, right);
-                    break;
-                
-                // comparison operators
-                case OPERATOR_EQUAL:
-                    oRes = equal(var, left, right);
-                    break;
-                case OPERATOR_NOT_EQUAL:
-                    oRes = not_equal(var, left, right);
-                    break;
-                case OPERATOR_LESS:
-                    oRes = less_than(var, left, right);
-                    break;
-                case OPERATOR_GREATER:
-                    oRes = greater_than(var, left, right);
-                    break;
-                case OPERATOR_LESS_EQUAL:
-                    oRes = less_than_or_equal(var, left, right);
-                    break;
-                case OPERATOR_GREATER_EQUAL:
-                    oRes = greater_than_or_equal(var, left, right);
-                    break;
-
-                // special operators
-                case OPERATOR_HASH:
-                    oRes = hash(var, left, right);
-                    break;
-                case OPERATOR_MAX:
-                    oRes = max_op(var, left, right);
-                    break;
-                case OPERATOR_MIN:
-                    oRes = min_op(var, left, right);
-                    break;
+            int right_parse = parseExpression(&right, process, &node->body[2]);
+            if (right_parse) {
+                destroyLiteral(&left);
+                destroyLiteral(&right);
+                return right_parse;
             }
-            if (oRes) return error(process, getLastScope(&process->main_scope)->running_ast, oRes, getTokenStart(process, node->start));
-            
-            if (!strcmp(left->name, "-lit")) {
-                destroyVariable(left);
-                free (left);
+            if (right.type.dataType == D_NULL) {
+                destroyLiteral(&left);
+                destroyLiteral(&right);
+                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->body[2].start));
             }
-            
-            if (!strcmp(right->name, "-lit")) {
-                destroyVariable(right);
-                free (right);
+            if (node->body[1].kernel != -1) {
+                oRes = cachedBinaryOperation(var, &left, &right, operator, node->body[1].kernel);
+            } else {
+                oRes = binaryOperation(var, &left, &right, operator);
             }
+
+            destroyLiteral(&left);
+            destroyLiteral(&right);
+            if (oRes) return error(process, getLastScope(&process->main_scope)->running_ast, oRes, getTokenStart(process, node->start));
             break;
         case NODE_UNARY_EXPRESSION:
-            right = malloc(sizeof(Variable));
-            *right = createNullTerminatedVariable();
+            right = createNullTerminatedVariable();
 
-            if (node->body[0].type == NODE_OPERATOR) {
-                int rRes = parseExpression(right, process, &node->body[1]);
-                if (rRes) return rRes;
-                if (right->type.dataType == D_NULL) {
-                    return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->start));
-                }
+            int rRes = parseExpression(&right, process, &node->body[1]);
+            if (rRes) {
+                destroyLiteral(&right);
+                return rRes;
+            }
+            if (right.type.dataType == D_NULL) {
+                destroyLiteral(&right);
+                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->start));
+            }
 
-                operator = process->code->tokens[node->body[0].start].carry;
-                switch (operator) {
-                    default:
-                        return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_OPERATOR_NOT_UNARY, getTokenStart(process, node->start));
-                        break;
-                    case OPERATOR_NOT:
-                        oRes = not(var, right);
-                        break;
-                    case OPERATOR_NOT_BITWISE:
-                        oRes = not_bitwise(var, right);
-                        break;
-                    case OPERATOR_SUBTRACT:
-                        oRes = negative(var, right);
-                        break;
-                    case OPERATOR_ROOT:
-                        oRes = sqroot(var, right);
-                        break;
-                    case OPERATOR_ABSOLUTE:
-                        oRes = absolute(var, right);
-                        break;
-                }
-                if (oRes) return error(process, getLastScope(&process->main_scope)->running_ast, oRes, getTokenStart(process, node->start));
+            if (node->body[0].type == NODE_OPERATOR) {
+                operator = process->code[process->running_ast].tokens[node->body[0].start].carry;
+                oRes = unaryOperation(var, &right, operator);
             }
             else if (node->body[0].type == NODE_OPERATOR_CAST) {
-                // this is never a reference, since it is a cast
-                int rRes = parseExpression(right, process, &node->body[1]);
-                if (rRes) return rRes;
-                if (right->type.dataType == D_NULL) {
-                    return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->start));
-                }
-
+                // the operand is a literal, so it can be cast in place and handed over to var
                 Type castType = (Type){.dataType = D_NULL, .array = 0};
-                int tRes = getTypeFromCastNode(process, &castType, &node->body[0]);
-                if (tRes) return error(process, getLastScope(&process->main_scope)->running_ast, tRes, getTokenStart(process, node->start));
-                oRes = castValue(right, castType);
-                if (oRes) return error(process, getLastScope(&process->main_scope)->running_ast, oRes, getTokenStart(process, node->start));
-                destroyVariable(var);
-                *var = cloneVariable(right);
+                oRes = getTypeFromCastNode(process, &castType, &node->body[0]);
+                if (!oRes) oRes = castValue(&right, castType);
+                if (!oRes) {
+                    destroyVariable(var);
+                    *var = right;
+                    var->literal = 1;
+                    right = createNullTerminatedVariable();
+                }
             }
             
-            if (!strcmp(right->name, "-lit")) {
-                destroyVariable(right);
-                free (right);
-            }
+            destroyLiteral(&right);
+            if (oRes) return error(process, getLastScope(&process->main_scope)->running_ast, oRes, getTokenStart(process, node->start));
             break;
         
         case NODE_ARRAY_EXPRESSION:
@@ -284,20 +340,57 @@ int parseExpression (Variable* var, Process* process, Node* node) {
             // change var to the return value
             destroyVariable(var);
             *var = cloneVariable(getReturnValue(process));
-            free (var->name);
-            var->name = malloc(sizeof(char) * 5);
-            strcpy(var->name, "-lit");
             if (oRes) return oRes;
             break;
+
+        case NODE_INLINE_CALL:
+            return parseInlineCall(var, process, node);
+        case NODE_INLINE_ARGUMENT:
+            destroyVariable(var);
+            *var = cloneVariable(&process->inline_arguments[node->argument]);
+            break;
     }
     return 0; // success
 }
+
+int parseInlineCall (Variable* var, Process* process, Node* node) {
+    Node* func_node = node->body[0].body;
+    int args_length = getNodeBodyLength(func_node[1].body);
+    Variable* args = malloc(sizeof(Variable) * (args_length + 1));
+    int code = 0;
+    int evaluated = 0;
+    for (; evaluated < args_length && !code; evaluated++) {
+        args[evaluated] = createNullTerminatedVariable();
+        code = parseExpression(&args[evaluated], process, &func_node[1].body[evaluated]);
+    }
+
+    // the arguments are cast once they're all evaluated, like callFunction does
+    for (int i = 0; i < args_length && !code; i++) {
+        Type type = (Type){.dataType = D_NULL, .array = 0};
+        int cRes = getTypeFromCastNode(process, &type, &node->body[i + 2]);
+        if (!cRes && !compareType(type, args[i].type)) cRes = castValue(&args[i], type);
+        if (cRes) code = error(process, getLastScope(&process->main_scope)->running_ast, cRes, getTokenStart(process, func_node[0].start));
+    }
+
+    if (!code) {
+        Variable* outer_arguments = process->inline_arguments;
+        process->inline_arguments = args;
+        code = parseExpression(var, process, &node->body[1]);
+        process->inline_arguments = outer_arguments;
+        if (!code) setReturnValue(process, var);
+    }
+
+    for (int i = 0; i < evaluated; i++) {
+        destroyVariable(&args[i]);
+    }
+    free(args);
+    return code;
+}
     
 int parseRefrenceExpression (Variable** var, Process* process, Node* node) {
     if (var == NULL) return 0;
-    if (!strcmp(node->text, "-invalid")) return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, node->start));
     Variable* left;
-    Variable* right;
+    Variable right;
     OperatorType operator;
     int oRes = 0;
     switch (node->type)
@@ -315,41 +408,213 @@ int parseRefrenceExpression (Variable** var, Process* process, Node* node) {
                 if (oRes) return oRes;
                 return 0;
             }
-            right = malloc(sizeof(Variable));
-            *right = createNullTerminatedVariable();
+            int depth = getIndexChainDepth(process, node);
+            if (depth > 0) return parseRefrenceChain(var, process, node, depth);
+
+            right = createNullTerminatedVariable();
             int left_parse = parseRefrenceExpression(&left, process, &node->body[0]);
             if (left_parse) return left_parse;
-            int right_parse = parseExpression(right, process, &node->body[2]);
-            if (right_parse) return right_parse;
-            operator = process->code->tokens[node->body[1].start].carry;
-
-            if (left->type.dataType == D_NULL || right->type.dataType == D_NULL) return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_REFRENCE_EXPRESSION, getTokenStart(process, node->start));
-            switch (operator) {
-                default:
-                    return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_REFRENCE_EXPRESSION, getTokenStart(process, node->start));
-                case OPERATOR_HASH:
-                    oRes = hash_refrence(var, left, right);
-                    if (oRes) return error(process, getLastScope(&process->main_scope)->running_ast, oRes, getTokenStart(process, node->start));
-                    break;
+            int right_parse = parseExpression(&right, process, &node->body[2]);
+            if (right_parse) {
+                destroyLiteral(&right);
+                return right_parse;
             }
-            
-            if (!strcmp(right->name, "-lit")) {
-                destroyVariable(right);
-                free (right);
+            operator = process->code[process->running_ast].tokens[node->body[1].start].carry;
+
+            if (left->type.dataType == D_NULL || right.type.dataType == D_NULL) {
+                oRes = ERROR_INVALID_REFRENCE_EXPRESSION;
+            } else if (operator == OPERATOR_HASH) {
+                oRes = hash_refrence(var, left, &right);
+            } else {
+                oRes = ERROR_INVALID_REFRENCE_EXPRESSION;
             }
+            
+            destroyLiteral(&right);
+            if (oRes) return error(process, getLastScope(&process->main_scope)->running_ast, oRes, getTokenStart(process, node->start));
             break;
     }
     return 0; // success
 }
 
 
+Variable* holdElementRefrence (Process* process, Variable* ref, ElementRefrence* element) {
+    *element = (ElementRefrence){ NULL, 0, createNullTerminatedVariable() };
+    if (ref != &process->element_refrence.value) return ref;
+    *element = process->element_refrence;
+    process->element_refrence = (ElementRefrence){ NULL, 0, createNullTerminatedVariable() };
+    return &element->value;
+}
+
+int getIndexChainDepth (Process* process, Node* node) {
+    if (node->constant != -1) return -1;
+    if (node->type == NODE_IDENTIFIER || node->type == NODE_INLINE_ARGUMENT) return 0;
+    if (node->type != NODE_EXPRESSION) return -1;
+
+    int length = getNodeBodyLength(node->body);
+    if (length == 1) return getIndexChainDepth(process, &node->body[0]);
+    if (length != 3 || node->body[1].type != NODE_OPERATOR || process->code[process->running_ast].tokens[node->body[1].start].carry != OPERATOR_HASH) return -1;
+
+    int depth = getIndexChainDepth(process, &node->body[0]);
+    return depth == -1 ? -1 : depth + 1;
+}
+
+int parseIndexChain (Variable* var, Process* process, Node* node, int depth) {
+    Node** levels;
+    Variable* indices;
+    int evaluated;
+    Node* identifier;
+    int oRes = evaluateIndexChain(process, node, depth, &levels, &indices, &evaluated, &identifier);
+
+    if (!oRes) {
+        Variable* container = getChainRoot(process, identifier);
+        if (container == NULL) {
+            oRes = error(process, getLastScope(&process->main_scope)->running_ast, ERROR_UNDEFINED_VARIABLE, getTokenStart(process, identifier->start));
+        }
+        for (int i = 0; i < depth && !oRes; i++) {
+            int hRes;
+            if (levels[i]->bounds != -1 && checkLoopBounds(process, levels[i]->bounds, container)) {
+                // the optimizer proved the index in bounds for the whole loop
+                Variable* element = &((Variable*)container->value)[getSignedNumber(&indices[i])];
+                if (i < depth - 1) {
+                    container = element;
+                } else {
+                    destroyVariable(var);
+                    *var = cloneVariable(element);
+                }
+                continue;
+            }
+            if (isMatrix(container)) {
+                // a matrix takes the rest of the indices at once
+                hRes = indexMatrix(var, container, &indices[i], depth - i);
+                if (hRes) oRes = error(process, getLastScope(&process->main_scope)->running_ast, hRes, getTokenStart(process, levels[depth - 1]->start));
+                break;
+            }
+            hRes = i < depth - 1 ? hash_refrence(&container, container, &indices[i]) : hash(var, container, &indices[i]);
+            if (hRes) oRes = error(process, getLastScope(&process->main_scope)->running_ast, hRes, getTokenStart(process, levels[i]->start));
+        }
+    }
+
+    for (int i = 0; i < evaluated; i++) {
+        destroyLiteral(&indices[i]);
+    }
+    free(indices);
+    free(levels);
+    return oRes;
+}
+
+int parseRefrenceChain (Variable** var, Process* process, Node* node, int depth) {
+    Node** levels;
+    Variable* indices;
+    int evaluated;
+    Node* identifier;
+    int oRes = evaluateIndexChain(process, node, depth, &levels, &indices, &evaluated, &identifier);
+
+    if (!oRes) {
+        Variable* container = getChainRoot(process, identifier);
+        if (container == NULL) {
+            oRes = error(process, identifier->start, ERROR_UNDEFINED_VARIABLE, getTokenStart(process, identifier->start));
+        }
+        for (int i = 0; i < depth && !oRes; i++) {
+            int hRes = 0;
+            int remaining = depth - i;
+            if (isMatrix(container) && remaining == ((Matrix*)container->value)->dimensions) {
+                // an element isn't a variable, the process holds it's value until it's written back
+                long long int offset;
+                hRes = getMatrixOffset((Matrix*)container->value, &indices[i], remaining, &offset);
+                if (!hRes) {
+                    refrenceMatrixElement(&process->element_refrence, (Matrix*)container->value, offset, container->constant);
+                    container = &process->element_refrence.value;
+                }
+                if (hRes) oRes = error(process, getLastScope(&process->main_scope)->running_ast, hRes, getTokenStart(process, levels[depth - 1]->start));
+                break;
+            }
+            if (isMatrix(container) && remaining > ((Matrix*)container->value)->dimensions) {
+                hRes = ERROR_TYPE_MISMATCH;
+            } else if (remaining == 1 && isBitArray(container)) {
+                int index = getBitIndex((BitArray*)container->value, getSignedNumber(&indices[i]));
+                if (index == -1) {
+                    hRes = ERROR_ARRAY_OUT_OF_BOUNDS;
+                } else {
+                    refrenceBit(&process->element_refrence, (BitArray*)container->value, index, container->constant);
+                    container = &process->element_refrence.value;
+                }
+            } else {
+                // a part of a matrix is refrenced as a variable, so the matrix falls back to a list of it's rows
+                unpackArray(container);
+                hRes = hash_refrence(&container, container, &indices[i]);
+            }
+            if (hRes) oRes = error(process, getLastScope(&process->main_scope)->running_ast, hRes, getTokenStart(process, levels[i]->start));
+        }
+        if (!oRes) *var = container;
+    }
+
+    for (int i = 0; i < evaluated; i++) {
+        destroyLiteral(&indices[i]);
+    }
+    free(indices);
+    free(levels);
+    return oRes;
+}
+
+int evaluateIndexChain (Process* process, Node* node, int depth, Node*** levels, Variable** indices, int* evaluated, Node** identifier) {
+    // collect the levels of the chain, innermost first
+    *levels = malloc(sizeof(Node*) * depth);
+    Node* current = node;
+    for (int i = depth - 1; i >= 0; i--) {
+        while (getNodeBodyLength(current->body) == 1) current = &current->body[0];
+        (*levels)[i] = current;
+        current = &current->body[0];
+    }
+    while (current->type != NODE_IDENTIFIER && current->type != NODE_INLINE_ARGUMENT) current = &current->body[0];
+    *identifier = current;
+
+    *indices = malloc(sizeof(Variable) * depth);
+    for (*evaluated = 0; *evaluated < depth; (*evaluated)++) {
+        Variable* index = &(*indices)[*evaluated];
+        Node* index_node = &(*levels)[*evaluated]->body[2];
+        *index = createNullTerminatedVariable();
+        int oRes = parseExpression(index, process, index_node);
+        if (!oRes && index->type.dataType == D_NULL) {
+            oRes = error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, index_node->start));
+        }
+        if (oRes) {
+            (*evaluated)++;
+            return oRes;
+        }
+    }
+    return 0;
+}
+
+Variable* getChainRoot (Process* process, Node* identifier) {
+    if (identifier->type == NODE_INLINE_ARGUMENT) return &process->inline_arguments[identifier->argument];
+    return getVariable(&process->main_scope, identifier->text);
+}
+
+int checkLoopBounds (Process* process, int slot, Variable* container) {
+    if (!container->type.array || container->value == NULL || isPackedArray(container) || process->worker) return 0;
+    AST* ast = &process->code[process->running_ast];
+    InvariantSlot* check = &ast->invariants[slot];
+    if (!check->valid) {
+        // the loop doesn't write to the array, so it's length can't change while the loop runs
+        long long int bound = ast->invariants[check->loop].bound;
+        check->bound = bound >= 0 && getVariablesLength((Variable*)container->value) > bound;
+        check->valid = 1;
+    }
+    return check->bound;
+}
 
 int parseLiteral (Variable* var, Process* process, Node* literal) {
+    int code = parseLiteralText(var, literal->text);
+    if (code) return error(process, getLastScope(&process->main_scope)->running_ast, code, getTokenStart(process, literal->start));
+    return 0;
+}
+
+int parseLiteralText (Variable* var, const char* text) {
     DataType type = D_NULL;
     void* value = NULL;
-    if (strsur(literal->text, '"')) {
+    if (strsur(text, '"')) {
         type = TYPE_STRING;
-        char* str = removeLastAndFirstChar(literal->text, 1);
+        char* str = removeLastAndFirstChar(text, 1);
 
         // parse escape sequences
         strrep(str, "\\n", "\n");
@@ -364,13 +629,12 @@ int parseLiteral (Variable* var, Process* process, Node* literal) {
         strrep(str, "\\f", "\f");
         strrep(str, "\\v", "\v");
 
-        value = malloc(sizeof(char) * (strlen(str) + 1));
-        strcpy(value, str);
+        value = allocString(str);
         free(str);
         str = NULL;
-    } else if (strsur(literal->text, '\'')) {
+    } else if (strsur(text, '\'')) {
         type = TYPE_CHAR;
-        char* str = removeLastAndFirstChar(literal->text, 1);
+        char* str = removeLastAndFirstChar(text, 1);
         // parse escape sequences
         strrep(str, "\\n", "\n");
         strrep(str, "\\t", "\t");
@@ -386,52 +650,55 @@ int parseLiteral (Variable* var, Process* process, Node* literal) {
         // null terminated character is parsed differently
         if (strlen(str) == 2) {
             if (str[0] == '\\' && str[1] == '0') {
-                value = malloc(sizeof(char));
+                value = allocValue(sizeof(char));
                 *(char*)value = '\0';
                 free(str);
                 str = NULL;
             } else {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_CHAR, getTokenStart(process, literal->start));
+                free(str);
+                return ERROR_INVALID_CHAR;
             }
         } else {
             if (strlen(str) != 1) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_CHAR, getTokenStart(process, literal->start));
+                free(str);
+                return ERROR_INVALID_CHAR;
             }
-            value = malloc(sizeof(char));
+            value = allocValue(sizeof(char));
             *(char*)value = str[0];
             free(str);
             str = NULL;
         }
     } else {
-        int dot = strchl(literal->text, '.');
+        int dot = strchl(text, '.');
         if (dot == 1) {
-            char* num = malloc(sizeof(char) * (strlen(literal->text) + 1));
-            strcpy(num, literal->text);
-            if (literal->text[strlen(literal->text)-1] == 'F') {
+            char* num = malloc(sizeof(char) * (strlen(text) + 1));
+            strcpy(num, text);
+            if (text[strlen(text)-1] == 'F') {
                 num[strlen(num)-1] = '\0'; // remove the F
                 type = TYPE_FLOAT;
-                value = malloc(sizeof(float));
+                value = allocValue(sizeof(float));
                 *(float*)value = atof(num);
                 free(num);
             } else {
                 type = TYPE_DOUBLE;
-                value = malloc(sizeof(double));
-                *(double*)value = atof(num);    
+                value = allocValue(sizeof(double));
+                *(double*)value = atof(num);
+                free(num);
             }
         } else if (!dot) {
-            if (literal->text[strlen(literal->text)-1] == 'F') {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_NUMBER, getTokenStart(process, literal->start));
+            if (text[strlen(text)-1] == 'F') {
+                return ERROR_INVALID_NUMBER;
             }
             type = TYPE_ULONG;
-            value = malloc(sizeof(unsigned long long));
-            *(unsigned long long*)value = atoll(literal->text);
+            value = allocValue(sizeof(unsigned long long));
+            *(unsigned long long*)value = atoll(text);
         }
     }
     if (value == NULL || type == D_NULL) {
-        return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_LITERAL, getTokenStart(process, literal->start));
+        return ERROR_INVALID_LITERAL;
     }
     destroyVariable(var); // free the memory of the variable
-    *var = createVariable("-lit", type, value, 0, 0); // set the new value
+    *var = createLiteral(type, value, 0, 0); // set the new value
     return 0;
 }
 
@@ -445,21 +712,14 @@ int setVariableValue (Variable* left, Variable* right, OperatorType op) {
                 int castRes = castValue(right, left->type);
                 if (castRes) return ERROR_TYPE_MISMATCH;
             }
-            // destroy the old array and it's contents
-            int len = getVariablesLength(left->value);
-            for (int i = 0; i < len; i++) {
-                destroyVariable(&((Variable*)left->value)[i]);
-            }
-            free (left->value); // free the array
-
-            // copy the new array
-            left->value = malloc(sizeof(Variable) * (getVariablesLength(right->value) + 1));
-            for (int i = 0; i < getVariablesLength(right->value); i++) {
-                ((Variable*)left->value)[i] = cloneVariable(&((Variable*)right->value)[i]);
-            }
-            ((Variable*)left->value)[getVariablesLength(right->value)] = createNullTerminatedVariable();
+            // destroy the old array and it's contents, then copy the new array (packed arrays are copied as they are)
+            destroyValue(left);
+            left->value = cloneValue(right);
+            packArray(left);
             return 0; 
         } else {
+            unpackArray(left);
+            unpackArray(right);
             int len = getVariablesLength(left->value);
             Variable* newArray = NULL;
             if (op == OPERATOR_ADD_ASSIGN) {
@@ -499,8 +759,9 @@ int setVariableValue (Variable* left, Variable* right, OperatorType op) {
             for (int i = 0; i < len; i++) {
                 destroyVariable(&((Variable*)left->value)[i]);
             }
-            free(left->value);
+            freeValue(left->value);
             left->value = newArray;
+            packArray(left);
             return 0;
         }
         return ERROR_INVALID_OPERATOR;  
@@ -580,7 +841,7 @@ int parseArrayExpression (Variable* var, Process* process, Node* node) {
     }
     elements[elements_length] = createNullTerminatedVariable();
     destroyVariable(var);
-    *var = createVariable("-lit", arrayType.dataType, elements, 0, arrayType.array + 1);
+    *var = createLiteral(arrayType.dataType, elements, 0, arrayType.array + 1);
     return 0;
 }
 
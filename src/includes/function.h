@@ -11,6 +11,7 @@
 #include "strtools.h"
 #include "log.h"
 #include "variable.h"
+#include "memo.h"
 
 typedef struct Function Function;
 
@@ -31,6 +32,11 @@ struct Function {
     Type return_type;
     
     int std_function;
+    int ast_index; // the AST the body belongs to, functions can be declared in imported modules
+    Node* declaration; // the MAKE FUNC node, NULL for standard functions
+    Node* inline_body; // the expression calls to the function are replaced with, NULL when the function is too big or isn't parsed yet
+    MemoCache* memo; // the cached results of a MEMO function, NULL for other functions
+    int tail_call; // whether a RETURN of a call to the function itself may run in place of it, -1 until it's body is parsed
 };
 
 /**
@@ -90,6 +96,11 @@ Function createFunction (char* name, Node* body, Argument* arguments, int argume
     function.arguments = arguments;
     function.std_function = std;
     function.return_type = return_type;
+    function.ast_index = 0;
+    function.declaration = NULL;
+    function.inline_body = NULL;
+    function.memo = NULL;
+    function.tail_call = -1;
     return function;
 }
 
@@ -101,6 +112,11 @@ Function createNullTerminatedFunction () {
     function.arguments = NULL;
     function.std_function = 0;
     function.return_type = (Type) {D_NULL, 0};
+    function.ast_index = 0;
+    function.declaration = NULL;
+    function.inline_body = NULL;
+    function.memo = NULL;
+    function.tail_call = -1;
     return function;
 }
 
@@ -120,5 +136,10 @@ void destroyFunction (Function* function) {
         }
         free(function->arguments);
     }
+    if (function->inline_body != NULL) {
+        destroyNode(function->inline_body);
+        free(function->inline_body);
+    }
+    if (function->memo != NULL) destroyMemoCache(function->memo);
 }
 #endif
@@ -20,16 +20,34 @@
 */
 void cleanScope (Scope* scope);
 
+/**
+ * @brief Remove the scopes above a given length, for when an error leaves blocks and functions before they are finished
+ * @param scope The main scope
+ * @param length The amount of scopes to keep
+*/
+void unwindScopes (Scope* scope, int length);
+
+/**
+ * @brief Release a few empty slabs of an allocator when enough free slot memory has piled up, the others are released when later scopes end
+ * @param allocator The allocator of the process
+ * @note Only the slabs of the small values are released, larger values are given back to the system when they're freed
+*/
+void trimSlabs (Allocator* allocator);
+
 void cleanScope (Scope* scope) {
     if (scope->child != NULL) if (scope->child->body != NULL) {
         cleanScope(scope->child);
     }
     
+    destroyVariable(&scope->statement.loop_array); // a FOR that was left by an error
+    scope->statement = createStatement();
+
     int length = getVariablesLength(scope->variables);
     for (int i = 0; i < length; i++) {
         destroyVariable(&scope->variables[i]);
     }
     free (scope->variables);
+    free (scope->variable_index);
 
     length = getFunctionsLength(scope->functions);
     for (int i = 0; i < length; i++) {
@@ -40,4 +58,17 @@ void cleanScope (Scope* scope) {
     free (scope->child);
 }
 
+void unwindScopes (Scope* scope, int length) {
+    // the scopes after the kept ones are removed at once
+    for (int i = 1; i < length && scope->child->running_line != -1; i++) {
+        scope = scope->child;
+    }
+    removeChildScope(scope);
+}
+
+void trimSlabs (Allocator* allocator) {
+    if (allocator == NULL || allocator->free_bytes < allocator->trim_threshold) return;
+    trimAllocator(allocator, ALLOCATOR_TRIM_STEP); // a bounded amount of work, so the pause doesn't grow with the heap
+}
+
 #endif
\ No newline at end of file
@@ -37,21 +37,97 @@ int next (Process* process);
 int interpretCommand (Process* process, Node* command);
 
 /**
- * @brief Interpret a function call
+ * @brief Start a call statement in the last scope
  * @param process The process to run
- * @param func The function to call
+ * @param func The call statement
+ * @param start The start of the call chain
+ * @return The exit code of the statement, or STATEMENT_SUSPENDED when it waits for a block or function
 */
 int functionCall (Process* process, Node* func, int start);
 
 /**
- * @brief Interpret a function call chain
+ * @brief Run the call statement of a scope until it ends, or until it has to wait for a block or function
  * @param process The process to run
- * @param func The function to call
- * @param start The start of the call chain
- * @param end The end of the call chain
- * @return The exit code of the function call chain
+ * @param scope The scope the statement runs in
+ * @param code The exit code of the block or function the statement waited for
+ * @return The exit code of the statement, or STATEMENT_SUSPENDED when it waits for a block or function
+*/
+int runStatement (Process* process, Scope* scope, int code);
+
+/**
+ * @brief End a call statement, the scope can move on to it's next line
+ * @param scope The scope the statement ran in
+ * @param code The exit code of the statement
+ * @return The exit code
+*/
+int endStatement (Scope* scope, int code);
+
+/**
+ * @brief End a run of the call chain of a statement, the loop of the statement decides what comes next
+ * @param scope The scope the statement runs in
+ * @param code The exit code of the chain
+ * @return The exit code of the statement, the statement goes on when it hasn't ended
+*/
+int endCallChain (Scope* scope, int code);
+
+/**
+ * @brief Start a FOR, adding the loop variable to the scope
+ * @param process The process to run
+ * @param scope The scope the statement runs in
+ * @param expression The expression of the FOR
+ * @return The exit code, -1 when there are no elements
+*/
+int beginForLoop (Process* process, Scope* scope, Node* expression);
+
+/**
+ * @brief End a FOR, removing the loop variable
+ * @param scope The scope the statement runs in
+*/
+void endForLoop (Scope* scope);
+
+/**
+ * @brief Forget the values the optimizer hoisted out of the previous run of a loop, called when the loop starts
+ * @param ast The AST the loop belongs to
+ * @param loop The WHILE or FOR node
+ * @param array The array the FOR walks, NULL for a WHILE
+*/
+void resetLoopInvariants (AST* ast, Node* loop, Variable* array);
+
+/**
+ * @brief Start a call of a call statement, blocks and functions that aren't standard functions get a new scope the statement waits for
+ * @param process The process to run
+ * @param scope The scope the statement runs in
+ * @param call The call
+ * @return The exit code of the call, or STATEMENT_SUSPENDED when the statement waits for it
+*/
+int beginCall (Process* process, Scope* scope, Node* call);
+
+/**
+ * @brief Finish the call a statement waited for
+ * @param process The process to run
+ * @param scope The scope the statement runs in
+ * @param code The exit code of the scope of the call
+ * @return The exit code of the call, or STATEMENT_SUSPENDED when a tail call takes it's place
+*/
+int endCall (Process* process, Scope* scope, int code);
+
+/**
+ * @brief Evaluate a condition as a BOOL
+ * @param process The process to run
+ * @param condition The condition
+ * @param result Filled with the result
+ * @return The exit code
 */
-int parseCallChain (Process* process, Node* func, int start, int end);
+int parseCondition (Process* process, Node* condition, int* result);
+
+/**
+ * @brief Move on after the statement of a scope ended, an error leaves the scope and is handed to the statement that waits for it
+ * @param process The process to run
+ * @param scope The scope the statement ran in
+ * @param code The exit code of the statement
+ * @return 0 to go on, STATEMENT_INLINE_END when an inline statement ended, otherwise the exit code for the loop that runs the scopes
+*/
+int endStep (Process* process, Scope* scope, int code);
 
 /**
  * @brief Interpret a function call
@@ -59,6 +135,31 @@ int parseCallChain (Process* process, Node* func, int start, int end);
  * @param func The function to call
 */
 int parseCall (Process* process, Node* call);
+
+/**
+ * @brief Replace a call with the inline body of the function it calls, so the next time it's evaluated the function isn't entered
+ * @param call The call to replace, it's kept as the first node of the inline call
+ * @param function The function that was called, with an inline body
+*/
+void inlineCall (Node* call, const Function* function);
+
+/**
+ * @brief Get the call a RETURN returns the result of, when the function that returns can be replaced by that call
+ * @param process The process to run
+ * @param call The call to check
+ * @return The call to make in place of the function, or NULL when the RETURN must be a normal call
+ * @note The call must be to the function itself, and it may not read one of it's variables before declaring it, because variables are looked up through the calling scopes
+*/
+Node* getTailCall (Process* process, Node* call);
+
+/**
+ * @brief Return from the current function, leaving the call it returns the result of for callFunction to make in it's place
+ * @param process The process to run
+ * @param call The call from getTailCall
+ * @return The status
+ * @note The scope of the current function is gone before the call is made, so the call doesn't grow the scope chain or the C stack
+*/
+int tailCall (Process* process, Node* call);
 #include "expression.h"
 
 /**
@@ -89,19 +190,35 @@ int makeFunction (Process* process, Node* func);
 */
 int makeArray (Process* process, Node* func);
 
+/**
+ * @brief Interpret an import, running the module the first time it's imported
+ * @param process The process to run
+ * @param line The import statement
+*/
+int importModule (Process* process, Node* line);
+
 int next (Process* process) {
     if (process->running) {
         
         Scope* scope = getLastScope(&(process->main_scope));
         TerminateType term = scope->terminated;
+        int code;
         if (scope->running_line >= getNodeBodyLength(scope->body->body) || term) {
-            removeLastScope(&process->main_scope);
-            return term ? term : -1; // the block has finished running
+            if (scope == &process->main_scope) return term ? term : -1; // the program has finished running
+
+            // a BREAK, CONTINUE or RETURN can end several scopes at once, they are removed together
+            Scope* parent = getUnwindScope(&process->main_scope);
+            term = parent->child->terminated;
+            removeChildScope(parent);
+            if (!parent->statement.waiting) return term ? term : -1; // the block has finished running
+            // the statement that called the block goes on
+            scope = parent;
+            code = runStatement(process, scope, term ? term : -1);
+        } else {
+            process->running_ast = scope->running_ast;
+            code = interpretCommand(process, &scope->body->body[scope->running_line]);
         }
-
-        int code = interpretCommand(process, &scope->body->body[scope->running_line]);
-        scope->running_line++;
-        return code;
+        return endStep(process, scope, code);
     } else {
         // the process must be running to run the next line
         process->error_code = ERROR_PROCESS_NOT_RUNNING;
@@ -111,6 +228,24 @@ int next (Process* process) {
     }
 }
 
+int endStep (Process* process, Scope* scope, int code) {
+    while (code != STATEMENT_SUSPENDED) {
+        if (scope->statement.inline_statement) {
+            scope->statement.result = code;
+            return STATEMENT_INLINE_END;
+        }
+        scope->running_line++;
+        if (code <= 0) return 0; // the blocks a statement ran have handled their BREAK, CONTINUE or RETURN
+
+        // an error leaves the scope, the statement that waits for it may CATCH it
+        Scope* parent = removeLastScope(&process->main_scope);
+        if (parent == scope || !parent->statement.waiting) return code;
+        scope = parent;
+        code = runStatement(process, scope, code);
+    }
+    return 0;
+}
+
 int interpretCommand (Process* process, Node* command) {
     if (!process->running) {
         // the process must be running to run the next line
@@ -138,295 +273,448 @@ int interpretCommand (Process* process, Node* command) {
         case NODE_ARRAY_DECLARATION:
             return makeArray(process, command);
             break;
+        case NODE_IMPORT:
+            return importModule(process, command);
+            break;
     }
 }
 
 int functionCall (Process* process, Node* func, int start) {
-    if (!func->validated) {
-        if (func->body == NULL) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, func->start));
-        }
-        if (func->body[start].type != NODE_FUNCTION_IDENTIFIER && func->body[start].type != NODE_BLOCK && func->body[start].type != NODE_IF) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, func->body[start].start));
-        }
-        func->validated = 1;
-    }
-
-    // get any WHEN or WHILE statements, these encompass everything before the function call
-    int extension_length = getNodeBodyLength(func->body);
-    int condition_location = -1;
-    int loop = 0;
-    int for_loop = 0;
-    for (int i = start; i < extension_length; i++) {
-        if (func->body[i].type == NODE_WHEN || func->body[i].type == NODE_WHILE || func->body[i].type == NODE_FOR) {
-            condition_location = i + 1;
-            loop = func->body[i].type == NODE_WHILE;
-            for_loop = func->body[i].type == NODE_FOR;
-            if (!func->body[i].validated) { 
-                if (func->body[i].type == NODE_WHILE && i + 1 != extension_length-1) {
-                    return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_WHILE_NOT_LAST, getTokenStart(process, func->body[i].start));
+    Scope* scope = getLastScope(&process->main_scope);
+    int inline_statement = scope->statement.inline_statement;
+    scope->statement = createStatement();
+    scope->statement.node = func;
+    scope->statement.start = start;
+    scope->statement.inline_statement = inline_statement;
+    return runStatement(process, scope, 0);
+}
+
+int runStatement (Process* process, Scope* scope, int code) {
+    Statement* statement = &scope->statement;
+    Node* func = statement->node;
+    if (statement->waiting) {
+        code = endCall(process, scope, code);
+        if (code == STATEMENT_SUSPENDED) return code;
+        statement->result = code;
+    }
+
+    while (1) {
+        switch (statement->step) {
+            case STATEMENT_BEGIN: {
+                // the validator linked the WHEN, WHILE or FOR that encompasses everything before it
+                int extension_length = getNodeBodyLength(func->body);
+                int extension = func->body[statement->start].chain;
+                int condition_location = extension == -1 ? -1 : extension + 1;
+                statement->loop = extension == -1 ? NODE_NULL : func->body[extension].type;
+                statement->end = condition_location == -1 ? extension_length : condition_location - 1;
+
+                if (statement->loop == NODE_WHILE) {
+                    if (!process->worker) resetLoopInvariants(&process->code[scope->running_ast], &func->body[extension], NULL);
+                    statement->step = STATEMENT_WHILE;
+                    break;
                 }
-                func->body[i].validated = 1;
-            }
-            if (func->body[i].type == NODE_WHEN) {
-                if (i+1 == extension_length-1) break;
-                if (func->body[i+2].type != NODE_ELSE) {
-                    return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_ELSE, getTokenStart(process, func->body[i].start));
+                if (statement->loop == NODE_FOR || statement->loop == NODE_PFOR) {
+                    int for_res = beginForLoop(process, scope, &func->body[condition_location]);
+                    if (for_res) return endStatement(scope, for_res > 0 ? for_res : 0);
+                    if (!process->worker) resetLoopInvariants(&process->code[scope->running_ast], &func->body[extension], &statement->loop_array);
+                    if (statement->loop == NODE_PFOR) {
+                        int parallel_res = runParallelFor(process, scope, &func->body[extension]);
+                        if (parallel_res != -1) {
+                            endForLoop(scope);
+                            return endStatement(scope, parallel_res);
+                        }
+                        statement->loop = NODE_FOR; // the iterations run one by one
+                    }
+                    statement->step = STATEMENT_FOR;
+                    break;
                 }
+                statement->loop = NODE_NULL;
+
+                // when the condition is not a loop, we need to check if the condition is true
+                if (condition_location != -1) {
+                    int condition_result = 0;
+                    int condition_res = parseCondition(process, &func->body[condition_location], &condition_result);
+                    if (condition_res) return endStatement(scope, condition_res);
+                    if (!condition_result) {
+                        if (condition_location == extension_length-1) return endStatement(scope, 0);
+                        statement->start = condition_location + 2; // run the chain after the ELSE
+                        break;
+                    }
+                }
+
+                // parse all the expressions before the WHEN when the condition is true
+                statement->link = statement->start;
+                statement->step = STATEMENT_CHAIN;
+                break;
             }
-            break;
-        }
-    }
-    if (!loop && !for_loop) {
-        // when the condition is not a loop, we need to check if the condition is true
-        if (condition_location != -1) {
-            Variable* condition = malloc(sizeof(Variable) + 1);
-            *condition = createNullTerminatedVariable();
-            int condition_res = parseExpression(condition, process, &func->body[condition_location]);
-            if (condition_res) return condition_res;
-            int cast_res = castValue(condition, (Type){TYPE_BOOL,0});
-            if (cast_res) return error(process, getLastScope(&process->main_scope)->running_ast, cast_res, getTokenStart(process, func->body[condition_location].start));
-            int condition_result = *(int*)condition->value;
-            if (!strcmp(condition->name, "-lit")) {
-                destroyVariable(condition);
-                free(condition);
-            }
-            if (!condition_result) {
-                if (condition_location == extension_length-1) return 0;
-                return functionCall(process, func, condition_location+2);
+            case STATEMENT_WHILE: {
+                int condition_result = 0;
+                int condition_res = parseCondition(process, &func->body[statement->end + 1], &condition_result);
+                if (condition_res) return endStatement(scope, condition_res);
+                if (!condition_result) return endStatement(scope, 0); // if the condition is false, we stop the loop
+
+                statement->link = statement->start;
+                statement->step = STATEMENT_CHAIN;
+                break;
             }
+            case STATEMENT_FOR: {
+                Variable* array = (Variable*)statement->loop_array.value;
+                if (array[statement->loop_index].type.dataType == D_NULL) {
+                    endForLoop(scope);
+                    return endStatement(scope, 0);
+                }
+                // the loop variable takes over the value of the element, the array is a literal and is destroyed afterwards
+                scope->variables[statement->loop_variable].value = array[statement->loop_index].value;
+                array[statement->loop_index].value = NULL;
 
-        }
+                statement->link = statement->start;
+                statement->step = STATEMENT_CHAIN;
+                break;
+            }
+            case STATEMENT_CHAIN: {
+                int start = statement->link;
+                statement->chain_start = start;
+                statement->position = start;
+                statement->result = 0;
+                statement->step = STATEMENT_THEN;
+
+                // the first call is a normal call, or an IF statement
+                if (func->body[start].type == NODE_FUNCTION_IDENTIFIER || func->body[start].type == NODE_BLOCK) {
+                    // a RETURN that is the whole chain, outside of a loop, can make it's call in place of the current function
+                    Node* tail_call = NULL;
+                    if (start + 1 >= statement->end && statement->loop == NODE_NULL) tail_call = getTailCall(process, &func->body[start]);
+                    code = tail_call != NULL ? tailCall(process, tail_call) : beginCall(process, scope, &func->body[start]);
+                    if (code == STATEMENT_SUSPENDED) return code;
+                    statement->result = code;
+                    break;
+                }
+                if (func->body[start].type != NODE_IF) {
+                    code = endCallChain(scope, error(process, getLastScope(&process->main_scope)->running_ast, ERROR_IDENTIFIER_INVALID, getTokenStart(process, func->start)));
+                    if (statement->node == NULL) return code; // the statement has ended
+                    break;
+                }
 
-        // parse all the expressions before the WHEN when the condition is true
-        return parseCallChain(process, func, start, condition_location == -1 ? extension_length : condition_location-1);
-    }
-    while (loop) {
-        Variable* condition = malloc(sizeof(Variable));
-        *condition = createNullTerminatedVariable();
-        int condition_res = parseExpression(condition, process, &func->body[condition_location]);
-        if (condition_res) return condition_res;
-        int cast_res = castValue(condition, (Type){TYPE_BOOL,0});
-        if (cast_res) return error(process, getLastScope(&process->main_scope)->running_ast, cast_res, getTokenStart(process, func->body[condition_location].start));
-        int condition_result = *(int*)condition->value;
-        if (!strcmp(condition->name, "-lit")) {
-            destroyVariable(condition);
-            free(condition);
-        }
-        
-        if (!condition_result) { // if the condition is false, we stop the loop
-            return 0;
-        }
+                // check if the condition is true
+                int condition_result = 0;
+                int condition_res = parseCondition(process, &func->body[start+1], &condition_result);
+                if (condition_res) {
+                    code = endCallChain(scope, condition_res);
+                    if (statement->node == NULL) return code; // the statement has ended
+                    break;
+                }
 
-        int call_res = parseCallChain(process, func, start, condition_location-1);
-        if (call_res > 0) return call_res;
+                if (!condition_result) {
+                    if (start + 4 == statement->end && func->body[statement->end].type == NODE_NULL) {
+                        code = endCallChain(scope, 0); // end of the call chain
+                        if (statement->node == NULL) return code;
+                        break;
+                    }
+                    if (func->body[start + 4].type == NODE_ELSE) {
+                        statement->link = start + 5; // run the else block
+                        statement->step = STATEMENT_CHAIN;
+                        break;
+                    }
+                }
 
-        if (call_res == TERMINATE_BREAK || call_res == TERMINATE_RETURN) {
-            return 0;
-        }
-    }
+                // the chain goes on after the ELSE IF branches
+                int newStart = start + 3;
+                if (func->body[newStart + 1].type == NODE_ELSE) {
+                    newStart++;
+                    while (newStart < statement->end) {
+                        if (func->body[newStart].type == NODE_ELSE && func->body[newStart+1].type == NODE_IF) {
+                            newStart += 5;
+                        } else {
+                            break;
+                        }
+                    }
+                }
+                statement->chain_start = newStart;
+                statement->position = newStart;
 
-    if (for_loop) {
-        if (!func->body[condition_location].validated) {
-            if (func->body[condition_location].type != NODE_EXPRESSION) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, func->body[condition_location].start));
+                if (condition_result) {
+                    code = beginCall(process, scope, &func->body[start + 3]);
+                    if (code == STATEMENT_SUSPENDED) return code;
+                    statement->result = code;
+                }
+                break;
             }
-            if (getNodeBodyLength(func->body[condition_location].body) != 3) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXPRESSION, getTokenStart(process, func->body[condition_location].start));
+            case STATEMENT_THEN: {
+                // run the THEN calls, CATCH and INTO are only at the end of the call chain (the validator made sure of that)
+                int i = statement->position + 1;
+                while (i < statement->end && statement->result <= 0 && !(func->body[i].type == NODE_THEN && statement->result == 0)) {
+                    i += 2; // skipping 2 per, since It's: EXT, CALL, EXT, CALL
+                }
+                if (i >= statement->end || statement->result != 0) {
+                    statement->step = STATEMENT_CHAIN_END;
+                    break;
+                }
+                statement->position = i + 1;
+                code = beginCall(process, scope, &func->body[i + 1]);
+                if (code == STATEMENT_SUSPENDED) return code;
+                statement->result = code;
+                break;
             }
+            case STATEMENT_CHAIN_END: {
+                int end = statement->end;
+                int start = statement->chain_start;
+                if (statement->result > 0) {
+                    if (end - 2 > start && func->body[end-2].type == NODE_CATCH) {
+                        int* val = allocValue(sizeof(int));
+                        *val = statement->result;
+
+                        Variable err_code = createLiteral(TYPE_INT, val, 0, 0);
+
+                        setReturnValue(process, &err_code);
+
+                        destroyVariable(&err_code);
+
+                        // if the catch block was successful, we reset the error state of the process
+                        process->error_code = 0;
+                        process->error_ast_index = 0;
+                        process->error_location = 0;
+                        process->running = 1; // we set the process to running again
+
+                        // run the catch block
+                        statement->step = STATEMENT_CATCH;
+                        code = beginCall(process, scope, &func->body[end-1]);
+                        if (code == STATEMENT_SUSPENDED) return code;
+                        statement->result = code;
+                        break;
+                    }
+                    code = endCallChain(scope, statement->result); // if theres no catch, throw the error
+                    if (statement->node == NULL) return code;
+                    break;
+                }
 
-            if (func->body[condition_location].body[1].type != NODE_OPERATOR || getTokenAtPosition(process, func->body[condition_location].body[1].start).carry != OPERATOR_AS) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_OPERATOR, getTokenStart(process, func->body[condition_location].body[1].start));
+                if (end - 2 > start && func->body[end-2].type == NODE_INTO) {
+                    Variable* left;
+                    int left_res = parseRefrenceExpression(&left, process, &func->body[end-1]);
+                    if (left_res) {
+                        code = endCallChain(scope, left_res);
+                        if (statement->node == NULL) return code; // the statement has ended
+                        break;
+                    }
+                    ElementRefrence element;
+                    left = holdElementRefrence(process, left, &element);
+
+                    Variable* underscore = getVariable(&process->main_scope, "_"); // we store _ into the provided variable
+                    int setRes = 0;
+                    if (underscore == NULL) {
+                        setRes = error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INTERNAL, getTokenStart(process, func->body[end-1].start));
+                    } else {
+                        // set the provided variable to the _ variable
+                        setRes = setVariableValue(left, underscore, OPERATOR_ASSIGN);
+                        if (!setRes) setRes = commitRefrence(&element);
+                        if (setRes) setRes = error(process, getLastScope(&process->main_scope)->running_ast, setRes, getTokenStart(process, func->body[end-1].start));
+                    }
+                    destroyVariable(&element.value);
+                    if (setRes) {
+                        code = endCallChain(scope, setRes);
+                        if (statement->node == NULL) return code; // the statement has ended
+                        break;
+                    }
+                }
+                code = endCallChain(scope, statement->result);
+                if (statement->node == NULL) return code; // the statement has ended
+                break;
             }
-
-            if (func->body[condition_location].body[2].type != NODE_IDENTIFIER) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, func->body[condition_location].body[2].start));
+            case STATEMENT_CATCH: {
+                code = endCallChain(scope, statement->result);
+                if (statement->node == NULL) return code; // the statement has ended
+                break;
             }
-            func->body[condition_location].validated = 1;
-        }
-        
-
-        Variable* left = malloc(sizeof(Variable));
-        *left = createNullTerminatedVariable();
-
-        int left_res = parseExpression(left, process, &func->body[condition_location].body[0]);
-        if (left_res) return left_res;
-
-        if (left->type.array == 0) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_ARRAY, getTokenStart(process, func->body[condition_location].start));
         }
-        
-        char* right_name = func->body[condition_location].body[2].text;
-
-        if (getVariable(getLastScope(&process->main_scope), right_name) != NULL) return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_VARIABLE_ALREADY_EXISTS, getTokenStart(process, func->body[condition_location].body[2].start));
+    }
+}
 
-        int len = getVariablesLength((Variable*)left->value);
+int endStatement (Scope* scope, int code) {
+    int inline_statement = scope->statement.inline_statement;
+    scope->statement = createStatement();
+    scope->statement.inline_statement = inline_statement;
+    return code;
+}
 
-        if (len == 0) {
+int endCallChain (Scope* scope, int code) {
+    Statement* statement = &scope->statement;
+    switch (statement->loop) {
+        case NODE_WHILE:
+            if (code > 0) return endStatement(scope, code);
+            if (code == TERMINATE_BREAK || code == TERMINATE_RETURN) return endStatement(scope, 0);
+            statement->step = STATEMENT_WHILE;
             return 0;
-        }
-        int call_res = 0;
-        Variable* realVar = addVariable(getLastScope(&process->main_scope), createVariable(right_name, left->type.dataType, NULL, 0, left->type.array-1));
-
-        for (int f = 0; f < len; f++) {
-            realVar->value = cloneValue(&((Variable*)left->value)[f]);
+        case NODE_FOR:
+            destroyValue(&scope->variables[statement->loop_variable]);
+            if (code > 0 || code == TERMINATE_BREAK || code == TERMINATE_RETURN) {
+                endForLoop(scope);
+                return endStatement(scope, code > 0 ? code : 0);
+            }
+            statement->loop_index++;
+            statement->step = STATEMENT_FOR;
+            return 0;
+        default:
+            return endStatement(scope, code);
+    }
+}
 
-            call_res = parseCallChain(process, func, start, condition_location-1);
+int beginForLoop (Process* process, Scope* scope, Node* expression) {
+    Variable left = createNullTerminatedVariable();
 
-            destroyValue(realVar);
+    int left_res = parseExpression(&left, process, &expression->body[0]);
+    if (left_res) {
+        destroyLiteral(&left);
+        return left_res;
+    }
 
-            if (call_res > 0) break;
+    if (left.type.array == 0) {
+        destroyLiteral(&left);
+        return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_ARRAY, getTokenStart(process, expression->start));
+    }
+    unpackArray(&left);
+    
+    char* right_name = expression->body[2].text;
 
-            if (call_res == TERMINATE_BREAK || call_res == TERMINATE_RETURN) {
-                call_res = 0;
-                break;
-            }
-        }
-        popVariable(getLastScope(&process->main_scope));
+    if (getVariable(scope, right_name) != NULL) {
+        destroyLiteral(&left);
+        return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_VARIABLE_ALREADY_EXISTS, getTokenStart(process, expression->body[2].start));
+    }
 
-        return call_res;
+    if (getVariablesLength((Variable*)left.value) == 0) {
+        destroyLiteral(&left);
+        return -1;
     }
+    addVariable(scope, createVariable(right_name, left.type.dataType, NULL, 0, left.type.array-1));
 
+    Statement* statement = &scope->statement;
+    statement->loop_array = left;
+    statement->loop_index = 0;
+    statement->loop_variable = scope->variable_count - 1;
     return 0;
 }
 
-int parseCallChain (Process* process, Node* func, int start, int end) {
-    if (start > end) return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_IDENTIFIER_INVALID, getTokenStart(process, func->start));
-    
-    int call_res = 0;
-    // the first call is a normal call, or an IF statement
-    if (func->body[start].type == NODE_FUNCTION_IDENTIFIER || func->body[start].type == NODE_BLOCK) {
-        call_res = parseCall(process, &func->body[start]);
-    } else if (func->body[start].type == NODE_IF) {
-        if (!func->body[start].validated) {
-            if (func->body[start + 1].type != NODE_EXPRESSION) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_EXPRESSION, getTokenStart(process, func->body[start + 1].start));
-            }
-            if (func->body[start + 2].type != NODE_THEN) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INVALID_EXTENSION, getTokenStart(process, func->body[start].start));
-            }
-            if (func->body[start + 3].type != NODE_FUNCTION_IDENTIFIER && func->body[start + 3].type != NODE_BLOCK) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, func->body[start + 2].start));
-            }
-            func->body[start].validated = 1;
-        }
-
-        // check if the condition is true
-        Variable* condition = malloc(sizeof(Variable));
-        *condition = createNullTerminatedVariable();
-        int condition_res = parseExpression(condition, process, &func->body[start+1]);
-        if (condition_res) return condition_res;
-        int cast_res = castValue(condition, (Type){TYPE_BOOL,0});
-        if (cast_res) return error(process, getLastScope(&process->main_scope)->running_ast, cast_res, getTokenStart(process, func->body[start + 1].start));
-        int condition_result = *(int*)condition->value;
-        if (!strcmp(condition->name, "-lit")) {
-            destroyVariable(condition);
-            free(condition);
-        }
+void endForLoop (Scope* scope) {
+    destroyLiteral(&scope->statement.loop_array);
+    scope->statement.loop_array = createNullTerminatedVariable();
+    popVariable(scope);
+}
 
-        if (condition_result) {
-            call_res = parseCall(process, &func->body[start + 3]);
-        } else {
-            if (start + 4 == end) {
-                if (func->body[end].type == NODE_NULL) {
-                    return 0; // end of the call chain
-                }
-            }
+void resetLoopInvariants (AST* ast, Node* loop, Variable* array) {
+    if (loop->invariant == -1) return;
+    for (int i = loop->invariant; i < ast->invariant_count && ast->invariants[i].loop == loop->invariant; i++) {
+        if (ast->invariants[i].valid) destroyVariable(&ast->invariants[i].value);
+        ast->invariants[i].valid = 0;
+    }
 
-            if (func->body[start + 4].type == NODE_ELSE) {
-                return functionCall(process, func, start + 5); // run the else block
-            }
+    // the indices by the loop variable are in bounds when the array is longer than the largest one
+    long long int bound = -1;
+    Variable* elements = array == NULL ? NULL : (Variable*)array->value;
+    for (int i = 0; elements != NULL && elements[i].type.dataType != D_NULL; i++) {
+        if (elements[i].type.array || !checkIfNumber(elements[i].type.dataType) || checkIfFloating(elements[i].type.dataType) || getSignedNumber(&elements[i]) < 0) {
+            bound = -1;
+            break;
         }
+        if (getSignedNumber(&elements[i]) > bound) bound = getSignedNumber(&elements[i]);
+    }
+    ast->invariants[loop->invariant].bound = bound;
+}
 
-        int newStart = start + 3;
+int beginCall (Process* process, Scope* scope, Node* call) {
+    Statement* statement = &scope->statement;
+    if (call->type == NODE_BLOCK) {
+        // create a new scope to run the block in, the statement goes on when it ends
+        int depth = getScopeLength(&process->main_scope);
+        *scope->child = createScope(call, scope->running_ast, 0, depth, SCOPE_BLOCK);
+        statement->call = call;
+        statement->waiting = 1;
+        return STATEMENT_SUSPENDED;
+    }
 
-        if (func->body[newStart + 1].type == NODE_ELSE) {
-            newStart++;
-            while (newStart < end) {
-                if (func->body[newStart].type == NODE_ELSE && func->body[newStart+1].type == NODE_IF) {
-                    newStart += 5;
-                } else {
-                    break;
-                }
+    // parse function call to existing function
+    Node* func_node = call->body;
+    int args_length = getNodeBodyLength(func_node[1].body);
+    Variable* args = malloc(sizeof(Variable) * (args_length + 1));
+    for (int i = 0; i < args_length; i++) {
+        args[i] = createNullTerminatedVariable();
+        int res = parseExpression(&args[i], process, &func_node[1].body[i]);
+        if (res) {
+            for (int j = 0; j <= i; j++) {
+                destroyLiteral(&args[j]);
             }
+            free(args);
+            return res;
         }
-
-        start = newStart;
-    } else {
-        return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_IDENTIFIER_INVALID, getTokenStart(process, func->start));
     }
+    args[args_length] = createNullTerminatedVariable();
 
-    // check if the next extension is a THEN, CATCH or INTO (CATCH and INTO only are at the end of the call chain)
-    for (int i = start+1; i < end; i+= 2) { // skipping 2 per, since It's: EXT, CALL, EXT, CALL
-        switch (func->body[i].type) {
-            case NODE_THEN:
-                // if the call was successful, run the next call
-                if (call_res == 0) {
-                    call_res = parseCall(process, &func->body[i+1]);
-                }
-                break;
-            case NODE_CATCH:
-            case NODE_INTO:
-                // if this is not the last call, we return an error
-                if (i+2 != end) {
-                    return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXTENSION_NOT_FINAL, getTokenStart(process, func->body[i].start));
-                }
-                break;
-            default:
-                break;
+    Function* function = getFunction(&process->main_scope, func_node[0].text);
+    int code = 0;
+    if (function != NULL && !function->std_function) {
+        // the function gets a new scope, the statement goes on when it ends
+        code = enterFunction(process, function, args, args_length);
+        if (!code) {
+            statement->call = call;
+            statement->waiting = 1;
+            code = STATEMENT_SUSPENDED;
         }
-        if (call_res > 0) break; // if the call was not successful, we stop the call chain and perhapse run a CATCH
+    } else {
+        code = callFunction(func_node[0].text, args, args_length, process);
     }
 
-    if (call_res > 0) {
-        if (func->body[end-2].type == NODE_CATCH) {
-            int* val = malloc(sizeof(int));
-            *val = call_res;
-
-            Variable* err_code = malloc(sizeof(Variable));
-            *err_code = createVariable("-lit", TYPE_INT, val, 0, 0);
-
-            setReturnValue(process, err_code);
-
-            destroyVariable(err_code);
-            free(err_code);
+    for (int i = 0; i < args_length; i++) {
+        destroyVariable(&args[i]);
+    }
+    free(args);
+    if (code > 0 && process->running) {
+        return error(process, getLastScope(&process->main_scope)->running_ast, code, getTokenStart(process, func_node[0].start));
+    }
+    return code;
+}
 
-            // if the catch block was successful, we reset the error state of the process
-            process->error_code = 0;
-            process->error_ast_index = 0;
-            process->error_location = 0;
-            process->running = 1; // we set the process to running again
+int endCall (Process* process, Scope* scope, int code) {
+    Statement* statement = &scope->statement;
+    statement->waiting = 0;
+    process->running_ast = scope->running_ast;
+    if (statement->call->type == NODE_BLOCK) {
+        return code == -1 ? 0 : code;
+    }
 
-            // run the catch block
-            int catch_res = parseCall(process, &func->body[end-1]);
-            return catch_res;
+    // a RETURN of a call in tail position leaves the call to be made here, so it runs in place of the function that returned
+    if (code <= 0 && process->tail_call.function != NULL) {
+        TailCall tail_call = process->tail_call;
+        process->tail_call = (TailCall){ NULL, NULL, 0 };
+        code = enterFunction(process, tail_call.function, tail_call.args, tail_call.args_length);
+        clearTailCall(&tail_call);
+        if (!code) {
+            statement->waiting = 1;
+            return STATEMENT_SUSPENDED;
         }
-        return call_res; // if theres no catch, throw the error
     }
+    clearTailCall(&process->tail_call);
 
-    if (func->body[end-2].type == NODE_INTO) {
-        Variable* left;
-        int left_res = parseRefrenceExpression(&left, process, &func->body[end-1]);
-        if (left_res) return left_res;
-
-        Variable* underscore = getVariable(&process->main_scope, "_"); // we store _ into the provided variable
-        if (underscore == NULL) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_INTERNAL, getTokenStart(process, func->body[end-1].start));
-        }
+    code = code > 0 ? code : 0;
+    if (code && process->running) {
+        return error(process, scope->running_ast, code, getTokenStart(process, statement->call->body[0].start));
+    }
+    return code;
+}
 
-        // set the provided variable to the _ variable
-        int setRes = setVariableValue(left, underscore, OPERATOR_ASSIGN);
-        if (setRes) return error(process, getLastScope(&process->main_scope)->running_ast, setRes, getTokenStart(process, func->body[end-1].start));
+int parseCondition (Process* process, Node* condition, int* result) {
+    Variable value = createNullTerminatedVariable();
+    int condition_res = parseExpression(&value, process, condition);
+    if (!condition_res) {
+        condition_res = castValue(&value, (Type){TYPE_BOOL,0});
+        if (condition_res) error(process, getLastScope(&process->main_scope)->running_ast, condition_res, getTokenStart(process, condition->start));
     }
-    
-    return call_res;
+    *result = condition_res ? 0 : *(int*)value.value;
+    destroyLiteral(&value);
+    return condition_res;
 }
 
 int parseCall (Process* process, Node* call) {
     // parse block as inline function
     if (call->type == NODE_BLOCK || call->type == NODE_BLOCK_EXPRESSION) {
         // create a new scope to run the function in
-        Scope scope = createScope(call, getLastScope(&process->main_scope)->running_ast, 0, getScopeLength(&process->main_scope), call->type == NODE_BLOCK ? SCOPE_BLOCK : SCOPE_EXPRESSION);
+        int depth = getScopeLength(&process->main_scope);
+        Scope scope = createScope(call, getLastScope(&process->main_scope)->running_ast, 0, depth, call->type == NODE_BLOCK ? SCOPE_BLOCK : SCOPE_EXPRESSION);
         *getLastScope(&process->main_scope)->child = scope;
 
         // execute the function in here
@@ -436,30 +724,29 @@ int parseCall (Process* process, Node* call) {
             if (code) break;
         }
         if (code == -1) code = 0;
+        if (code > 0) unwindScopes(&process->main_scope, depth); // the error left the block before it finished
         return code;
     }
 
     // parse function call to existing function
     Node* func_node = call->body;
-    if (!call->validated) {
-        if (func_node[0].type != NODE_IDENTIFIER) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, func_node[0].start));
-        }
-        if (func_node[1].type != NODE_ARGUMENTS) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_ARGUMENTS, getTokenStart(process, func_node[1].start));
-        }
-        call->validated = 1;
-    }
-    
     int args_length = getNodeBodyLength(func_node[1].body);
     Variable* args = malloc(sizeof(Variable) * (args_length + 1));
     for (int i = 0; i < args_length; i++) {
         args[i] = createNullTerminatedVariable();
         int res = parseExpression(&args[i], process, &func_node[1].body[i]);
-        if (res) return res;
+        if (res) {
+            for (int j = 0; j <= i; j++) {
+                destroyLiteral(&args[j]);
+            }
+            free(args);
+            return res;
+        }
     }
     args[args_length] = createNullTerminatedVariable();
     int code = callFunction(func_node[0].text, args, args_length, process);
+    Function* inline_function = process->inline_function;
+    process->inline_function = NULL;
 
     for (int i = 0; i < args_length; i++) {
         destroyVariable(&args[i]);
@@ -468,20 +755,75 @@ int parseCall (Process* process, Node* call) {
     if (code && process->running) {
         return error(process, getLastScope(&process->main_scope)->running_ast, code, getTokenStart(process, func_node[0].start));
     }
+
+    // the inline body refers to the tokens of the function, so only calls in the same AST are inlined
+    // an argument may have run the same call and inlined it already
+    if (!code && inline_function != NULL && inline_function->ast_index == process->running_ast && call->type == NODE_FUNCTION_IDENTIFIER) {
+        inlineCall(call, inline_function);
+    }
     return code;
 }
 
-int makeVariable (Process* process, Node* line) {
-    if (!line->validated){
-        if (line->body[0].type != NODE_TYPE_IDENTIFIER) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_TYPE, getTokenStart(process, line->body[0].start));
-        }
-        if (line->body[1].type != NODE_IDENTIFIER) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, line->body[1].start));
+void inlineCall (Node* call, const Function* function) {
+    Node inlined = createNullTerminatedNode();
+    inlined.type = NODE_INLINE_CALL;
+    inlined.start = call->start;
+    inlined.end = call->end;
+    addToBody(&inlined.body, *call);
+    int length = getNodeBodyLength(function->inline_body->body);
+    for (int i = 0; i < length; i++) {
+        addToBody(&inlined.body, cloneNode(&function->inline_body->body[i]));
+    }
+    *call = inlined;
+}
+
+Node* getTailCall (Process* process, Node* call) {
+    if (call->type != NODE_FUNCTION_IDENTIFIER || strcmp(call->body[0].text, "RETURN") || getNodeBodyLength(call->body[1].body) != 1) return NULL;
+
+    Node* returned = &call->body[1].body[0];
+    while (returned->type == NODE_EXPRESSION && getNodeBodyLength(returned->body) == 1) returned = &returned->body[0];
+    if (returned->type != NODE_FUNCTION_IDENTIFIER) return NULL;
+
+    Scope* scope = getReturnScope(&process->main_scope);
+    if (scope->callType != SCOPE_FUNCTION || scope->returnType.dataType == TYPE_VOID) return NULL;
+
+    // only a function calling itself, a call to another function could read the variables of the function that returned
+    Function* function = getFunction(&process->main_scope, returned->body[0].text);
+    if (function == NULL || function->std_function || function->body != scope->body) return NULL;
+    if (function->arguments_length != getNodeBodyLength(returned->body[1].body)) return NULL;
+    if (function->tail_call != 1) return NULL;
+
+    Function* return_function = getFunction(&process->main_scope, "RETURN");
+    if (return_function == NULL || !return_function->std_function) return NULL;
+    return returned;
+}
+
+int tailCall (Process* process, Node* call) {
+    // the arguments are evaluated in the current function, like they would be for a normal call
+    Node* func_node = call->body;
+    int args_length = getNodeBodyLength(func_node[1].body);
+    Variable* args = malloc(sizeof(Variable) * (args_length + 1));
+    for (int i = 0; i < args_length; i++) {
+        args[i] = createNullTerminatedVariable();
+        int res = parseExpression(&args[i], process, &func_node[1].body[i]);
+        if (res) {
+            for (int j = 0; j <= i; j++) {
+                destroyLiteral(&args[j]);
+            }
+            free(args);
+            return res;
         }
-        line->validated = 1;
     }
+    args[args_length] = createNullTerminatedVariable();
+
+    // end the function like RETURN does, the blocks in it are terminated and the function itself ends normally
+    terminateReturn(&process->main_scope);
+
+    process->tail_call = (TailCall){ getFunction(&process->main_scope, func_node[0].text), args, args_length };
+    return 0;
+}
 
+int makeVariable (Process* process, Node* line) {
     // check if variable already exists
     if (getVariable(getLastScope(&process->main_scope), line->body[1].text) != NULL) {
         return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_VARIABLE_ALREADY_EXISTS, getTokenStart(process, line->body[1].start));
@@ -489,70 +831,56 @@ int makeVariable (Process* process, Node* line) {
 
     Variable var = createNullTerminatedVariable();
     int dataRes = parseExpression(&var, process, &line->body[2]);
-    if (dataRes) return dataRes;
-    free (var.name); // free the old name, since we're going to overwrite it
-    var.name = malloc(sizeof(char) * (strlen(line->body[1].text) + 1));
-    strcpy(var.name, line->body[1].text);
-    var.constant = 0;
+    if (dataRes) {
+        destroyLiteral(&var);
+        return dataRes;
+    }
     Type t;
     t.dataType = getTokenAtPosition(process, line->body[0].start).carry;
     t.array = 0;
     int castRes = castValue(&var, t);
-    if (castRes) return error(process, getLastScope(&process->main_scope)->running_ast, castRes, getTokenStart(process, line->body[2].start));
+    if (castRes) {
+        destroyLiteral(&var);
+        return error(process, getLastScope(&process->main_scope)->running_ast, castRes, getTokenStart(process, line->body[2].start));
+    }
+    // the literal becomes a named variable owned by the scope
+    var.name = malloc(sizeof(char) * (strlen(line->body[1].text) + 1));
+    strcpy(var.name, line->body[1].text);
+    var.constant = 0;
+    var.literal = 0;
     addVariable(getLastScope(&process->main_scope), var);
     return 0;
 }
 
 int setVariable (Process* process, Node* line) {
     OperatorType operator = getTokenAtPosition(process, line->body[1].start).carry;
-    if (!line->validated) {
-        if (!isAssignmentOperator(operator) || line->body[1].type != NODE_OPERATOR) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_ASSIGN_OPERATOR, getTokenStart(process, line->body[1].start));
-        }
-        line->validated = 1;
-    }
-    
+
     Variable* left;
     int left_res = parseRefrenceExpression(&left, process, &line->body[0]); // we need to retrieve the refrerence, so we overwrite the variable
     if (left_res) return left_res;
+    ElementRefrence element;
+    left = holdElementRefrence(process, left, &element); // the right side may refrence another element
     if (left->constant) {
+        destroyVariable(&element.value);
         return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_CANNOT_MODIFY_CONSTANT, getTokenStart(process, line->body[0].start));
     }
-    Variable* right = malloc(sizeof(Variable)); // right does need to be freed, it's a value type
-    *right = createNullTerminatedVariable();
-    int rightRes = parseExpression(right, process, &line->body[2]); // we need to retrieve the value
-    if (rightRes) return rightRes;
+    Variable right = createNullTerminatedVariable(); // right is a literal, it's a value type
+    int rightRes = parseExpression(&right, process, &line->body[2]); // we need to retrieve the value
+    if (rightRes) {
+        destroyLiteral(&right);
+        destroyVariable(&element.value);
+        return rightRes;
+    }
     
-    int setRes = setVariableValue(left, right, operator);
+    int setRes = setVariableValue(left, &right, operator);
+    if (!setRes) setRes = commitRefrence(&element);
+    destroyVariable(&element.value);
+    destroyLiteral(&right);
     if (setRes) return error(process, getLastScope(&process->main_scope)->running_ast, setRes, getTokenStart(process, line->body[2].start));
-
-    if (!strcmp(right->name, "-lit")) {
-        destroyVariable(right);
-        free(right);
-    }
     return 0;
 }
 
 int makeFunction (Process* process, Node* line) {
-    if (!line->validated) {
-        if (line->body[0].type != NODE_TYPE_IDENTIFIER) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_TYPE, getTokenStart(process, line->body[0].start));
-        }
-
-        if (line->body[1].type != NODE_IDENTIFIER) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, line->body[1].start));
-        }
-
-        if (line->body[2].type != NODE_FUNCTION_DECLARATION_ARGUMENTS) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_ARGUMENTS, getTokenStart(process, line->body[2].start));
-        }
-
-        if (line->body[3].type != NODE_BLOCK) {
-            return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_BLOCK, getTokenStart(process, line->body[3].start));
-        }
-        line->validated = 1;
-    }
-
     // check if function already exists
     if (getFunction(&process->main_scope, line->body[1].text) != NULL) {
         return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_FUNCTION_ALREADY_EXISTS, getTokenStart(process, line->body[1].start));
@@ -572,10 +900,6 @@ int makeFunction (Process* process, Node* line) {
                 end_node = &end_node->body[1];
             }
             t.dataType = getTokenAtPosition(process, end_node->body[0].start).carry;
-
-            if (end_node->body[1].type != NODE_IDENTIFIER) {
-                return error(process, getLastScope(&process->main_scope)->running_ast, ERROR_EXPECTED_IDENTIFIER, getTokenStart(process, end_node->body[1].start));
-            }
             args[i] = createArgument(end_node->body[1].text, t);
         }
     }
@@ -585,7 +909,20 @@ int makeFunction (Process* process, Node* line) {
     int tRes = getTypeFromNode(process, &returnType, &line->body[0]);
     if (tRes) return error(process, getLastScope(&process->main_scope)->running_ast, tRes, getTokenStart(process, line->body[0].start));
 
-    addFunction(&process->main_scope, createFunction(line->body[1].text, &line->body[3], args, argc, returnType, 0));
+    Function function = createFunction(line->body[1].text, &line->body[3], args, argc, returnType, 0);
+    function.ast_index = process->running_ast;
+    function.declaration = line;
+
+    // a MEMO function is checked when it's declared, so it's body is parsed right away
+    AST* ast = &process->code[process->running_ast];
+    if (isMemoKeyword(ast->full_code, ast->tokens, line->start)) {
+        int mRes = prepareMemoFunction(process, &function);
+        if (mRes) {
+            destroyFunction(&function);
+            return error(process, getLastScope(&process->main_scope)->running_ast, mRes, getTokenStart(process, line->body[1].start));
+        }
+    }
+    addFunction(&process->main_scope, function);
 
     return 0;
 }
@@ -603,18 +940,73 @@ int makeArray (Process* process, Node* line) {
 
     Variable var = createNullTerminatedVariable();
     int dataRes = parseExpression(&var, process, &end_node->body[2]);
-    if (dataRes) return dataRes;
+    if (dataRes) {
+        destroyLiteral(&var);
+        return dataRes;
+    }
     if (!compareType(var.type, t)) {
         int cRes = castValue(&var, t);
-        if (cRes) return error(process, getLastScope(&process->main_scope)->running_ast, cRes, getTokenStart(process, end_node->body[0].start));
+        if (cRes) {
+            destroyLiteral(&var);
+            return error(process, getLastScope(&process->main_scope)->running_ast, cRes, getTokenStart(process, end_node->body[0].start));
+        }
     }
-    free (var.name); // free the old name, since we're going to overwrite it
+    // the literal becomes a named variable owned by the scope
     var.name = malloc(sizeof(char) * (strlen(end_node->body[1].text) + 1));
     strcpy(var.name, end_node->body[1].text);
     var.constant = 0;
+    var.literal = 0;
+    packArray(&var);
 
     addVariable(getLastScope(&process->main_scope), var);
     return 0;
 }
 
+int importModule (Process* process, Node* line) {
+    Variable path = createNullTerminatedVariable();
+    int path_res = parseExpression(&path, process, &line->body[0]);
+    if (!path_res) path_res = castValue(&path, (Type){TYPE_STRING, 0});
+    if (path_res) {
+        destroyLiteral(&path);
+        return error(process, getLastScope(&process->main_scope)->running_ast, path_res, getTokenStart(process, line->body[0].start));
+    }
+
+    Scope* scope = getLastScope(&process->main_scope);
+    int importer_ast = scope->running_ast;
+    char* resolved = resolveModulePath(process->code[importer_ast].filename, (char*)path.value);
+    destroyLiteral(&path);
+    if (resolved == NULL) {
+        return error(process, importer_ast, ERROR_FILE_NOT_FOUND, getTokenStart(process, line->body[0].start));
+    }
+
+    int module_ast = 0;
+    int load_res = loadModule(process, resolved, &module_ast);
+    free(resolved);
+    if (load_res == -1) return 0; // already imported
+    if (load_res) return error(process, importer_ast, load_res, getTokenStart(process, line->body[0].start));
+
+    // the module runs in the scope that imports it, like the code was written there
+    scope->running_ast = module_ast;
+    process->running_ast = module_ast;
+    Node* body = process->code[module_ast].root.body; // the body stays in place when more modules are loaded
+    Statement statement = scope->statement;
+    scope->statement = createStatement();
+    scope->statement.inline_statement = 1;
+    int code = 0;
+    for (int i = 0; i < getNodeBodyLength(body); i++) {
+        code = interpretCommand(process, &body[i]);
+        // a statement that waits for a block or function is run on until it ends
+        while (code == STATEMENT_SUSPENDED) {
+            code = next(process);
+            if (code == STATEMENT_INLINE_END) code = scope->statement.result;
+            else if (!code) code = STATEMENT_SUSPENDED;
+        }
+        if (code) break;
+    }
+    scope->statement = statement;
+    scope->running_ast = importer_ast;
+    process->running_ast = importer_ast;
+    return code > 0 ? code : 0;
+}
+
 #endif
\ No newline at end of file
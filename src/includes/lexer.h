@@ -52,6 +52,12 @@ void sortTokens (Token** tokens);
 */
 void trimComments (Token** tokens);
 
+/**
+ * @brief Link every bracket token to its matching bracket, so blocks can be found without scanning
+ * @param tokens The list of tokens
+*/
+void matchBrackets (Token* tokens);
+
 
 void addToken(Token** tokensPtr, TokenType type, int start, int end, int carry) {
     int numTokens = 0;
@@ -109,6 +115,25 @@ void trimComments (Token** tokens) {
     (*tokens)[tokenCount].type = TOKEN_END;
 }
 
+void matchBrackets (Token* tokens) {
+    int length = getTokenAmount(tokens);
+    int* open = malloc(sizeof(int) * (length + 1));
+    int depth = 0;
+    for (int i = 0; i < length; i++) {
+        tokens[i].block = i;
+        if (tokens[i].type != TOKEN_PARENTHESIS) continue;
+        if (tokens[i].carry == -1) continue; // closing bracket of the wrong type
+        if (depth > 0 && tokens[open[depth - 1]].carry == tokens[i].carry) {
+            tokens[i].block = open[depth - 1];
+            tokens[open[depth - 1]].block = i;
+            depth--;
+        } else {
+            open[depth++] = i;
+        }
+    }
+    free(open);
+}
+
 void tokenise (Token** tokens, const char* full_code, const int code_length) {
     int tokenCount = 0;
 
@@ -263,7 +288,7 @@ void tokenise (Token** tokens, const char* full_code, const int code_length) {
     // get bracket tokens
     const char* brackettokens[] = BRACKETS;
     int bracketTier = 0;
-    int bracketTypeHiarcy[code_length];
+    int bracketTypeHiarcy[code_length + 1];
     for (int k = 0; k < code_length; k++) bracketTypeHiarcy[k] = -1;
     for (int i = 0; i < code_length; i++) {
         for (int t = 0; t < tokenCount; t++) {
@@ -415,6 +440,7 @@ void tokenise (Token** tokens, const char* full_code, const int code_length) {
     // finalise tokens
     sortTokens(tokens);
     trimComments(tokens); // comments will be ignored from now on
+    matchBrackets(*tokens);
 }
 
 #endif
\ No newline at end of file
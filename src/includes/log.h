@@ -10,6 +10,7 @@
 #define LOG_H
 
 #include <stdio.h>
+#include <setjmp.h>
 #include "strtools.h"
 
 typedef enum {
@@ -101,6 +102,7 @@ typedef enum {
     ERROR_PERMISSION_DENIED,
     ERROR_INVALID_EXTENSION,
     ERROR_INCORRECT_RETURN_TYPE,
+    ERROR_FUNCTION_NOT_PURE,
     
     ERROR_INTERNAL,
     ERROR_UNKNOWN,
@@ -108,6 +110,18 @@ typedef enum {
 
 } ErrorType;
 
+/**
+ * @brief Catches the errors of the lexer and parser, so they can run on other threads without quitting the program
+*/
+typedef struct {
+    jmp_buf jump;
+    int code;
+    int position;
+} ErrorTrap;
+
+// when set, printError stores the error in the trap and jumps back to it instead of quitting, every thread has it's own
+_Thread_local ErrorTrap* error_trap = NULL;
+
 const char* ERROR_MESSAGES[] = {
     "No error Occured? (CODE NULL)", 
 
@@ -191,6 +205,7 @@ const char* ERROR_MESSAGES[] = {
     "Permission denied",
     "Invalid DO extension",
     "Incorrect return type",
+    "A MEMO function can only change it's own variables, read it's own variables and call pure functions",
 
     "Internal Error, please report this to the developer",
     "Unknown Error",
@@ -205,13 +220,21 @@ const char* ERROR_MESSAGES[] = {
 void logText (const LogType type, const char* contents);
 
 /**
- * @brief Prints an error message and quits the program with the error code
+ * @brief Prints an error message and quits the program with the error code, or jumps back to the error trap of the thread when it's set
  * @param full_code The full code
  * @param pos The position of the error
  * @param type The type of error, also the error code
 */
 void printError (const char* full_code, const int pos, const ErrorType type);
 
+/**
+ * @brief Prints an error message without quitting, used to report multiple errors at once
+ * @param full_code The full code
+ * @param pos The position of the error
+ * @param type The type of error
+*/
+void reportError (const char* full_code, const int pos, const ErrorType type);
+
 void logText (const LogType type, const char* contents) {
     printf("\n");
     switch (type) {
@@ -233,13 +256,21 @@ void logText (const LogType type, const char* contents) {
     }
 }
 void printError (const char* full_code, const int pos, const ErrorType type) {
-    printf("\nERROR:\n");
-    printf("E%d: %s\n", type, ERROR_MESSAGES[type < ERROR_AMOUNT && ERROR_AMOUNT > 0 ? type : ERROR_UNKNOWN]);
-    printf("At line %i:%i\n", getLine(full_code, pos), getLineCol(full_code, pos));
+    if (error_trap != NULL) {
+        error_trap->code = type;
+        error_trap->position = pos;
+        longjmp(error_trap->jump, 1);
+    }
+    reportError(full_code, pos, type);
     #ifdef _WIN32
     _fcloseall(); // close all files if any were opened
     #endif
     exit(type);
 }
+void reportError (const char* full_code, const int pos, const ErrorType type) {
+    printf("\nERROR:\n");
+    printf("E%d: %s\n", type, ERROR_MESSAGES[type < ERROR_AMOUNT && ERROR_AMOUNT > 0 ? type : ERROR_UNKNOWN]);
+    printf("At line %i:%i\n", getLine(full_code, pos), getLineCol(full_code, pos));
+}
 
 #endif
\ No newline at end of file
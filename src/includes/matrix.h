@@ -0,0 +1,448 @@
+/**
+ * @author Sebastiaan Heins
+ * @file matrix.h
+ * @brief Stores rectangular arrays of numbers as one block of elements with a shape, instead of an array of arrays
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "token.h"
+
+/**
+ * @brief The value of a dense array, it starts like a variable so getVariablesLength can tell it apart from a list of variables
+*/
+typedef struct {
+    char* name; // always NULL
+    Type type; // always TYPE_MATRIX
+    int length; // the length of the first dimension
+    int dimensions;
+    DataType element_type;
+    int element_size;
+    long long int element_count;
+    long long int extents[]; // the shape, then the strides (in elements), then the elements in row-major order
+} Matrix;
+
+/**
+ * @brief Create a matrix with all elements set to 0
+ * @param element_type The type of the elements
+ * @param dimensions The amount of dimensions
+ * @param shape The length of every dimension
+ * @return The matrix (free it with freeValue)
+*/
+Matrix* createMatrix (DataType element_type, int dimensions, const long long int* shape);
+
+/**
+ * @brief Get whether or not the value of a variable is a matrix
+ * @param variable The variable to check
+ * @return Whether or not the variable is a matrix
+*/
+int isMatrix (const Variable* variable);
+
+/**
+ * @brief Get whether or not arrays of a type can be stored as a matrix
+ * @param type The type of the elements
+ * @return Whether or not the type is a fixed size number
+*/
+int isMatrixType (DataType type);
+
+/**
+ * @brief Get the size of the value of an element of a matrix
+ * @param type The type of the elements
+ * @return The size in bytes, 0 when the type can't be stored in a matrix
+*/
+int getMatrixElementSize (DataType type);
+
+/**
+ * @brief Get the shape of a matrix
+ * @param matrix The matrix
+ * @return The length of every dimension
+*/
+long long int* getMatrixShape (const Matrix* matrix);
+
+/**
+ * @brief Get the strides of a matrix
+ * @param matrix The matrix
+ * @return The amount of elements between two indices of every dimension
+*/
+long long int* getMatrixStrides (const Matrix* matrix);
+
+/**
+ * @brief Get the elements of a matrix
+ * @param matrix The matrix
+ * @return The first byte of the first element
+*/
+char* getMatrixData (const Matrix* matrix);
+
+/**
+ * @brief Get the size of a matrix, including the header
+ * @param matrix The matrix
+ * @return The size in bytes
+*/
+size_t getMatrixSize (const Matrix* matrix);
+
+/**
+ * @brief Build a matrix from a rectangular array, the arrays inside it may already be matrices
+ * @param variable The array
+ * @return The matrix (free it with freeValue), or NULL when the array isn't rectangular or it's elements aren't numbers of the type of the array
+*/
+Matrix* buildMatrix (const Variable* variable);
+
+/**
+ * @brief Measure a level of an array for buildMatrix, checking every element has the same shape
+ * @param variable The array or element at this level
+ * @param level The level
+ * @param dimensions The amount of dimensions of the whole array
+ * @param type The type of the elements
+ * @param shape The shape, -1 for the lengths that haven't been seen yet
+ * @return Whether or not the level is rectangular
+*/
+int measureMatrix (const Variable* variable, int level, int dimensions, DataType type, long long int* shape);
+
+/**
+ * @brief Copy the elements of a measured array into a matrix
+ * @param variable The array or element
+ * @param data The position to copy to, moved past the copied elements
+ * @param element_size The size of an element
+*/
+void copyIntoMatrix (const Variable* variable, char** data, int element_size);
+
+/**
+ * @brief Turn an array of arrays of numbers into a matrix, when it's rectangular
+ * @param variable The array to pack, it's left untouched when it isn't rectangular
+*/
+void packMatrix (Variable* variable);
+
+/**
+ * @brief Turn the first dimension of a matrix back into a list of variables, the elements become matrices with one dimension less
+ * @param variable The matrix
+*/
+void unpackMatrix (Variable* variable);
+
+/**
+ * @brief Clone a matrix
+ * @param matrix The matrix
+ * @return The clone (free it with freeValue)
+*/
+Matrix* cloneMatrix (const Matrix* matrix);
+
+/**
+ * @brief Copy the part of a matrix that starts at an offset into a matrix with less dimensions
+ * @param matrix The matrix
+ * @param offset The offset of the first element
+ * @param skipped The amount of leading dimensions that are fixed by the offset
+ * @return The new matrix (free it with freeValue)
+*/
+Matrix* sliceMatrix (const Matrix* matrix, long long int offset, int skipped);
+
+/**
+ * @brief Compute the offset of the element, or the start of the slice, that a list of indices points to
+ * @param matrix The matrix
+ * @param indices The indices, negative indices count from the end like they do for other arrays
+ * @param count The amount of indices, at most the amount of dimensions
+ * @param offset Filled with the offset in elements
+ * @return The error code
+*/
+int getMatrixOffset (const Matrix* matrix, const Variable* indices, int count, long long int* offset);
+
+/**
+ * @brief Index a matrix with a list of indices at once
+ * @param var The variable to set the element or slice to (the old value is destroyed)
+ * @param matrix The matrix variable
+ * @param indices The indices
+ * @param count The amount of indices
+ * @return The error code
+*/
+int indexMatrix (Variable* var, const Variable* matrix, const Variable* indices, int count);
+
+/**
+ * @brief Convert a matrix to a string, the same way an array of arrays is converted
+ * @param matrix The matrix
+ * @return The string (must be freed after use)
+*/
+char* matrixToString (const Matrix* matrix);
+
+/**
+ * @brief Add a dimension of a matrix to a string
+ * @param matrix The matrix
+ * @param dimension The dimension
+ * @param offset The offset of the first element of this part
+ * @param str The string to add to, it's reallocated when it grows
+ * @param length The length of the string
+ * @param capacity The capacity of the string
+*/
+void appendMatrixString (const Matrix* matrix, int dimension, long long int offset, char** str, size_t* length, size_t* capacity);
+
+/**
+ * @brief Add text to the end of a growing string
+ * @param str The string, it's reallocated when it grows
+ * @param length The length of the string
+ * @param capacity The capacity of the string
+ * @param text The text to add
+*/
+void appendString (char** str, size_t* length, size_t* capacity, const char* text);
+
+
+Matrix* createMatrix (DataType element_type, int dimensions, const long long int* shape) {
+    long long int count = 1;
+    for (int i = 0; i < dimensions; i++) {
+        count *= shape[i];
+    }
+    int element_size = getMatrixElementSize(element_type);
+    Matrix* matrix = calloc(1, sizeof(Matrix) + sizeof(long long int) * dimensions * 2 + element_size * count);
+    matrix->name = NULL;
+    matrix->type = (Type){TYPE_MATRIX, 0};
+    matrix->length = shape[0];
+    matrix->dimensions = dimensions;
+    matrix->element_type = element_type;
+    matrix->element_size = element_size;
+    matrix->element_count = count;
+
+    long long int* extents = getMatrixShape(matrix);
+    long long int* strides = getMatrixStrides(matrix);
+    long long int stride = 1;
+    for (int i = dimensions - 1; i >= 0; i--) {
+        extents[i] = shape[i];
+        strides[i] = stride;
+        stride *= shape[i];
+    }
+    return matrix;
+}
+
+int isMatrix (const Variable* variable) {
+    return variable->type.array > 0 && variable->value != NULL && ((Matrix*)variable->value)->type.dataType == TYPE_MATRIX;
+}
+
+int isMatrixType (DataType type) {
+    return getMatrixElementSize(type) != 0;
+}
+
+int getMatrixElementSize (DataType type) {
+    switch (type) {
+        case TYPE_CHAR:
+        case TYPE_BYTE:
+        case TYPE_UBYTE:
+            return sizeof(char);
+        case TYPE_SHORT:
+        case TYPE_USHORT:
+            return sizeof(short);
+        case TYPE_INT:
+        case TYPE_UINT:
+            return sizeof(int);
+        case TYPE_LONG:
+        case TYPE_ULONG:
+            return sizeof(long long int);
+        case TYPE_FLOAT:
+            return sizeof(float);
+        case TYPE_DOUBLE:
+            return sizeof(double);
+        default:
+            return 0;
+    }
+}
+
+long long int* getMatrixShape (const Matrix* matrix) {
+    return (long long int*)matrix->extents;
+}
+
+long long int* getMatrixStrides (const Matrix* matrix) {
+    return (long long int*)matrix->extents + matrix->dimensions;
+}
+
+char* getMatrixData (const Matrix* matrix) {
+    return (char*)(matrix->extents + matrix->dimensions * 2);
+}
+
+size_t getMatrixSize (const Matrix* matrix) {
+    return sizeof(Matrix) + sizeof(long long int) * matrix->dimensions * 2 + matrix->element_size * matrix->element_count;
+}
+
+Matrix* buildMatrix (const Variable* variable) {
+    if (isMatrix(variable)) return cloneMatrix((Matrix*)variable->value);
+    if (!variable->type.array || variable->value == NULL || !isMatrixType(variable->type.dataType)) return NULL;
+
+    int dimensions = variable->type.array;
+    long long int* shape = malloc(sizeof(long long int) * dimensions);
+    for (int i = 0; i < dimensions; i++) {
+        shape[i] = -1;
+    }
+
+    Matrix* matrix = NULL;
+    int rectangular = measureMatrix(variable, 0, dimensions, variable->type.dataType, shape);
+    for (int i = 0; i < dimensions; i++) {
+        if (shape[i] == -1) rectangular = 0; // an empty array doesn't tell the length of the dimensions inside it
+    }
+    if (rectangular) {
+        matrix = createMatrix(variable->type.dataType, dimensions, shape);
+        char* data = getMatrixData(matrix);
+        copyIntoMatrix(variable, &data, matrix->element_size);
+    }
+    free(shape);
+    return matrix;
+}
+
+int measureMatrix (const Variable* variable, int level, int dimensions, DataType type, long long int* shape) {
+    if (level == dimensions) {
+        return !variable->type.array && variable->type.dataType == type && variable->value != NULL;
+    }
+    if (variable->type.array != dimensions - level || variable->value == NULL) return 0;
+
+    if (isMatrix(variable)) {
+        Matrix* matrix = (Matrix*)variable->value;
+        if (matrix->element_type != type) return 0;
+        for (int i = 0; i < matrix->dimensions; i++) {
+            if (shape[level + i] == -1) shape[level + i] = getMatrixShape(matrix)[i];
+            if (shape[level + i] != getMatrixShape(matrix)[i]) return 0;
+        }
+        return 1;
+    }
+    if (((Variable*)variable->value)->type.dataType == TYPE_BITS) return 0;
+
+    Variable* array = (Variable*)variable->value;
+    int length = getVariablesLength(array);
+    if (shape[level] == -1) shape[level] = length;
+    if (shape[level] != length) return 0;
+    for (int i = 0; i < length; i++) {
+        if (!measureMatrix(&array[i], level + 1, dimensions, type, shape)) return 0;
+    }
+    return 1;
+}
+
+void copyIntoMatrix (const Variable* variable, char** data, int element_size) {
+    if (!variable->type.array) {
+        memcpy(*data, variable->value, element_size);
+        *data += element_size;
+        return;
+    }
+    if (isMatrix(variable)) {
+        Matrix* matrix = (Matrix*)variable->value;
+        size_t size = matrix->element_size * matrix->element_count;
+        memcpy(*data, getMatrixData(matrix), size);
+        *data += size;
+        return;
+    }
+    Variable* array = (Variable*)variable->value;
+    int length = getVariablesLength(array);
+    for (int i = 0; i < length; i++) {
+        copyIntoMatrix(&array[i], data, element_size);
+    }
+}
+
+void packMatrix (Variable* variable) {
+    Matrix* matrix = buildMatrix(variable);
+    if (matrix == NULL) return;
+    destroyValue(variable);
+    variable->value = matrix;
+}
+
+void unpackMatrix (Variable* variable) {
+    Matrix* matrix = (Matrix*)variable->value;
+    long long int stride = getMatrixStrides(matrix)[0];
+    Variable* array = malloc(sizeof(Variable) * (matrix->length + 1));
+    for (int i = 0; i < matrix->length; i++) {
+        if (matrix->dimensions == 1) {
+            void* value = allocValue(matrix->element_size);
+            memcpy(value, getMatrixData(matrix) + i * matrix->element_size, matrix->element_size);
+            array[i] = createLiteral(matrix->element_type, value, 0, 0);
+        } else {
+            array[i] = createLiteral(matrix->element_type, sliceMatrix(matrix, i * stride, 1), 0, matrix->dimensions - 1);
+        }
+    }
+    array[matrix->length] = createNullTerminatedVariable();
+    freeValue(matrix);
+    variable->value = array;
+}
+
+Matrix* cloneMatrix (const Matrix* matrix) {
+    size_t size = getMatrixSize(matrix);
+    Matrix* clone = malloc(size);
+    memcpy(clone, matrix, size);
+    return clone;
+}
+
+Matrix* sliceMatrix (const Matrix* matrix, long long int offset, int skipped) {
+    Matrix* slice = createMatrix(matrix->element_type, matrix->dimensions - skipped, getMatrixShape(matrix) + skipped);
+    memcpy(getMatrixData(slice), getMatrixData(matrix) + offset * matrix->element_size, slice->element_size * slice->element_count);
+    return slice;
+}
+
+int getMatrixOffset (const Matrix* matrix, const Variable* indices, int count, long long int* offset) {
+    long long int* shape = getMatrixShape(matrix);
+    long long int* strides = getMatrixStrides(matrix);
+    *offset = 0;
+    for (int i = 0; i < count; i++) {
+        long long int index = getSignedNumber((Variable*)&indices[i]);
+        if (index < 0) {
+            if (-index >= shape[i]) return ERROR_ARRAY_OUT_OF_BOUNDS;
+            index += shape[i];
+        } else if (index >= shape[i]) {
+            return ERROR_ARRAY_OUT_OF_BOUNDS;
+        }
+        *offset += index * strides[i];
+    }
+    return 0;
+}
+
+int indexMatrix (Variable* var, const Variable* matrix_var, const Variable* indices, int count) {
+    Matrix* matrix = (Matrix*)matrix_var->value;
+    if (count > matrix->dimensions) return ERROR_TYPE_MISMATCH; // the indices past the last dimension would index a number
+
+    long long int offset;
+    int oRes = getMatrixOffset(matrix, indices, count, &offset);
+    if (oRes) return oRes;
+
+    destroyVariable(var);
+    if (count == matrix->dimensions) {
+        void* value = allocValue(matrix->element_size);
+        memcpy(value, getMatrixData(matrix) + offset * matrix->element_size, matrix->element_size);
+        *var = createLiteral(matrix->element_type, value, 0, 0);
+    } else {
+        *var = createLiteral(matrix->element_type, sliceMatrix(matrix, offset, count), 0, matrix->dimensions - count);
+    }
+    return 0;
+}
+
+char* matrixToString (const Matrix* matrix) {
+    size_t length = 0;
+    size_t capacity = 64;
+    char* str = malloc(sizeof(char) * capacity);
+    str[0] = '\0';
+    appendMatrixString(matrix, 0, 0, &str, &length, &capacity);
+    return str;
+}
+
+void appendMatrixString (const Matrix* matrix, int dimension, long long int offset, char** str, size_t* length, size_t* capacity) {
+    long long int count = getMatrixShape(matrix)[dimension];
+    long long int stride = getMatrixStrides(matrix)[dimension];
+    appendString(str, length, capacity, "[");
+    for (long long int i = 0; i < count; i++) {
+        if (dimension < matrix->dimensions - 1) {
+            appendMatrixString(matrix, dimension + 1, offset + i * stride, str, length, capacity);
+        } else {
+            Variable element = createLiteral(matrix->element_type, getMatrixData(matrix) + (offset + i) * matrix->element_size, 0, 0);
+            char* res = toString(&element);
+            appendString(str, length, capacity, res);
+            free(res);
+        }
+        if (i < count - 1) appendString(str, length, capacity, ", ");
+    }
+    appendString(str, length, capacity, "]");
+}
+
+void appendString (char** str, size_t* length, size_t* capacity, const char* text) {
+    size_t text_length = strlen(text);
+    if (*length + text_length + 1 > *capacity) {
+        while (*length + text_length + 1 > *capacity) *capacity *= 2;
+        *str = realloc(*str, sizeof(char) * *capacity);
+    }
+    memcpy(*str + *length, text, text_length + 1);
+    *length += text_length;
+}
+
+#endif
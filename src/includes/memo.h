@@ -0,0 +1,316 @@
+/**
+ * @author Sebastiaan Heins
+ * @file memo.h
+ * @brief The result caches of MEMO functions, a call with arguments that were seen before returns the cached result instead of running the function
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef MEMO_H
+#define MEMO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "token.h"
+#include "variable.h"
+#include "packedarray.h"
+
+#define MEMO_CACHE_SIZE 1024 // the most results a MEMO function keeps, must be a power of two
+#define MEMO_HASH_OFFSET 14695981039346656037ULL
+#define MEMO_HASH_PRIME 1099511628211ULL
+
+/**
+ * @brief A cached result and the arguments it belongs to
+*/
+typedef struct {
+    unsigned long long int hash;
+    Variable* args; // packed arrays are stored unpacked
+    int args_length;
+    Variable result;
+    int next; // the next entry in the same bucket, -1 at the end of the bucket
+    int newer, older; // the neighbours in the order the entries were used, -1 at the ends
+} MemoEntry;
+
+/**
+ * @brief The results of a MEMO function, the least recently used one is dropped when the cache is full
+*/
+typedef struct {
+    MemoEntry* entries;
+    int length;
+    int capacity;
+    int buckets[MEMO_CACHE_SIZE]; // the first entry of every bucket, -1 when it's empty
+    int newest, oldest;
+} MemoCache;
+
+/**
+ * @brief Create an empty result cache
+ * @return The cache (must be destroyed after use)
+*/
+MemoCache* createMemoCache ();
+
+/**
+ * @brief Destroy a result cache, freeing all memory
+ * @param cache The cache to destroy
+*/
+void destroyMemoCache (MemoCache* cache);
+
+/**
+ * @brief Look up the result of a call, marking it as the most recently used
+ * @param cache The cache of the function
+ * @param args The arguments of the call, packed arrays in them are unpacked
+ * @param args_length The amount of arguments
+ * @return The cached result, or NULL when the call isn't cached
+*/
+Variable* getMemoResult (MemoCache* cache, Variable* args, int args_length);
+
+/**
+ * @brief Cache the result of a call, dropping the least recently used result when the cache is full
+ * @param cache The cache of the function
+ * @param args The arguments of the call
+ * @param args_length The amount of arguments
+ * @param result The result of the call
+*/
+void setMemoResult (MemoCache* cache, const Variable* args, int args_length, const Variable* result);
+
+/**
+ * @brief Hash the arguments of a call (FNV-1a)
+ * @param args The arguments, without packed arrays
+ * @param args_length The amount of arguments
+ * @return The hash
+*/
+unsigned long long int hashArguments (const Variable* args, int args_length);
+
+/**
+ * @brief Add a value to a hash
+ * @param hash The hash so far
+ * @param value The value, without packed arrays
+ * @return The new hash
+*/
+unsigned long long int hashValue (unsigned long long int hash, const Variable* value);
+
+/**
+ * @brief Add bytes to a hash
+ * @param hash The hash so far
+ * @param bytes The bytes
+ * @param size The amount of bytes
+ * @return The new hash
+*/
+unsigned long long int hashBytes (unsigned long long int hash, const void* bytes, size_t size);
+
+/**
+ * @brief Get the size of the value of a type that isn't an array
+ * @param type The type
+ * @return The size in bytes, 0 for strings and types without a value
+*/
+size_t getScalarSize (DataType type);
+
+/**
+ * @brief Check if two values are the same, including their types
+ * @param left The left value, without packed arrays
+ * @param right The right value, without packed arrays
+ * @return Whether or not the values are the same
+*/
+int sameValue (const Variable* left, const Variable* right);
+
+/**
+ * @brief Take an entry out of the order the entries were used in
+ * @param cache The cache
+ * @param index The index of the entry
+*/
+void unlinkMemoEntry (MemoCache* cache, int index);
+
+/**
+ * @brief Make an entry the most recently used one
+ * @param cache The cache
+ * @param index The index of the entry, it must be unlinked
+*/
+void linkMemoEntry (MemoCache* cache, int index);
+
+
+MemoCache* createMemoCache () {
+    MemoCache* cache = malloc(sizeof(MemoCache));
+    cache->entries = NULL;
+    cache->length = 0;
+    cache->capacity = 0;
+    for (int i = 0; i < MEMO_CACHE_SIZE; i++) {
+        cache->buckets[i] = -1;
+    }
+    cache->newest = -1;
+    cache->oldest = -1;
+    return cache;
+}
+
+void destroyMemoCache (MemoCache* cache) {
+    for (int i = 0; i < cache->length; i++) {
+        for (int j = 0; j < cache->entries[i].args_length; j++) {
+            destroyVariable(&cache->entries[i].args[j]);
+        }
+        free(cache->entries[i].args);
+        destroyVariable(&cache->entries[i].result);
+    }
+    free(cache->entries);
+    free(cache);
+}
+
+Variable* getMemoResult (MemoCache* cache, Variable* args, int args_length) {
+    for (int i = 0; i < args_length; i++) {
+        unpackNestedArrays(&args[i]);
+    }
+    unsigned long long int hash = hashArguments(args, args_length);
+    for (int index = cache->buckets[hash & (MEMO_CACHE_SIZE - 1)]; index != -1; index = cache->entries[index].next) {
+        MemoEntry* entry = &cache->entries[index];
+        if (entry->hash != hash || entry->args_length != args_length) continue;
+        int same = 1;
+        for (int i = 0; i < args_length && same; i++) {
+            same = sameValue(&entry->args[i], &args[i]);
+        }
+        if (!same) continue;
+
+        unlinkMemoEntry(cache, index);
+        linkMemoEntry(cache, index);
+        return &entry->result;
+    }
+    return NULL;
+}
+
+void setMemoResult (MemoCache* cache, const Variable* args, int args_length, const Variable* result) {
+    int index;
+    if (cache->length < MEMO_CACHE_SIZE) {
+        if (cache->length == cache->capacity) {
+            cache->capacity = cache->capacity == 0 ? 16 : cache->capacity * 2;
+            cache->entries = realloc(cache->entries, sizeof(MemoEntry) * cache->capacity);
+        }
+        index = cache->length++;
+    } else {
+        // the cache is full, the least recently used entry makes room
+        index = cache->oldest;
+        MemoEntry* oldest = &cache->entries[index];
+        int* link = &cache->buckets[oldest->hash & (MEMO_CACHE_SIZE - 1)];
+        while (*link != index) link = &cache->entries[*link].next;
+        *link = oldest->next;
+        unlinkMemoEntry(cache, index);
+
+        for (int i = 0; i < oldest->args_length; i++) {
+            destroyVariable(&oldest->args[i]);
+        }
+        free(oldest->args);
+        destroyVariable(&oldest->result);
+    }
+
+    MemoEntry* entry = &cache->entries[index];
+    entry->args = malloc(sizeof(Variable) * (args_length + 1)); // one more, so a call without arguments doesn't allocate 0 bytes
+    for (int i = 0; i < args_length; i++) {
+        entry->args[i] = cloneVariable(&args[i]);
+        unpackNestedArrays(&entry->args[i]);
+    }
+    entry->args_length = args_length;
+    entry->hash = hashArguments(entry->args, args_length);
+    entry->result = cloneVariable(result);
+    entry->result.literal = 0; // the value is owned by the cache
+
+    int bucket = entry->hash & (MEMO_CACHE_SIZE - 1);
+    entry->next = cache->buckets[bucket];
+    cache->buckets[bucket] = index;
+    linkMemoEntry(cache, index);
+}
+
+unsigned long long int hashArguments (const Variable* args, int args_length) {
+    unsigned long long int hash = MEMO_HASH_OFFSET;
+    for (int i = 0; i < args_length; i++) {
+        hash = hashValue(hash, &args[i]);
+    }
+    return hash;
+}
+
+unsigned long long int hashValue (unsigned long long int hash, const Variable* value) {
+    hash = hashBytes(hash, &value->type, sizeof(Type));
+    if (value->value == NULL) return hash;
+    if (value->type.array) {
+        const Variable* array = (const Variable*)value->value;
+        int length = getVariablesLength(array);
+        hash = hashBytes(hash, &length, sizeof(int));
+        for (int i = 0; i < length; i++) {
+            hash = hashValue(hash, &array[i]);
+        }
+        return hash;
+    }
+    if (value->type.dataType == TYPE_STRING) return hashBytes(hash, value->value, strlen((char*)value->value));
+    return hashBytes(hash, value->value, getScalarSize(value->type.dataType));
+}
+
+unsigned long long int hashBytes (unsigned long long int hash, const void* bytes, size_t size) {
+    const unsigned char* data = (const unsigned char*)bytes;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= MEMO_HASH_PRIME;
+    }
+    return hash;
+}
+
+size_t getScalarSize (DataType type) {
+    switch (type) {
+        case TYPE_CHAR:
+            return sizeof(char);
+        case TYPE_BOOL:
+        case TYPE_INT:
+            return sizeof(int);
+        case TYPE_BYTE:
+            return sizeof(signed char);
+        case TYPE_SHORT:
+            return sizeof(short);
+        case TYPE_LONG:
+            return sizeof(long long int);
+        case TYPE_UBYTE:
+            return sizeof(unsigned char);
+        case TYPE_USHORT:
+            return sizeof(unsigned short);
+        case TYPE_UINT:
+            return sizeof(unsigned int);
+        case TYPE_ULONG:
+            return sizeof(unsigned long long int);
+        case TYPE_FLOAT:
+            return sizeof(float);
+        case TYPE_DOUBLE:
+            return sizeof(double);
+        default:
+            return 0;
+    }
+}
+
+int sameValue (const Variable* left, const Variable* right) {
+    if (!compareType(left->type, right->type)) return 0;
+    if (left->value == NULL || right->value == NULL) return left->value == right->value;
+    if (left->type.array) {
+        const Variable* left_array = (const Variable*)left->value;
+        const Variable* right_array = (const Variable*)right->value;
+        int length = getVariablesLength(left_array);
+        if (length != getVariablesLength(right_array)) return 0;
+        for (int i = 0; i < length; i++) {
+            if (!sameValue(&left_array[i], &right_array[i])) return 0;
+        }
+        return 1;
+    }
+    if (left->type.dataType == TYPE_STRING) return !strcmp((char*)left->value, (char*)right->value);
+    return !memcmp(left->value, right->value, getScalarSize(left->type.dataType));
+}
+
+void unlinkMemoEntry (MemoCache* cache, int index) {
+    MemoEntry* entry = &cache->entries[index];
+    if (entry->newer != -1) cache->entries[entry->newer].older = entry->older;
+    else cache->newest = entry->older;
+    if (entry->older != -1) cache->entries[entry->older].newer = entry->newer;
+    else cache->oldest = entry->newer;
+}
+
+void linkMemoEntry (MemoCache* cache, int index) {
+    MemoEntry* entry = &cache->entries[index];
+    entry->newer = -1;
+    entry->older = cache->newest;
+    if (cache->newest != -1) cache->entries[cache->newest].newer = index;
+    cache->newest = index;
+    if (cache->oldest == -1) cache->oldest = index;
+}
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @author Sebastiaan Heins
+ * @file module.h
+ * @brief Finds and reads the files loaded by IMPORT
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef MODULE_H
+#define MODULE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifndef _WIN32
+#include <limits.h>
+#endif
+
+#include "log.h"
+#include "ast.h"
+
+typedef enum {
+    MODULE_QUEUED,
+    MODULE_PARSING,
+    MODULE_PARSED, // parsed ahead of time, waiting for the IMPORT that runs it
+    MODULE_IMPORTED, // the AST has been moved into the process
+    MODULE_SKIPPED // the file couldn't be read, the IMPORT reports it
+} ModuleState;
+
+/**
+ * @brief A module that is parsed before the program runs, a list of them is terminated by a NULL path
+*/
+typedef struct {
+    char* path;
+    char* full_code;
+    AST ast;
+    ModuleState state;
+    int error_code; // the error the lexer or parser stopped at, reported when the module is imported
+    int error_position;
+} PreloadedModule;
+
+/**
+ * @brief Resolve the path of a module, relative paths are relative to the directory of the file importing it
+ * @param importer The path of the file that imports the module
+ * @param path The path given to IMPORT
+ * @return The absolute path of the module (don't forget to free it), or NULL when the file doesn't exist
+*/
+char* resolveModulePath (const char* importer, const char* path);
+
+/**
+ * @brief Read the contents of a module
+ * @param path The path of the module
+ * @param contents Filled with the contents of the file (don't forget to free it)
+ * @return The error code
+*/
+int readModuleFile (const char* path, char** contents);
+
+/**
+ * @brief Resolve a path to an absolute path without any . or .. parts
+ * @param path The path to resolve
+ * @return The absolute path (don't forget to free it), or NULL when the file doesn't exist
+*/
+char* getAbsolutePath (const char* path);
+
+
+
+char* resolveModulePath (const char* importer, const char* path) {
+    int absolute = path[0] == '/';
+    #ifdef _WIN32
+    absolute = absolute || path[0] == '\\' || (path[0] != '\0' && path[1] == ':');
+    #endif
+    if (absolute) return getAbsolutePath(path);
+
+    // take the directory of the importer, up to and including the last separator
+    int dir_length = 0;
+    for (int i = 0; importer[i] != '\0'; i++) {
+        if (importer[i] == '/' || importer[i] == '\\') dir_length = i + 1;
+    }
+    char* joined = malloc(sizeof(char) * (dir_length + strlen(path) + 1));
+    strncpy(joined, importer, dir_length);
+    strcpy(joined + dir_length, path);
+
+    char* resolved = getAbsolutePath(joined);
+    free(joined);
+    return resolved;
+}
+
+int readModuleFile (const char* path, char** contents) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return errno == EACCES ? ERROR_PERMISSION_DENIED : ERROR_FILE_NOT_FOUND;
+    }
+    fseek(file, 0, SEEK_END);
+    long int size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    *contents = malloc(sizeof(char) * (size + 1));
+    size = fread(*contents, sizeof(char), size, file);
+    (*contents)[size] = '\0';
+    fclose(file);
+    return 0;
+}
+
+char* getAbsolutePath (const char* path) {
+    #ifdef _WIN32
+    char* resolved = _fullpath(NULL, path, 0);
+    if (resolved != NULL) {
+        FILE* file = fopen(resolved, "rb");
+        if (file == NULL) {
+            free(resolved);
+            return NULL;
+        }
+        fclose(file);
+    }
+    return resolved;
+    #else
+    return realpath(path, NULL);
+    #endif
+}
+
+#endif
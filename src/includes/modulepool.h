@@ -0,0 +1,270 @@
+/**
+ * @author Sebastiaan Heins
+ * @file modulepool.h
+ * @brief Lexes and parses the modules a program imports on a pool of worker threads, before the program runs
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef MODULE_POOL_H
+#define MODULE_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "ast.h"
+#include "astcache.h"
+#include "module.h"
+#include "log.h"
+#include "process.h"
+
+/**
+ * @brief The shared state of the workers, the list of modules grows while the workers find more imports
+*/
+typedef struct {
+    PreloadedModule* modules;
+    int module_count;
+    int next_module;
+    int working; // the amount of workers parsing a module right now
+    const char* cache_dir;
+    const char* version;
+    #ifndef _WIN32
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    #endif
+} ModulePool;
+
+/**
+ * @brief Parse all the modules a process imports with a plain string, following the imports of those modules too
+ * @param process The process to load the modules for, the parsed modules are stored in it's preloaded list
+ * @param threads The amount of worker threads, 0 to use one per core
+ * @note Errors in the modules are only reported when the IMPORT runs, like they would be without preloading
+*/
+void preloadModules (Process* process, int threads);
+
+/**
+ * @brief Take modules from the pool and parse them until all of them are done
+ * @param pool The pool to work on
+ * @return NULL
+*/
+void* runModuleWorker (void* pool);
+
+/**
+ * @brief Read and parse a module, catching the errors of the lexer and parser
+ * @param module The module to parse, it's path must be set
+ * @param cache_dir The directory of the parsed program cache, NULL when it's disabled
+ * @param version The version of the interpreter
+*/
+void parseModule (PreloadedModule* module, const char* cache_dir, const char* version);
+
+/**
+ * @brief Add a module to the pool, unless it's already in there
+ * @param pool The pool to add the module to
+ * @param path The absolute path of the module, the pool takes ownership of it
+ * @param state The state of the module
+*/
+void addPoolModule (ModulePool* pool, char* path, ModuleState state);
+
+/**
+ * @brief Find the modules imported with a plain string, these can be loaded before the program runs
+ * @param node The node to search
+ * @param importer The path of the file the node belongs to
+ * @param paths The null terminated list of absolute paths to add to
+*/
+void findStaticImports (const Node* node, const char* importer, char*** paths);
+
+/**
+ * @brief Get the amount of cores of the machine
+ * @return The amount of cores, at least 1
+*/
+int getCoreCount ();
+
+
+void preloadModules (Process* process, int threads) {
+    ModulePool pool;
+    pool.modules = malloc(sizeof(PreloadedModule));
+    pool.modules[0].path = NULL;
+    pool.module_count = 0;
+    pool.working = 0;
+    pool.cache_dir = process->cache_dir;
+    pool.version = process->version;
+
+    // the loaded files are already done, the modules they import are the first work
+    char** imports = malloc(sizeof(char*));
+    imports[0] = NULL;
+    for (int i = 0; i < getASTsLength(process->code); i++) {
+        char* path = getAbsolutePath(process->code[i].filename);
+        if (path != NULL) addPoolModule(&pool, path, MODULE_IMPORTED);
+        findStaticImports(&process->code[i].root, process->code[i].filename, &imports);
+    }
+    pool.next_module = pool.module_count;
+    for (int i = 0; imports[i] != NULL; i++) {
+        addPoolModule(&pool, imports[i], MODULE_QUEUED);
+    }
+    free(imports);
+
+    if (pool.next_module < pool.module_count) {
+        if (threads <= 0) threads = getCoreCount();
+        #ifdef _WIN32
+        runModuleWorker(&pool); // parse on this thread
+        #else
+        pthread_mutex_init(&pool.lock, NULL);
+        pthread_cond_init(&pool.wake, NULL);
+        pthread_t* workers = malloc(sizeof(pthread_t) * threads);
+        int started = 0;
+        for (int i = 1; i < threads; i++) {
+            if (pthread_create(&workers[started], NULL, runModuleWorker, &pool) == 0) started++;
+        }
+        runModuleWorker(&pool); // this thread works along
+        for (int i = 0; i < started; i++) {
+            pthread_join(workers[i], NULL);
+        }
+        free(workers);
+        pthread_cond_destroy(&pool.wake);
+        pthread_mutex_destroy(&pool.lock);
+        #endif
+    }
+
+    // hand the parsed modules to the process, the loaded files were only there to skip them
+    int length = 0;
+    while (process->preloaded[length].path != NULL) length++;
+    for (int i = 0; i < pool.module_count; i++) {
+        if (pool.modules[i].state == MODULE_IMPORTED) {
+            free(pool.modules[i].path);
+            continue;
+        }
+        process->preloaded = realloc(process->preloaded, sizeof(PreloadedModule) * (length + 2));
+        process->preloaded[length++] = pool.modules[i];
+        process->preloaded[length].path = NULL;
+    }
+    free(pool.modules);
+}
+
+void* runModuleWorker (void* data) {
+    ModulePool* pool = data;
+    #ifndef _WIN32
+    pthread_mutex_lock(&pool->lock);
+    #endif
+    while (1) {
+        #ifndef _WIN32
+        // wait for work, a module being parsed may still import more
+        while (pool->next_module == pool->module_count && pool->working > 0) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        #endif
+        if (pool->next_module == pool->module_count) break;
+
+        int index = pool->next_module++;
+        PreloadedModule module = pool->modules[index]; // the list may move while this module is parsed
+        pool->modules[index].state = MODULE_PARSING;
+        pool->working++;
+        #ifndef _WIN32
+        pthread_mutex_unlock(&pool->lock);
+        #endif
+
+        parseModule(&module, pool->cache_dir, pool->version);
+        char** imports = malloc(sizeof(char*));
+        imports[0] = NULL;
+        if (module.state == MODULE_PARSED && module.error_code == 0) {
+            findStaticImports(&module.ast.root, module.path, &imports);
+        }
+
+        #ifndef _WIN32
+        pthread_mutex_lock(&pool->lock);
+        #endif
+        pool->modules[index] = module;
+        for (int i = 0; imports[i] != NULL; i++) {
+            addPoolModule(pool, imports[i], MODULE_QUEUED);
+        }
+        free(imports);
+        pool->working--;
+        #ifndef _WIN32
+        pthread_cond_broadcast(&pool->wake);
+        #endif
+    }
+    #ifndef _WIN32
+    pthread_mutex_unlock(&pool->lock);
+    #endif
+    return NULL;
+}
+
+void parseModule (PreloadedModule* module, const char* cache_dir, const char* version) {
+    if (readModuleFile(module->path, &module->full_code)) {
+        module->full_code = NULL;
+        module->state = MODULE_SKIPPED; // the IMPORT tries again and reports why it can't be read
+        return;
+    }
+    module->state = MODULE_PARSED;
+
+    ErrorTrap trap;
+    error_trap = &trap;
+    if (setjmp(trap.jump)) {
+        // the partly built AST is lost, the error quits the program when the module is imported
+        error_trap = NULL;
+        module->error_code = trap.code;
+        module->error_position = trap.position;
+        return;
+    }
+    module->ast = loadCachedAST(module->path, module->full_code, cache_dir, version);
+    error_trap = NULL;
+}
+
+void addPoolModule (ModulePool* pool, char* path, ModuleState state) {
+    for (int i = 0; i < pool->module_count; i++) {
+        if (!strcmp(pool->modules[i].path, path)) {
+            free(path);
+            return;
+        }
+    }
+    pool->modules = realloc(pool->modules, sizeof(PreloadedModule) * (pool->module_count + 2));
+    PreloadedModule* module = &pool->modules[pool->module_count++];
+    module->path = path;
+    module->full_code = NULL;
+    module->ast = createNullTerminatedAST();
+    module->state = state;
+    module->error_code = 0;
+    module->error_position = 0;
+    pool->modules[pool->module_count].path = NULL;
+}
+
+void findStaticImports (const Node* node, const char* importer, char*** paths) {
+    if (node->type == NODE_IMPORT) {
+        const Node* path = &node->body[0];
+        while (path->type == NODE_EXPRESSION && getNodeBodyLength(path->body) == 1) {
+            path = &path->body[0];
+        }
+        Variable value = createNullTerminatedVariable();
+        if (path->type == NODE_LITERAL && !parseLiteralText(&value, path->text) && value.type.dataType == TYPE_STRING && value.type.array == 0) {
+            char* resolved = resolveModulePath(importer, (char*)value.value);
+            if (resolved != NULL) {
+                int length = 0;
+                while ((*paths)[length] != NULL) length++;
+                *paths = realloc(*paths, sizeof(char*) * (length + 2));
+                (*paths)[length] = resolved;
+                (*paths)[length + 1] = NULL;
+            }
+        }
+        destroyVariable(&value);
+        return;
+    }
+    for (int i = 0; i < getNodeBodyLength(node->body); i++) {
+        findStaticImports(&node->body[i], importer, paths);
+    }
+}
+
+int getCoreCount () {
+    #ifdef _WIN32
+    return 1;
+    #else
+    long int cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores < 1 ? 1 : (int)cores;
+    #endif
+}
+
+#endif
@@ -11,6 +11,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "token.h"
 
 
@@ -37,6 +38,10 @@ typedef enum {
     NODE_ARRAY_EXPRESSION,
     NODE_OPERATOR_CAST,
     NODE_BLOCK_EXPRESSION,
+    NODE_UNPARSED_BLOCK, // the body of a function, only holding it's token range until the function is first called
+    NODE_IMPORT,
+    NODE_INLINE_CALL, // a call to a small function that was replaced with the expression the function returns
+    NODE_INLINE_ARGUMENT, // an argument in the expression of an inlined call
 
     NODE_WHEN,
     NODE_WHILE,
@@ -46,6 +51,7 @@ typedef enum {
     NODE_THEN,
     NODE_FOR,
     NODE_IF,
+    NODE_PFOR, // a FOR that runs it's iterations on several threads
     
     NODE_END = -1
 } NodeType;
@@ -60,7 +66,12 @@ struct Node {
     NodeType type;
     Node* body;
     char* text;
-    int validated;
+    int constant; // index into the constant pool of the AST when the optimizer folded this node, -1 otherwise
+    int kernel; // index of the typed kernel the optimizer picked for this operator, -1 when the operand types aren't known
+    int chain; // in a call chain, the index of the first WHEN, WHILE or FOR from this node on, -1 when there is none
+    int invariant; // index into the invariant slots of the AST when the optimizer hoisted this expression out of a loop, on a WHILE or FOR the first slot of the loop, -1 otherwise
+    int bounds; // on an index (a#i), the invariant slot holding whether the index stays in bounds for the whole loop, -1 otherwise
+    int argument; // on an inlined argument, the index of the argument, -1 otherwise
 };
 
 /**
@@ -76,6 +87,14 @@ Node createNullTerminatedNode();
 */
 void addToBody (Node** body, Node node);
 
+/**
+ * @brief Remove a range of nodes from the body of a node, destroying the removed nodes
+ * @param body The body to remove the nodes from
+ * @param start The index of the first node to remove
+ * @param amount The amount of nodes to remove
+*/
+void removeFromBody (Node** body, const int start, const int amount);
+
 /**
  * @brief Get the full line starting at a token
  * @param tokens The list of tokens
@@ -107,6 +126,13 @@ int getBlockReverse (Token* tokens, const int start);
 */
 int getNodeBodyLength (const Node* nodes);
 
+/**
+ * @brief Copy a node and all of it's children
+ * @param node The node to copy
+ * @return The copy (must be destroyed after use)
+*/
+Node cloneNode (const Node* node);
+
 /**
  * @brief Destroy a node and all of it's children, freeing the memory
  * @param node The node to destroy
@@ -121,7 +147,12 @@ Node createNullTerminatedNode () {
     node.type = NODE_END;
     node.body = NULL;
     node.text = NULL;
-    node.validated = 0;
+    node.constant = -1;
+    node.kernel = -1;
+    node.chain = -1;
+    node.invariant = -1;
+    node.bounds = -1;
+    node.argument = -1;
     return node;
 }
 
@@ -134,9 +165,20 @@ void addToBody (Node** body, const Node node) {
     (*body)[length + 1] = createNullTerminatedNode();
 }
 
+void removeFromBody (Node** body, const int start, const int amount) {
+    int length = getNodeBodyLength(*body);
+    for (int i = start; i < start + amount; i++) {
+        destroyNode(&(*body)[i]);
+    }
+    // move the remaining nodes (and the null terminator) to the front
+    for (int i = start + amount; i <= length; i++) {
+        (*body)[i - amount] = (*body)[i];
+    }
+}
+
 int getFullLine (Token* tokens, const int start) {
-    int length = getTokenAmount(tokens);
-    for (int i = start; i < length; i++) {
+    int i = start;
+    for (; tokens[i].type != TOKEN_END; i++) {
         if (tokens[i].type == TOKEN_PARENTHESIS) {
             i = getBlock(tokens, i);
         }
@@ -144,35 +186,21 @@ int getFullLine (Token* tokens, const int start) {
             return i;
         }
     }
-    return length-1;
+    return i-1;
 }
 
 int getBlock (Token* tokens, const int start) {
-    if (tokens[start].type != TOKEN_PARENTHESIS) return start;
-    int length = getTokenAmount(tokens);
-    int targetCarry = tokens[start].carry;
-    for (int i = start+1; i < length; i++) {
-        if (tokens[i].type == TOKEN_PARENTHESIS && tokens[i].carry == targetCarry) {
-            return i;
-        }
-    }
-    return start;
+    if (tokens[start].type != TOKEN_PARENTHESIS || tokens[start].block < start) return start;
+    return tokens[start].block;
 }
 int getBlockReverse (Token* tokens, const int start) {
-    if (tokens[start].type != TOKEN_PARENTHESIS) return start;
-    int length = getTokenAmount(tokens);
-    int targetCarry = tokens[start].carry;
-    for (int i = start-1; i >= 0; i--) {
-        if (tokens[i].type == TOKEN_PARENTHESIS && tokens[i].carry == targetCarry) {
-            return i;
-        }
-    }
-    return start;
+    if (tokens[start].type != TOKEN_PARENTHESIS || tokens[start].block > start) return start;
+    return tokens[start].block;
 }
 
 int getExpression (Token* tokens, const int start) {
-    int length = getTokenAmount(tokens);
-    for (int i = start+1; i < length; i++) {
+    if (tokens[start].type == TOKEN_END) return -1;
+    for (int i = start+1; tokens[i].type != TOKEN_END; i++) {
         if (tokens[i].type == TOKEN_SEPARATOR || (tokens[i].type == TOKEN_PARENTHESIS && !(tokens[i].carry & BRACKET_ROUND)) || tokens[i].type == TOKEN_MASTER_KEYWORD || tokens[i].type == TOKEN_EXT || tokens[i].type == TOKEN_NULL) {
             return i-1;
         }
@@ -181,8 +209,8 @@ int getExpression (Token* tokens, const int start) {
 }
 
 int getSetExpression (Token* tokens, const int start) {
-    int length = getTokenAmount(tokens);
-    for (int i = start+1; i < length; i++) {
+    if (tokens[start].type == TOKEN_END) return -1;
+    for (int i = start+1; tokens[i].type != TOKEN_END; i++) {
         if (tokens[i].type == TOKEN_SEPARATOR || (tokens[i].type == TOKEN_PARENTHESIS && !(tokens[i].carry & BRACKET_ROUND)) || tokens[i].type == TOKEN_MASTER_KEYWORD || tokens[i].type == TOKEN_EXT || tokens[i].type == TOKEN_NULL || (tokens[i].type == TOKEN_OPERATOR && tokens[i].carry == OPERATOR_COMMA) || (tokens[i].type == TOKEN_OPERATOR && isAssignmentOperator(tokens[i].carry))) {
             return i-1;
         }
@@ -199,6 +227,21 @@ int getNodeBodyLength (const Node* nodes) {
     return i;
 }
 
+Node cloneNode (const Node* node) {
+    Node clone = *node;
+    clone.body = NULL;
+    clone.text = NULL;
+    if (node->text != NULL) {
+        clone.text = malloc(sizeof(char) * (strlen(node->text) + 1));
+        strcpy(clone.text, node->text);
+    }
+    int length = getNodeBodyLength(node->body);
+    for (int i = 0; i < length; i++) {
+        addToBody(&clone.body, cloneNode(&node->body[i]));
+    }
+    return clone;
+}
+
 void destroyNode (Node* node) {
     if (node->type != NODE_END) {
         for (int i = 0; i < getNodeBodyLength(node->body); i++) {
@@ -171,6 +171,13 @@ int or (Variable* var, Variable* left, Variable* right);
 */
 int and (Variable* var, Variable* left, Variable* right);
 
+/**
+ * @brief Get the truth value of a variable, the way the logical operators read it
+ * @param variable The variable
+ * @return 1 if the variable is true, 0 if not
+*/
+int getTruthValue (Variable* variable);
+
 /**
  * @brief OR two variables || (logical)
  * @param var The return variable
@@ -268,6 +275,23 @@ int negative (Variable* var, Variable* right);
 */
 int hash (Variable* var, Variable* left, Variable* right);
 
+/**
+ * @brief Hash by refrence, pointing to the element inside the array instead of copying it #
+ * @param var The pointer to set to the element
+ * @param arr The array to index
+ * @param right The index
+*/
+int hash_refrence (Variable** var, Variable* arr, Variable* right);
+
+/**
+ * @brief Resolve an index into a null terminated variable list, negative indices count from the end
+ * @param list The list to index
+ * @param index The index
+ * @return The resolved index, or -1 when the index is out of bounds
+ * @note Positive indices only walk up to the index instead of measuring the whole list
+*/
+int getArrayIndex (const Variable* list, long long int index);
+
 /**
  * @brief get the biggest of two variables
  * @param var The return variable
@@ -292,6 +316,90 @@ int min_op (Variable* var, Variable* left, Variable* right);
 */
 int compareVariables (Variable* left, Variable* right);
 
+//    TYPED KERNELS
+
+/**
+ * @brief A kernel applies an operator to two operands of a known type, without going through the generic type dispatch
+*/
+typedef int (*ArithmeticKernel) (Variable* var, Variable* left, Variable* right);
+
+// the operand classes that have kernels, INT includes UINT and LONG includes ULONG since they are read the same way
+typedef enum {
+    KERNEL_CLASS_INT,
+    KERNEL_CLASS_LONG,
+    KERNEL_CLASS_DOUBLE,
+    KERNEL_CLASS_COUNT,
+    KERNEL_CLASS_NONE = -1
+} KernelClass;
+
+// the operators that have kernels
+typedef enum {
+    KERNEL_ADD,
+    KERNEL_SUBTRACT,
+    KERNEL_MULTIPLY,
+    KERNEL_EQUAL,
+    KERNEL_NOT_EQUAL,
+    KERNEL_LESS,
+    KERNEL_GREATER,
+    KERNEL_LESS_EQUAL,
+    KERNEL_GREATER_EQUAL,
+    KERNEL_OPERATION_COUNT,
+    KERNEL_OPERATION_NONE = -1
+} KernelOperation;
+
+/**
+ * @brief Get the kernel class of a type
+ * @param type The type
+ * @return The kernel class, or KERNEL_CLASS_NONE if the type has no kernels
+*/
+KernelClass getKernelClass (Type type);
+
+/**
+ * @brief Get the kernel index of an operator applied to two types, the index points into the arithmetic_kernels table
+ * @param operator The operator
+ * @param left The type of the left operand
+ * @param right The type of the right operand
+ * @return The index of the kernel, or -1 if there is no kernel for these types
+*/
+int getArithmeticKernel (OperatorType operator, Type left, Type right);
+
+/**
+ * @brief Get the type a kernel returns
+ * @param kernel The index of the kernel
+ * @return The type of the result
+*/
+Type getArithmeticKernelResult (int kernel);
+
+/**
+ * @brief Apply a kernel that was picked ahead of time, when the operands don't match it the generic operator is used
+ * @param var The return variable
+ * @param left The left variable
+ * @param right The right variable
+ * @param operator The operator to apply
+ * @param kernel The index of the kernel
+ * @return The error code
+*/
+int cachedBinaryOperation (Variable* var, Variable* left, Variable* right, OperatorType operator, int kernel);
+
+/**
+ * @brief Apply a binary operator to two variables
+ * @param var The return variable
+ * @param left The left variable
+ * @param right The right variable
+ * @param operator The operator to apply
+ * @return The error code
+*/
+int binaryOperation (Variable* var, Variable* left, Variable* right, OperatorType operator);
+
+/**
+ * @brief Apply a unary operator to a variable
+ * @param var The return variable
+ * @param right The right variable
+ * @param operator The operator to apply
+ * @return The error code
+*/
+int unaryOperation (Variable* var, Variable* right, OperatorType operator);
+
 int add (Variable* var, Variable* left, Variable* right) {
     if (!checkIfAddable(left->type.dataType) && !checkIfAddable(right->type.dataType) && !(left->type.array || right->type.array)) {
         return ERROR_CANT_USE_TYPE_IN_ADDITION;
@@ -306,6 +414,8 @@ int add (Variable* var, Variable* left, Variable* right) {
                 int cRes = castValue(right, left->type);
                 if (cRes) return cRes;
             }
+            unpackArray(left);
+            unpackArray(right);
             int length = getVariablesLength((Variable*)left->value) + getVariablesLength((Variable*)right->value);
 
             Variable* value = malloc(sizeof(Variable) *( length + 1));
@@ -317,13 +427,13 @@ int add (Variable* var, Variable* left, Variable* right) {
             };
             value[length] = createNullTerminatedVariable();
 
-            *var = createVariable("-lit", left->type.dataType, value, 0, left->type.array);
+            *var = createLiteral(left->type.dataType, value, 0, left->type.array);
             return 0;
         }
         // add the two lengths together
-        long long int* val = malloc(sizeof(long long int));
+        long long int* val = allocValue(sizeof(long long int));
         *val = getSignedNumber(left) + getSignedNumber(right);
-        *var = createVariable("-lit", TYPE_LONG, val, 1, 0);
+        *var = createLiteral(TYPE_LONG, val, 1, 0);
         return 0;
     }
 
@@ -333,26 +443,26 @@ int add (Variable* var, Variable* left, Variable* right) {
         if (left_value == NULL || right_value == NULL) {
             return ERROR_CANT_CONVERT_TO_STRING;
         }
-        char* value = malloc(strlen(left_value) + strlen(right_value) + 1);
+        char* value = allocValue(strlen(left_value) + strlen(right_value) + 1);
         sprintf(value, "%s%s", left_value, right_value);
         free(left_value);
         free(right_value);
-        *var = createVariable("-lit", TYPE_STRING, value, 1, 0);
+        *var = createLiteral(TYPE_STRING, value, 1, 0);
     }
     else if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value + right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
 
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = left_value + right_value;
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
@@ -365,6 +475,7 @@ int subtract (Variable* var, Variable* left, Variable* right) {
         // cast into an int
         int cRes = castValue(right, (Type){TYPE_INT, 0});
         if (cRes) return cRes;
+        unpackArray(left);
 
         int length = getVariablesLength((Variable*)left->value);
 
@@ -378,24 +489,24 @@ int subtract (Variable* var, Variable* left, Variable* right) {
         }
         value[length - *((int*)right->value)] = createNullTerminatedVariable();
 
-        *var = createVariable("-lit", left->type.dataType, value, 0, left->type.array);
+        *var = createLiteral(left->type.dataType, value, 0, left->type.array);
         return 0;
     }
 
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value - right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = left_value - right_value;
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
@@ -406,17 +517,17 @@ int multiply (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value * right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = left_value * right_value;
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
@@ -428,18 +539,18 @@ int pow_op (Variable* var, Variable* left, Variable* right) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
 
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
 
         *value = pow(left_value, right_value);
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = pow(left_value, right_value);
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
@@ -451,18 +562,18 @@ int divide (Variable* var, Variable* left, Variable* right) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
         if (right_value == 0) return ERROR_MATH_DOMAIN_ERROR;
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value / right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         if (right_value == 0) return ERROR_MATH_DOMAIN_ERROR;
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = left_value / right_value;
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
@@ -475,10 +586,10 @@ int root (Variable* var, Variable* left, Variable* right) {
     double right_value = getFloatNumber(right);
     if (right_value < 0) return ERROR_MATH_DOMAIN_ERROR;
     
-    double* value = malloc(sizeof(double));
+    double* value = allocValue(sizeof(double));
 
     *value = pow(right_value, 1.0 / left_value);
-    *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+    *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     return 0;
 }
 
@@ -489,9 +600,9 @@ int sqroot (Variable* var, Variable* right) {
     double right_value = getFloatNumber(right);
     if (right_value < 0) return ERROR_MATH_DOMAIN_ERROR;
     
-    double* value = malloc(sizeof(double));
+    double* value = allocValue(sizeof(double));
     *value = sqrt(right_value);
-    *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+    *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     return 0;
 
 }
@@ -501,9 +612,10 @@ int modulo (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
-        *value = left_value % right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        if (right_value == 0) return ERROR_MATH_DOMAIN_ERROR;
+        long long int* value = allocValue(sizeof(long long int));
+        *value = right_value == -1 ? 0 : left_value % right_value; // the smallest LONG % -1 overflows like it's division does
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         return ERROR_CANT_USE_TYPE_IN_MODULO;
     }
@@ -516,9 +628,9 @@ int xor (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value ^ right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         return ERROR_CANT_USE_TYPE_IN_BITWISE_EXPRESSION;
     }
@@ -531,9 +643,9 @@ int or (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value | right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         return ERROR_CANT_USE_TYPE_IN_BITWISE_EXPRESSION;
     }
@@ -546,9 +658,9 @@ int and (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value & right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         return ERROR_CANT_USE_TYPE_IN_BITWISE_EXPRESSION;
     }
@@ -561,9 +673,9 @@ int bitshift_left (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value << right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         return ERROR_CANT_USE_TYPE_IN_BITWISE_EXPRESSION;
     }
@@ -576,9 +688,9 @@ int bitshift_right (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value >> right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         return ERROR_CANT_USE_TYPE_IN_BITWISE_EXPRESSION;
     }
@@ -589,13 +701,13 @@ int bitshift_right (Variable* var, Variable* left, Variable* right) {
 int not (Variable* var, Variable* right) {
     destroyVariable(var);
 
-    int* value = malloc(sizeof(int));
+    int* value = allocValue(sizeof(int));
     double right_value = getSignedNumber(right);
     if (checkIfFloating(right->type.dataType)) {
         right_value = getFloatNumber(right);
     }
     *value = !right_value;
-    *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+    *var = createLiteral(TYPE_BOOL, value, 1, 0);
     return 0;
 }
 
@@ -604,16 +716,16 @@ int absolute (Variable* var, Variable* right) {
 
     if (!checkIfFloating(right->type.dataType)) {
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = llabs(right_value);
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double right_value = getFloatNumber(right);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = fabs(right_value);
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
@@ -623,9 +735,9 @@ int not_bitwise (Variable* var, Variable* right) {
 
     if (!checkIfFloating(right->type.dataType)) {
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = ~right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         return ERROR_CANT_USE_TYPE_IN_BITWISE_EXPRESSION;
     }
@@ -637,63 +749,42 @@ int negative (Variable* var, Variable* right) {
 
     if (!checkIfFloating(right->type.dataType)) {
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = -right_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double right_value = getFloatNumber(right);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = -right_value;
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
 
+int getTruthValue (Variable* variable) {
+    if (checkIfFloating(variable->type.dataType)) {
+        return (int)getFloatNumber(variable) != 0;
+    }
+    return getSignedNumber(variable) != 0;
+}
+
 int logic_or (Variable* var, Variable* left, Variable* right) {
     destroyVariable(var);
 
-    long long int left_value;
-    long long int right_value;
-
-    if (checkIfFloating(left->type.dataType)) {
-        left_value = (int)getFloatNumber(left);
-    } else {
-        left_value = getSignedNumber(left);
-    }
-    if (checkIfFloating(right->type.dataType)) {
-        right_value = (int)getFloatNumber(right);
-    } else {
-        right_value = getSignedNumber(right);
-    }
-
-    int* value = malloc(sizeof(int));
-    *value = left_value || right_value;
-    *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+    int* value = allocValue(sizeof(int));
+    *value = getTruthValue(left) || getTruthValue(right);
+    *var = createLiteral(TYPE_BOOL, value, 1, 0);
     return 0;
 }
 
 int logic_and (Variable* var, Variable* left, Variable* right) {
     destroyVariable(var);
 
-    long long int left_value;
-    long long int right_value;
-
-    if (checkIfFloating(left->type.dataType)) {
-        left_value = (int)getFloatNumber(left);
-    } else {
-        left_value = getSignedNumber(left);
-    }
-    if (checkIfFloating(right->type.dataType)) {
-        right_value = (int)getFloatNumber(right);
-    } else {
-        right_value = getSignedNumber(right);
-    }
-
-    int* value = malloc(sizeof(int));
-    *value = left_value && right_value;
-    *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+    int* value = allocValue(sizeof(int));
+    *value = getTruthValue(left) && getTruthValue(right);
+    *var = createLiteral(TYPE_BOOL, value, 1, 0);
     return 0;
 }
 
@@ -702,18 +793,18 @@ int equal (Variable* var, Variable* left, Variable* right) {
 
     if (left->type.dataType == TYPE_STRING || right->type.dataType == TYPE_STRING) {
         if (left->type.dataType != right->type.dataType) {
-            int* value = malloc(sizeof(int));
+            int* value = allocValue(sizeof(int));
             *value = 0;
-            *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+            *var = createLiteral(TYPE_BOOL, value, 1, 0);
         } else {
             char* left_value = toString(left);
             char* right_value = toString(right);
             if (left_value == NULL || right_value == NULL) {
                 return ERROR_CANT_CONVERT_TO_STRING;
             }
-            int* value = malloc(sizeof(int));
+            int* value = allocValue(sizeof(int));
             *value = strcmp(left_value, right_value) == 0;
-            *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+            *var = createLiteral(TYPE_BOOL, value, 1, 0);
             free(left_value);
             free(right_value);
         }
@@ -721,17 +812,17 @@ int equal (Variable* var, Variable* left, Variable* right) {
     else if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
         *value = left_value == right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
 
         *value = left_value == right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     }
     return 0;
 }
@@ -741,18 +832,18 @@ int not_equal (Variable* var, Variable* left, Variable* right) {
 
     if (left->type.dataType == TYPE_STRING || right->type.dataType == TYPE_STRING) {
         if (left->type.dataType != right->type.dataType) {
-            int* value = malloc(sizeof(int));
+            int* value = allocValue(sizeof(int));
             *value = 0;
-            *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+            *var = createLiteral(TYPE_BOOL, value, 1, 0);
         } else {
             char* left_value = toString(left);
             char* right_value = toString(right);
             if (left_value == NULL || right_value == NULL) {
                 return ERROR_CANT_CONVERT_TO_STRING;
             }
-            int* value = malloc(sizeof(int));
+            int* value = allocValue(sizeof(int));
             *value = strcmp(left_value, right_value) != 0;
-            *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+            *var = createLiteral(TYPE_BOOL, value, 1, 0);
             free(left_value);
             free(right_value);
         }
@@ -760,17 +851,17 @@ int not_equal (Variable* var, Variable* left, Variable* right) {
     else if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
         *value = left_value != right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
 
         *value = left_value != right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     }
     return 0;
 }
@@ -781,17 +872,17 @@ int less_than (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
         *value = left_value < right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
 
         *value = left_value < right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     }
     return 0;
 }
@@ -802,17 +893,17 @@ int greater_than (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
         *value = left_value > right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
 
         *value = left_value > right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     }
     return 0;
 }
@@ -823,17 +914,17 @@ int less_than_or_equal (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
         *value = left_value <= right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
 
         *value = left_value <= right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     }
     return 0;
 }
@@ -844,17 +935,17 @@ int greater_than_or_equal (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
         *value = left_value >= right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        int* value = malloc(sizeof(int));
+        int* value = allocValue(sizeof(int));
 
         *value = left_value >= right_value;
-        *var = createVariable("-lit", TYPE_BOOL, value, 1, 0);
+        *var = createLiteral(TYPE_BOOL, value, 1, 0);
     }
     return 0;
 }
@@ -862,9 +953,8 @@ int greater_than_or_equal (Variable* var, Variable* left, Variable* right) {
 int assign (Variable* left, Variable* right) {
     switch (left->type.dataType) {
         case TYPE_STRING:
-            free(left->value);
-            left->value = malloc(sizeof(char) * (strlen((char*)right->value) + 1));
-            strcpy((char*)left->value, (char*)right->value);
+            freeValue(left->value);
+            left->value = allocString((char*)right->value);
             break;
         case TYPE_BOOL:
             *(int*)left->value = *(int*)right->value;
@@ -911,8 +1001,8 @@ int assign_add (Variable* left, Variable* right) {
         case TYPE_STRING: {}
             char* left_value = toString(left);
             char* right_value = toString(right);
-            free(left->value);
-            left->value = malloc(sizeof(char) * (strlen(left_value) + strlen(right_value) + 1));
+            freeValue(left->value);
+            left->value = allocValue(sizeof(char) * (strlen(left_value) + strlen(right_value) + 1));
             strcpy((char*)left->value, left_value);
             strcat((char*)left->value, right_value);
 
@@ -1205,20 +1295,30 @@ int assign_and (Variable* left, Variable* right) {
     return 0;
 }
 
+int getArrayIndex (const Variable* list, long long int index) {
+    if (index >= 0) {
+        for (long long int i = 0; i <= index; i++) {
+            if (list[i].type.dataType == D_NULL) return -1;
+        }
+        return index;
+    }
+    int length = getVariablesLength(list);
+    if (-index >= length) return -1;
+    return length + index;
+}
+
 int hash_refrence (Variable** var, Variable* arr, Variable* right) {
 
-    if (!arr->type.array) {
-        return ERROR_TYPE_MISMATCH;
+    if (!arr->type.array || isPackedArray(arr)) {
+        return ERROR_TYPE_MISMATCH; // the elements of a packed array aren't variables, they're refrenced with refrenceBit or refrenceMatrixElement
     }
 
-    int arr_length = getVariablesLength(arr->value);
-
-    int index = getSignedNumber(right);
-    if (llabs(index) >= arr_length) {
+    int index = getArrayIndex(arr->value, getSignedNumber(right));
+    if (index == -1) {
         return ERROR_ARRAY_OUT_OF_BOUNDS;
     }
 
-    *var = &((Variable*)arr->value)[index >= 0 ? index : arr_length + index];
+    *var = &((Variable*)arr->value)[index];
     
     return 0;
 }
@@ -1230,21 +1330,32 @@ int hash (Variable* var, Variable* arr, Variable* right) {
         return ERROR_TYPE_MISMATCH;
     }
     int index = getSignedNumber(right);
-    if (arr->type.array) {
-        int arr_length = getVariablesLength(arr->value);
-        if (llabs(index) >= arr_length) {
+    if (isBitArray(arr)) {
+        int bit_index = getBitIndex((BitArray*)arr->value, index);
+        if (bit_index == -1) {
+            return ERROR_ARRAY_OUT_OF_BOUNDS;
+        }
+
+        int* value = allocValue(sizeof(int));
+        *value = getBit((BitArray*)arr->value, bit_index);
+        *var = createLiteral(TYPE_BOOL, value, 0, 0);
+    } else if (isMatrix(arr)) {
+        return indexMatrix(var, arr, right, 1);
+    } else if (arr->type.array) {
+        int arr_index = getArrayIndex(arr->value, index);
+        if (arr_index == -1) {
             return ERROR_ARRAY_OUT_OF_BOUNDS;
         }
 
-        *var = cloneVariable(&((Variable*)arr->value)[index >= 0 ? index : arr_length + index]);
+        *var = cloneVariable(&((Variable*)arr->value)[arr_index]);
     } else {
         int str_length = strlen((char*)arr->value) + 1;
         if (llabs(index) >= str_length) {
             return ERROR_ARRAY_OUT_OF_BOUNDS;
         }
-        char* value = malloc(sizeof(char));
+        char* value = allocValue(sizeof(char));
         *value = ((char*)arr->value)[index >= 0 ? index : str_length + index];
-        *var = createVariable("-lit", TYPE_CHAR, value, 1, 0);
+        *var = createLiteral(TYPE_CHAR, value, 1, 0);
     }
     return 0;
 }
@@ -1255,17 +1366,17 @@ int max_op (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value < right_value ? right_value : left_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = left_value < right_value ? right_value : left_value;
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
@@ -1276,17 +1387,17 @@ int min_op (Variable* var, Variable* left, Variable* right) {
     if (!checkIfFloating(left->type.dataType) && !checkIfFloating(right->type.dataType)) {
         long long int left_value = getSignedNumber(left);
         long long int right_value = getSignedNumber(right);
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = left_value > right_value ? right_value : left_value;
-        *var = createVariable("-lit", TYPE_LONG, value, 1, 0);
+        *var = createLiteral(TYPE_LONG, value, 1, 0);
     } else {
         double left_value = getFloatNumber(left);
         double right_value = getFloatNumber(right);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
 
         *value = left_value > right_value ? right_value : left_value;
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 1, 0);
+        *var = createLiteral(TYPE_DOUBLE, value, 1, 0);
     }
     return 0;
 }
@@ -1317,6 +1428,208 @@ int compareVariables (Variable* left, Variable* right) {
     return left_value == right_value;
 }
 
+KernelClass getKernelClass (Type type) {
+    if (type.array) return KERNEL_CLASS_NONE;
+    switch (type.dataType) {
+        case TYPE_INT:
+        case TYPE_UINT:
+            return KERNEL_CLASS_INT;
+        case TYPE_LONG:
+        case TYPE_ULONG:
+            return KERNEL_CLASS_LONG;
+        case TYPE_DOUBLE:
+            return KERNEL_CLASS_DOUBLE;
+        default:
+            return KERNEL_CLASS_NONE;
+    }
+}
+
+// a kernel reads both operands as their C type and widens them the same way getSignedNumber and getFloatNumber do
+#define DEFINE_KERNEL(name, left_c, right_c, widen_c, result_c, result_type, op) \
+int name (Variable* var, Variable* left, Variable* right) { \
+    destroyVariable(var); \
+    result_c* value = allocValue(sizeof(result_c)); \
+    *value = (widen_c)*(left_c*)left->value op (widen_c)*(right_c*)right->value; \
+    *var = createLiteral(result_type, value, 1, 0); \
+    return 0; \
+}
+
+// define the kernels for every pair of classes, integers only are computed as a LONG and anything with a DOUBLE as a DOUBLE
+#define DEFINE_KERNELS(operation, op, integer_c, integer_type, floating_c, floating_type) \
+DEFINE_KERNEL(operation##_int_int, int, int, long long int, integer_c, integer_type, op) \
+DEFINE_KERNEL(operation##_int_long, int, long long int, long long int, integer_c, integer_type, op) \
+DEFINE_KERNEL(operation##_int_double, int, double, double, floating_c, floating_type, op) \
+DEFINE_KERNEL(operation##_long_int, long long int, int, long long int, integer_c, integer_type, op) \
+DEFINE_KERNEL(operation##_long_long, long long int, long long int, long long int, integer_c, integer_type, op) \
+DEFINE_KERNEL(operation##_long_double, long long int, double, double, floating_c, floating_type, op) \
+DEFINE_KERNEL(operation##_double_int, double, int, double, floating_c, floating_type, op) \
+DEFINE_KERNEL(operation##_double_long, double, long long int, double, floating_c, floating_type, op) \
+DEFINE_KERNEL(operation##_double_double, double, double, double, floating_c, floating_type, op)
+
+#define KERNEL_ROW(operation) \
+    operation##_int_int, operation##_int_long, operation##_int_double, \
+    operation##_long_int, operation##_long_long, operation##_long_double, \
+    operation##_double_int, operation##_double_long, operation##_double_double
+
+DEFINE_KERNELS(kernel_add, +, long long int, TYPE_LONG, double, TYPE_DOUBLE)
+DEFINE_KERNELS(kernel_subtract, -, long long int, TYPE_LONG, double, TYPE_DOUBLE)
+DEFINE_KERNELS(kernel_multiply, *, long long int, TYPE_LONG, double, TYPE_DOUBLE)
+DEFINE_KERNELS(kernel_equal, ==, int, TYPE_BOOL, int, TYPE_BOOL)
+DEFINE_KERNELS(kernel_not_equal, !=, int, TYPE_BOOL, int, TYPE_BOOL)
+DEFINE_KERNELS(kernel_less, <, int, TYPE_BOOL, int, TYPE_BOOL)
+DEFINE_KERNELS(kernel_greater, >, int, TYPE_BOOL, int, TYPE_BOOL)
+DEFINE_KERNELS(kernel_less_equal, <=, int, TYPE_BOOL, int, TYPE_BOOL)
+DEFINE_KERNELS(kernel_greater_equal, >=, int, TYPE_BOOL, int, TYPE_BOOL)
+
+// indexed by (operation, left class, right class)
+ArithmeticKernel arithmetic_kernels[KERNEL_OPERATION_COUNT * KERNEL_CLASS_COUNT * KERNEL_CLASS_COUNT] = {
+    KERNEL_ROW(kernel_add),
+    KERNEL_ROW(kernel_subtract),
+    KERNEL_ROW(kernel_multiply),
+    KERNEL_ROW(kernel_equal),
+    KERNEL_ROW(kernel_not_equal),
+    KERNEL_ROW(kernel_less),
+    KERNEL_ROW(kernel_greater),
+    KERNEL_ROW(kernel_less_equal),
+    KERNEL_ROW(kernel_greater_equal)
+};
+
+int getArithmeticKernel (OperatorType operator, Type left, Type right) {
+    KernelOperation operation = KERNEL_OPERATION_NONE;
+    switch (operator) {
+        default:
+            return -1;
+        case OPERATOR_ADD:
+            operation = KERNEL_ADD;
+            break;
+        case OPERATOR_SUBTRACT:
+            operation = KERNEL_SUBTRACT;
+            break;
+        case OPERATOR_MULTIPLY:
+            operation = KERNEL_MULTIPLY;
+            break;
+        case OPERATOR_EQUAL:
+            operation = KERNEL_EQUAL;
+            break;
+        case OPERATOR_NOT_EQUAL:
+            operation = KERNEL_NOT_EQUAL;
+            break;
+        case OPERATOR_LESS:
+            operation = KERNEL_LESS;
+            break;
+        case OPERATOR_GREATER:
+            operation = KERNEL_GREATER;
+            break;
+        case OPERATOR_LESS_EQUAL:
+            operation = KERNEL_LESS_EQUAL;
+            break;
+        case OPERATOR_GREATER_EQUAL:
+            operation = KERNEL_GREATER_EQUAL;
+            break;
+    }
+    KernelClass left_class = getKernelClass(left);
+    KernelClass right_class = getKernelClass(right);
+    if (left_class == KERNEL_CLASS_NONE || right_class == KERNEL_CLASS_NONE) return -1;
+
+    return (operation * KERNEL_CLASS_COUNT + left_class) * KERNEL_CLASS_COUNT + right_class;
+}
+
+Type getArithmeticKernelResult (int kernel) {
+    if (kernel / (KERNEL_CLASS_COUNT * KERNEL_CLASS_COUNT) >= KERNEL_EQUAL) return (Type){TYPE_BOOL, 0};
+    int left_class = kernel / KERNEL_CLASS_COUNT % KERNEL_CLASS_COUNT;
+    int right_class = kernel % KERNEL_CLASS_COUNT;
+    if (left_class == KERNEL_CLASS_DOUBLE || right_class == KERNEL_CLASS_DOUBLE) return (Type){TYPE_DOUBLE, 0};
+    return (Type){TYPE_LONG, 0};
+}
+
+int cachedBinaryOperation (Variable* var, Variable* left, Variable* right, OperatorType operator, int kernel) {
+    if (getKernelClass(left->type) == kernel / KERNEL_CLASS_COUNT % KERNEL_CLASS_COUNT && getKernelClass(right->type) == kernel % KERNEL_CLASS_COUNT) {
+        return arithmetic_kernels[kernel](var, left, right);
+    }
+    return binaryOperation(var, left, right, operator);
+}
+
+int binaryOperation (Variable* var, Variable* left, Variable* right, OperatorType operator) {
+    int kernel = getArithmeticKernel(operator, left->type, right->type);
+    if (kernel != -1) return arithmetic_kernels[kernel](var, left, right);
+
+    switch (operator) {
+        default:
+            return ERROR_INVALID_OPERATOR;
+
+        // arithmetic operators
+        case OPERATOR_ADD:
+            return add(var, left, right);
+        case OPERATOR_SUBTRACT:
+            return subtract(var, left, right);
+        case OPERATOR_MULTIPLY:
+            return multiply(var, left, right);
+        case OPERATOR_POWER:
+            return pow_op(var, left, right);
+        case OPERATOR_DIVIDE:
+            return divide(var, left, right);
+        case OPERATOR_ROOT:
+            return root(var, left, right);
+        case OPERATOR_MODULO:
+            return modulo(var, left, right);
+        case OPERATOR_XOR:
+            return xor(var, left, right);
+        case OPERATOR_AND:
+            return and(var, left, right);
+        case OPERATOR_OR:
+            return or(var, left, right);
+        case OPERATOR_SHIFT_LEFT:
+            return bitshift_left(var, left, right);
+        case OPERATOR_SHIFT_RIGHT:
+            return bitshift_right(var, left, right);
+
+        // logical operators
+        case OPERATOR_OR_OR:
+            return logic_or(var, left, right);
+        case OPERATOR_AND_AND:
+            return logic_and(var, left, right);
+
+        // comparison operators
+        case OPERATOR_EQUAL:
+            return equal(var, left, right);
+        case OPERATOR_NOT_EQUAL:
+            return not_equal(var, left, right);
+        case OPERATOR_LESS:
+            return less_than(var, left, right);
+        case OPERATOR_GREATER:
+            return greater_than(var, left, right);
+        case OPERATOR_LESS_EQUAL:
+            return less_than_or_equal(var, left, right);
+        case OPERATOR_GREATER_EQUAL:
+            return greater_than_or_equal(var, left, right);
+
+        // special operators
+        case OPERATOR_HASH:
+            return hash(var, left, right);
+        case OPERATOR_MAX:
+            return max_op(var, left, right);
+        case OPERATOR_MIN:
+            return min_op(var, left, right);
+    }
+}
+
+int unaryOperation (Variable* var, Variable* right, OperatorType operator) {
+    switch (operator) {
+        default:
+            return ERROR_OPERATOR_NOT_UNARY;
+        case OPERATOR_NOT:
+            return not(var, right);
+        case OPERATOR_NOT_BITWISE:
+            return not_bitwise(var, right);
+        case OPERATOR_SUBTRACT:
+            return negative(var, right);
+        case OPERATOR_ROOT:
+            return sqroot(var, right);
+        case OPERATOR_ABSOLUTE:
+            return absolute(var, right);
+    }
+}
+
 int sortCompareVariables (const void* left, const void* right) {
     return getFloatNumber((Variable*)left) - getFloatNumber((Variable*)right);
 }
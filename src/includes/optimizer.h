@@ -0,0 +1,1290 @@
+/**
+ * @author Sebastiaan Heins
+ * @file optimizer.h
+ * @brief Optimization passes that run over an AST before it is executed
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "token.h"
+#include "node.h"
+#include "ast.h"
+#include "variable.h"
+#include "scope.h"
+#include "operator.h"
+#include "expression.h"
+
+// the constants of the global scope that may be folded into the expressions using them
+#define FOLDABLE_CONSTANTS {"TRUE", "FALSE", "MATH_PI", "MATH_E", "MAXINT", "MININT", NULL}
+
+// the standard functions that give the same result for the same arguments and change nothing else, calls to them may be hoisted out of loops
+#define PURE_FUNCTIONS {"SQRT", "POW", "ROUND", "FLOOR", "CEIL", "ABS", "MIN", "MAX", "LOG", "SIN", "COS", "TAN", "ASIN", "ACOS", "ATAN", "EXP", \
+    "SPLIT", "LOWERCASE", "UPPERCASE", "LENGTH", "SUBSTRING", "INDEXOF", "LASTINDEXOF", "STARTSWITH", "ENDSWITH", "TRIM", "REVERSE", "REPLACE", "CONTAINS", "COUNT", \
+    "ARRAYSLICE", "ARRAYFINDINDEX", "ARRAYLASTINDEX", "ARRAYCONTAINS", "ARRAYREVERSE", "RANGE", "RANGEF", "FILL", "COUNTTRUE", "ANY", "ALL", NULL}
+
+// the standard functions that only change the control flow, a MEMO function may call them
+#define CONTROL_FUNCTIONS {"RETURN", "BREAK", "CONTINUE", NULL}
+
+// the most nodes the expression a function returns may have for calls to the function to be inlined
+#define INLINE_BUDGET 64
+
+/**
+ * @brief The statically known type of a variable name, the list is terminated by a NULL name
+*/
+typedef struct {
+    char* name;
+    Type type;
+} StaticType;
+
+/**
+ * @brief Optimize an AST, folding constant expressions into the constant pool, removing statically dead branches and picking typed kernels for operators
+ * @param ast The AST to optimize
+ * @param globals The global scope, holding the values of the foldable constants
+ * @param linked Whether or not the program has more than one file, the other files could redeclare the foldable constants so they aren't folded
+*/
+void optimizeAST (AST* ast, Scope* globals, int linked);
+
+/**
+ * @brief Optimize a subtree of an AST, the analysis still covers the whole AST
+ * @param ast The AST the subtree belongs to
+ * @param globals The global scope, holding the values of the foldable constants
+ * @param node The root of the subtree, used to optimize function bodies parsed after the rest of the AST
+ * @param linked Whether or not the program has more than one file, the other files could redeclare the foldable constants so they aren't folded
+*/
+void optimizeTree (AST* ast, Scope* globals, Node* node, int linked);
+
+/**
+ * @brief Optimize a node and all of it's children
+ * @param ast The AST the node belongs to
+ * @param globals The global scope
+ * @param shadowed The null terminated list of foldable constants that are redeclared somewhere in the AST
+ * @param node The node to optimize
+*/
+void optimizeNode (AST* ast, Scope* globals, const char** shadowed, Node* node);
+
+/**
+ * @brief Fold an expression into the constant pool when all of it's operands are constant
+ * @param ast The AST the node belongs to
+ * @param globals The global scope
+ * @param shadowed The null terminated list of shadowed constants
+ * @param node The expression to fold
+ * @return Whether or not the expression has been folded
+*/
+int foldExpression (AST* ast, Scope* globals, const char** shadowed, Node* node);
+
+/**
+ * @brief Cast a folded condition to a BOOL ahead of time
+ * @param ast The AST the condition belongs to
+ * @param condition The condition node
+ * @return The value of the condition, or -1 if it's not constant
+*/
+int precastCondition (AST* ast, Node* condition);
+
+/**
+ * @brief Remove the statically dead branches of a DO statement
+ * @param ast The AST the statement belongs to
+ * @param statement The statement to prune
+ * @return Whether or not the whole statement is dead and can be removed
+*/
+int pruneStatement (AST* ast, Node* statement);
+
+/**
+ * @brief Collect the declared types of all variable names in a node, names declared with different types get a D_NULL type
+ * @param ast The AST the node belongs to
+ * @param node The node to search
+ * @param types The list of static types to add to
+*/
+void collectStaticTypes (AST* ast, Node* node, StaticType** types);
+
+/**
+ * @brief Add a declaration to a list of static types
+ * @param types The list of static types
+ * @param name The name of the variable
+ * @param type The declared type
+*/
+void addStaticType (StaticType** types, const char* name, Type type);
+
+/**
+ * @brief Infer the type of an expression, caching a typed kernel on every operator whose operand types are known
+ * @param ast The AST the node belongs to
+ * @param types The list of static types
+ * @param node The expression
+ * @return The type of the expression, with a D_NULL type when it's not known
+*/
+Type inferType (AST* ast, StaticType* types, Node* node);
+
+/**
+ * @brief Cache typed kernels on all the expressions in a node
+ * @param ast The AST the node belongs to
+ * @param types The list of static types
+ * @param node The node to search
+*/
+void cacheKernels (AST* ast, StaticType* types, Node* node);
+
+/**
+ * @brief Add a value to the constant pool of an AST, the pool takes ownership of the value
+ * @param ast The AST to add the value to
+ * @param value The value to add
+ * @return The index of the value in the constant pool
+*/
+int addConstant (AST* ast, Variable value);
+
+/**
+ * @brief Collect the foldable constants that are redeclared or written to in a node, these can't be folded
+ * @param ast The AST the node belongs to
+ * @param node The node to search
+ * @param shadowed The null terminated list of shadowed constants to add to
+*/
+void collectShadowedConstants (AST* ast, Node* node, const char*** shadowed);
+
+/**
+ * @brief Add a foldable constant to the list of shadowed constants, if it isn't in there yet
+ * @param shadowed The null terminated list of shadowed constants
+ * @param name The name of the identifier
+*/
+void addShadowedConstant (const char*** shadowed, const char* name);
+
+/**
+ * @brief Collect the declarations of an unparsed block straight from it's tokens, so the analysis of the rest of the AST stays correct
+ * @param ast The AST the block belongs to
+ * @param block The unparsed block
+ * @param types The list of static types to add to, NULL to skip
+ * @param shadowed The null terminated list of shadowed constants to add to, NULL to skip
+*/
+void collectUnparsedDeclarations (AST* ast, Node* block, StaticType** types, const char*** shadowed);
+
+/**
+ * @brief Hoist the loop invariant expressions out of all WHILE and FOR loops in a node, and find the indices that stay in bounds for a whole FOR loop
+ * @param ast The AST the node belongs to
+ * @param globals The global scope, holding the standard functions
+ * @param node The node to search
+ * @note Outer loops are optimized first, so an expression is hoisted out of the outermost loop it doesn't change in
+*/
+void optimizeLoops (AST* ast, Scope* globals, Node* node);
+
+/**
+ * @brief Hoist the loop invariant expressions out of a WHILE or FOR loop
+ * @param ast The AST the loop belongs to
+ * @param globals The global scope
+ * @param statement The DO statement of the loop
+ * @param extension The index of the WHILE or FOR in the statement
+*/
+void optimizeLoop (AST* ast, Scope* globals, Node* statement, int extension);
+
+/**
+ * @brief Collect the names of the variables a node writes to or declares
+ * @param ast The AST the node belongs to
+ * @param globals The global scope
+ * @param node The node to search
+ * @param skip A node that is left out, NULL to search everything
+ * @param written The null terminated list of names to add to
+ * @return Whether or not the node can run code the optimizer can't see (a call to a function that isn't pure or an import), the loop can't be optimized then
+*/
+int collectLoopWrites (AST* ast, Scope* globals, Node* node, const Node* skip, const char*** written);
+
+/**
+ * @brief Add a name to a list of written names, if it isn't in there yet
+ * @param written The null terminated list of written names
+ * @param name The name of the variable
+*/
+void addWrittenName (const char*** written, const char* name);
+
+/**
+ * @brief Check if a name is in a list of written names
+ * @param written The null terminated list of written names
+ * @param name The name of the variable
+ * @return Whether or not the name is written to
+*/
+int isWrittenName (const char** written, const char* name);
+
+/**
+ * @brief Check if an expression gives the same value every time it's evaluated in a loop
+ * @param ast The AST the expression belongs to
+ * @param globals The global scope
+ * @param written The null terminated list of names the loop writes to
+ * @param node The expression
+ * @param calls Whether or not the expression may hold calls, a hoisted expression can only leave the result of a call in _ when it is the call
+ * @return Whether or not the expression is loop invariant
+*/
+int isLoopInvariant (AST* ast, Scope* globals, const char** written, const Node* node, int calls);
+
+/**
+ * @brief Give the largest loop invariant expressions in a node an invariant slot of a loop
+ * @param ast The AST the node belongs to
+ * @param globals The global scope
+ * @param written The null terminated list of names the loop writes to
+ * @param node The node to search
+ * @param skip A node that is left out, NULL to search everything
+ * @param loop The first slot of the loop
+*/
+void hoistInvariants (AST* ast, Scope* globals, const char** written, Node* node, const Node* skip, int loop);
+
+/**
+ * @brief Give the indices by the variable of a FOR loop (a#i) a bounds slot, so the bounds are checked once for the whole loop
+ * @param ast The AST the node belongs to
+ * @param globals The global scope
+ * @param written The null terminated list of names the loop writes to
+ * @param node The node to search
+ * @param variable The name of the loop variable
+ * @param loop The first slot of the loop
+ * @note Only indices into arrays the loop doesn't write to are marked, with all the indices before them loop invariant
+*/
+void markBoundedIndices (AST* ast, Scope* globals, const char** written, Node* node, const char* variable, int loop);
+
+/**
+ * @brief Add an invariant slot to an AST
+ * @param ast The AST to add the slot to
+ * @param loop The first slot of the loop the slot belongs to, -1 to start the slots of a new loop
+ * @return The index of the slot
+*/
+int addInvariantSlot (AST* ast, int loop);
+
+/**
+ * @brief Check if a name refers to a standard function that may be hoisted out of a loop
+ * @param globals The global scope
+ * @param name The name of the function
+ * @return Whether or not the function is pure
+*/
+int isPureFunction (Scope* globals, const char* name);
+
+/**
+ * @brief Get the node an expression wraps, skipping the expressions that only hold one node
+ * @param node The expression
+ * @return The wrapped node
+*/
+Node* unwrapExpression (Node* node);
+
+/**
+ * @brief Create the expression calls to a function are replaced with, for functions that only return an expression without side effects
+ * @param globals The global scope
+ * @param function The function, it's body must be parsed
+ * @return The inline call the calls are turned into, without the call itself, or NULL when the function can't be inlined (must be destroyed and freed after use)
+ * @note The body holds the returned expression cast to the return type, followed by a cast to the type of every argument
+*/
+Node* createInlineBody (Scope* globals, Function* function);
+
+/**
+ * @brief Get the size of an expression that may be inlined
+ * @param globals The global scope
+ * @param node The expression
+ * @return The amount of nodes, or -1 when the expression holds something other than operators, values and pure standard functions
+*/
+int getInlineSize (Scope* globals, const Node* node);
+
+/**
+ * @brief Turn the identifiers of the arguments of a function into inline arguments
+ * @param node The inlined expression
+ * @param function The function the expression was taken from
+*/
+void markInlineArguments (Node* node, const Function* function);
+
+/**
+ * @brief Check if a MEMO function can cache it's results, it may only write and read it's own variables and call pure functions
+ * @param ast The AST the function is declared in
+ * @param globals The global scope
+ * @param function The function, it's body must be parsed
+ * @return Whether or not the function is pure
+ * @note The check is conservative, reading a global variable is enough to make a function impure because the variable could change between calls, and so is reading one of it's own variables where it isn't declared
+*/
+int isMemoizable (AST* ast, Scope* globals, const Function* function);
+
+/**
+ * @brief Collect the names of the variables a function declares
+ * @param ast The AST the node belongs to
+ * @param node The node to search
+ * @param locals The null terminated list of names to add to
+*/
+void collectMemoLocals (AST* ast, Node* node, const char*** locals);
+
+/**
+ * @brief Check if a node of a MEMO function only uses the variables of the function and pure functions
+ * @param ast The AST the node belongs to
+ * @param globals The global scope
+ * @param function The function
+ * @param locals The null terminated list of names the function declares, including it's arguments
+ * @param node The node to check
+ * @return Whether or not the node is pure
+*/
+int isMemoNodePure (AST* ast, Scope* globals, const Function* function, const char** locals, const Node* node);
+
+/**
+ * @brief Check if a RETURN of a call to a function itself can run the call in place of the function
+ * @param ast The AST the function belongs to
+ * @param function The function, it's body must be parsed
+ * @return Whether or not the tail call gives the same result as a normal call
+ * @note The scope of the function is gone when the call runs, so the body may not read one of it's own variables before it has declared it again
+*/
+int isTailCallSafe (AST* ast, const Function* function);
+
+/**
+ * @brief Check if a node reads a variable of the function where it isn't declared, walking the statements in the order they run
+ * @param locals The null terminated list of names the function declares
+ * @param declared The null terminated list of names declared before the node, the declarations of the node are added and removed again when their block ends
+ * @param node The node to check
+ * @return Whether or not such a variable is read
+ * @note Variables are looked up through the calling scopes, so a name read before it's declared or after it's block ended is the variable of a caller
+*/
+int readsUndeclaredLocal (const char** locals, const char*** declared, const Node* node);
+
+/**
+ * @brief Create a cast to the type written by a range of tokens
+ * @param first The first token of the type
+ * @param last The last token of the type
+ * @return The cast node
+*/
+Node createInlineCast (int first, int last);
+
+/**
+ * @brief Check if an identifier refers to a constant that can be folded
+ * @param name The name of the identifier
+ * @param shadowed The null terminated list of shadowed constants
+ * @return The name in the list of foldable constants, or NULL if it can't be folded
+*/
+const char* getFoldableConstant (const char* name, const char** shadowed);
+
+
+void optimizeAST (AST* ast, Scope* globals, int linked) {
+    optimizeTree(ast, globals, &ast->root, linked);
+}
+
+void optimizeTree (AST* ast, Scope* globals, Node* node, int linked) {
+    static const char* foldable[] = FOLDABLE_CONSTANTS;
+    const char** shadowed = malloc(sizeof(char*));
+    shadowed[0] = NULL;
+    collectShadowedConstants(ast, &ast->root, &shadowed);
+    // a function of one file can run in a scope of another, where the constant is redeclared
+    for (int i = 0; linked && foldable[i] != NULL; i++) {
+        addShadowedConstant(&shadowed, foldable[i]);
+    }
+
+    optimizeNode(ast, globals, shadowed, node);
+
+    free(shadowed);
+
+    StaticType* types = malloc(sizeof(StaticType));
+    types[0].name = NULL;
+    collectStaticTypes(ast, &ast->root, &types);
+
+    cacheKernels(ast, types, node);
+
+    for (int i = 0; types[i].name != NULL; i++) {
+        free(types[i].name);
+    }
+    free(types);
+
+    optimizeLoops(ast, globals, node);
+}
+
+void optimizeNode (AST* ast, Scope* globals, const char** shadowed, Node* node) {
+    switch (node->type) {
+        case NODE_PROGRAM:
+        case NODE_BLOCK:
+        case NODE_BLOCK_EXPRESSION:
+            for (int i = 0; i < getNodeBodyLength(node->body); i++) {
+                optimizeNode(ast, globals, shadowed, &node->body[i]);
+                if (node->body[i].type == NODE_FUNCTION_CALL && pruneStatement(ast, &node->body[i])) {
+                    removeFromBody(&node->body, i, 1);
+                    i--;
+                }
+            }
+            break;
+        case NODE_FUNCTION_CALL:
+            for (int i = 0; i < getNodeBodyLength(node->body); i++) {
+                optimizeNode(ast, globals, shadowed, &node->body[i]);
+            }
+            // conditions are always cast to a BOOL, so constant ones can be cast once
+            for (int i = 0; i < getNodeBodyLength(node->body) - 1; i++) {
+                if (node->body[i].type == NODE_WHEN || node->body[i].type == NODE_WHILE || node->body[i].type == NODE_IF) {
+                    precastCondition(ast, &node->body[i + 1]);
+                }
+            }
+            break;
+        case NODE_EXPRESSION:
+        case NODE_UNARY_EXPRESSION:
+        case NODE_LITERAL:
+        case NODE_IDENTIFIER:
+            foldExpression(ast, globals, shadowed, node);
+            break;
+        default:
+            for (int i = 0; i < getNodeBodyLength(node->body); i++) {
+                optimizeNode(ast, globals, shadowed, &node->body[i]);
+            }
+            break;
+    }
+}
+
+int foldExpression (AST* ast, Scope* globals, const char** shadowed, Node* node) {
+    if (node->constant != -1) return 1;
+
+    Variable value = createNullTerminatedVariable();
+    int folded = 0;
+    switch (node->type) {
+        default:
+            optimizeNode(ast, globals, shadowed, node);
+            return 0;
+        case NODE_LITERAL:
+            folded = !parseLiteralText(&value, node->text);
+            break;
+        case NODE_IDENTIFIER: {}
+            if (getFoldableConstant(node->text, shadowed) == NULL) return 0;
+            Variable* ref = getScopeVariable(globals, node->text);
+            if (ref == NULL) return 0;
+            value = cloneVariable(ref);
+            folded = 1;
+            break;
+        case NODE_EXPRESSION: {}
+            int length = getNodeBodyLength(node->body);
+            if (length == 1) {
+                if (!foldExpression(ast, globals, shadowed, &node->body[0])) return 0;
+                value = cloneVariable(&ast->constants[node->body[0].constant]);
+                folded = 1;
+                break;
+            }
+            if (length != 3) {
+                optimizeNode(ast, globals, shadowed, node);
+                return 0;
+            }
+            // fold both sides, even if one of them isn't constant
+            int left_folded = foldExpression(ast, globals, shadowed, &node->body[0]);
+            int right_folded = foldExpression(ast, globals, shadowed, &node->body[2]);
+            if (!left_folded || !right_folded || node->body[1].type != NODE_OPERATOR) return 0;
+
+            Variable left = cloneVariable(&ast->constants[node->body[0].constant]);
+            Variable right = cloneVariable(&ast->constants[node->body[2].constant]);
+            // operators that fail are left for the interpreter, so the error is reported when the expression runs
+            folded = !binaryOperation(&value, &left, &right, ast->tokens[node->body[1].start].carry);
+            destroyVariable(&left);
+            destroyVariable(&right);
+            break;
+        case NODE_UNARY_EXPRESSION: {}
+            if (getNodeBodyLength(node->body) != 2) return 0;
+            if (!foldExpression(ast, globals, shadowed, &node->body[1])) return 0;
+
+            Variable operand = cloneVariable(&ast->constants[node->body[1].constant]);
+            if (node->body[0].type == NODE_OPERATOR) {
+                folded = !unaryOperation(&value, &operand, ast->tokens[node->body[0].start].carry);
+            } else if (node->body[0].type == NODE_OPERATOR_CAST) {
+                Type castType = (Type){.dataType = D_NULL, .array = 0};
+                folded = !getTypeFromCastTokens(ast->tokens, &castType, &node->body[0]) && !castValue(&operand, castType);
+                if (folded) {
+                    value = operand;
+                    operand = createNullTerminatedVariable();
+                }
+            }
+            destroyVariable(&operand);
+            break;
+    }
+
+    if (!folded) {
+        destroyVariable(&value);
+        return 0;
+    }
+    value.literal = 0; // the value is owned by the constant pool
+    node->constant = addConstant(ast, value);
+    return 1;
+}
+
+int precastCondition (AST* ast, Node* condition) {
+    if (condition->constant == -1) return -1;
+    Variable* value = &ast->constants[condition->constant];
+    if (!compareType(value->type, (Type){TYPE_BOOL, 0})) {
+        // a condition that can't be cast is reported by the interpreter
+        Variable cast = cloneVariable(value);
+        if (castValue(&cast, (Type){TYPE_BOOL, 0})) {
+            destroyVariable(&cast);
+            return -1;
+        }
+        destroyVariable(value);
+        *value = cast;
+        value->literal = 0;
+    }
+    return *(int*)value->value != 0;
+}
+
+int pruneStatement (AST* ast, Node* statement) {
+    while (1) {
+        int length = getNodeBodyLength(statement->body);
+        if (length == 0) return 0;
+        if (statement->body[0].type != NODE_FUNCTION_IDENTIFIER && statement->body[0].type != NODE_BLOCK && statement->body[0].type != NODE_IF) return 0;
+
+        // WHEN, WHILE and FOR encompass everything before them, the first one decides the flow of the statement
+        int extension = -1;
+        for (int i = 0; i < length; i++) {
+            if (statement->body[i].type == NODE_WHEN || statement->body[i].type == NODE_WHILE || statement->body[i].type == NODE_FOR || statement->body[i].type == NODE_PFOR) {
+                extension = i;
+                break;
+            }
+        }
+
+        if (extension != -1) {
+            if (extension == 0 || extension + 1 >= length || statement->body[extension].type == NODE_FOR || statement->body[extension].type == NODE_PFOR) return 0;
+            int condition = precastCondition(ast, &statement->body[extension + 1]);
+            if (condition == -1) return 0;
+
+            if (statement->body[extension].type == NODE_WHILE) {
+                // a loop that never runs does nothing
+                return extension + 1 == length - 1 && !condition;
+            }
+
+            if (extension + 1 == length - 1) {
+                if (condition) {
+                    // the WHEN always passes, only the call chain remains
+                    removeFromBody(&statement->body, extension, 2);
+                    return 0;
+                }
+                return 1; // the WHEN never passes and there's no ELSE
+            }
+            if (statement->body[extension + 2].type != NODE_ELSE || extension + 3 >= length) return 0;
+
+            if (condition) {
+                // the ELSE branch is never taken
+                removeFromBody(&statement->body, extension, length - extension);
+                return 0;
+            }
+            // the call chain is never run, the ELSE branch takes it's place
+            removeFromBody(&statement->body, 0, extension + 3);
+            continue;
+        }
+
+        // IF (condition) THEN call ELSE ...
+        if (statement->body[0].type != NODE_IF || length < 4) return 0;
+        if (statement->body[1].type != NODE_EXPRESSION || statement->body[2].type != NODE_THEN) return 0;
+        if (statement->body[3].type != NODE_FUNCTION_IDENTIFIER && statement->body[3].type != NODE_BLOCK) return 0;
+
+        int condition = precastCondition(ast, &statement->body[1]);
+        if (condition == -1) return 0;
+
+        if (length == 4) {
+            if (!condition) return 1;
+            removeFromBody(&statement->body, 0, 3);
+            return 0;
+        }
+        if (!condition && statement->body[4].type == NODE_ELSE && length > 5) {
+            removeFromBody(&statement->body, 0, 5);
+            continue;
+        }
+        return 0;
+    }
+}
+
+void collectStaticTypes (AST* ast, Node* node, StaticType** types) {
+    int length = getNodeBodyLength(node->body);
+    Type type = (Type){D_NULL, 0};
+    Node* declaration = node;
+    switch (node->type) {
+        default:
+            break;
+        case NODE_UNPARSED_BLOCK:
+            collectUnparsedDeclarations(ast, node, types, NULL);
+            return;
+        case NODE_MAKE_VAR:
+        case NODE_ARRAY_DECLARATION:
+        case NODE_FUNCTION_DECLARATION_ARGUMENT:
+            // ARRAY ARRAY INT name, the same way the interpreter reads it
+            while (getNodeBodyLength(declaration->body) > 1 && declaration->body[0].type == NODE_TYPE_IDENTIFIER && ast->tokens[declaration->body[0].start].carry == TYPE_ARRAY) {
+                type.array++;
+                declaration = &declaration->body[1];
+            }
+            if (getNodeBodyLength(declaration->body) > 1 && declaration->body[0].type == NODE_TYPE_IDENTIFIER && declaration->body[1].type == NODE_IDENTIFIER) {
+                type.dataType = ast->tokens[declaration->body[0].start].carry;
+                addStaticType(types, declaration->body[1].text, type);
+            }
+            // the nested declarations of an array have been handled, only search the value
+            if (declaration != node) {
+                for (int i = 2; i < getNodeBodyLength(declaration->body); i++) {
+                    collectStaticTypes(ast, &declaration->body[i], types);
+                }
+                return;
+            }
+            break;
+        case NODE_EXPRESSION:
+            // the type of a FOR variable depends on the array, so it's never known
+            if (length == 3 && node->body[1].type == NODE_OPERATOR && ast->tokens[node->body[1].start].carry == OPERATOR_AS && node->body[2].type == NODE_IDENTIFIER) {
+                addStaticType(types, node->body[2].text, (Type){D_NULL, 0});
+            }
+            break;
+    }
+
+    for (int i = 0; i < length; i++) {
+        collectStaticTypes(ast, &node->body[i], types);
+    }
+}
+
+void addStaticType (StaticType** types, const char* name, Type type) {
+    int length = 0;
+    while ((*types)[length].name != NULL) {
+        if (!strcmp((*types)[length].name, name)) {
+            // a name declared with different types can't be known statically
+            if (!compareType((*types)[length].type, type)) (*types)[length].type = (Type){D_NULL, 0};
+            return;
+        }
+        length++;
+    }
+    *types = realloc(*types, sizeof(StaticType) * (length + 2));
+    (*types)[length].name = malloc(sizeof(char) * (strlen(name) + 1));
+    strcpy((*types)[length].name, name);
+    (*types)[length].type = type;
+    (*types)[length + 1].name = NULL;
+}
+
+Type inferType (AST* ast, StaticType* types, Node* node) {
+    Type unknown = (Type){D_NULL, 0};
+    if (node->constant != -1) return ast->constants[node->constant].type;
+
+    int length = getNodeBodyLength(node->body);
+    switch (node->type) {
+        default:
+            return unknown;
+        case NODE_IDENTIFIER:
+            for (int i = 0; types[i].name != NULL; i++) {
+                if (!strcmp(types[i].name, node->text)) return types[i].type;
+            }
+            return unknown;
+        case NODE_EXPRESSION:
+            if (length == 1) return inferType(ast, types, &node->body[0]);
+            if (length != 3 || node->body[1].type != NODE_OPERATOR) return unknown;
+
+            Type left = inferType(ast, types, &node->body[0]);
+            Type right = inferType(ast, types, &node->body[2]);
+            if (left.dataType == D_NULL || right.dataType == D_NULL) return unknown;
+
+            int kernel = getArithmeticKernel(ast->tokens[node->body[1].start].carry, left, right);
+            if (kernel == -1) return unknown;
+            node->body[1].kernel = kernel;
+            return getArithmeticKernelResult(kernel);
+        case NODE_UNARY_EXPRESSION:
+            if (length != 2) return unknown;
+            inferType(ast, types, &node->body[1]);
+            if (node->body[0].type != NODE_OPERATOR_CAST) return unknown;
+
+            Type castType = (Type){D_NULL, 0};
+            if (getTypeFromCastTokens(ast->tokens, &castType, &node->body[0])) return unknown;
+            return castType;
+    }
+}
+
+void cacheKernels (AST* ast, StaticType* types, Node* node) {
+    if (node->type == NODE_EXPRESSION || node->type == NODE_UNARY_EXPRESSION) {
+        inferType(ast, types, node);
+    }
+    for (int i = 0; i < getNodeBodyLength(node->body); i++) {
+        cacheKernels(ast, types, &node->body[i]);
+    }
+}
+
+int addConstant (AST* ast, Variable value) {
+    int length = ast->constants == NULL ? 0 : getVariablesLength(ast->constants);
+    ast->constants = realloc(ast->constants, sizeof(Variable) * (length + 2));
+    ast->constants[length] = value;
+    ast->constants[length + 1] = createNullTerminatedVariable();
+    return length;
+}
+
+void collectShadowedConstants (AST* ast, Node* node, const char*** shadowed) {
+    int length = getNodeBodyLength(node->body);
+    Node* target = NULL;
+    switch (node->type) {
+        default:
+            break;
+        case NODE_UNPARSED_BLOCK:
+            collectUnparsedDeclarations(ast, node, NULL, shadowed);
+            return;
+        case NODE_MAKE_VAR:
+        case NODE_FUNCTION_DECLARATION_ARGUMENT:
+            if (length > 1) target = &node->body[1];
+            break;
+        case NODE_EXPRESSION:
+            // FOR loops declare the identifier after AS
+            if (length == 3 && node->body[1].type == NODE_OPERATOR && ast->tokens[node->body[1].start].carry == OPERATOR_AS) target = &node->body[2];
+            break;
+        case NODE_FUNCTION_CALL:
+            // INTO writes to a variable without checking if it's a constant
+            for (int i = 0; i < length - 1; i++) {
+                if (node->body[i].type == NODE_INTO) {
+                    target = &node->body[i + 1];
+                    while (target->type == NODE_EXPRESSION && getNodeBodyLength(target->body) > 0) {
+                        target = &target->body[0];
+                    }
+                }
+            }
+            break;
+    }
+
+    if (target != NULL && target->type == NODE_IDENTIFIER) {
+        addShadowedConstant(shadowed, target->text);
+    }
+
+    for (int i = 0; i < length; i++) {
+        collectShadowedConstants(ast, &node->body[i], shadowed);
+    }
+}
+
+void addShadowedConstant (const char*** shadowed, const char* name) {
+    const char* constant = getFoldableConstant(name, *shadowed);
+    if (constant == NULL) return;
+    int shadowed_length = 0;
+    while ((*shadowed)[shadowed_length] != NULL) shadowed_length++;
+    *shadowed = realloc(*shadowed, sizeof(char*) * (shadowed_length + 2));
+    (*shadowed)[shadowed_length] = constant;
+    (*shadowed)[shadowed_length + 1] = NULL;
+}
+
+void collectUnparsedDeclarations (AST* ast, Node* block, StaticType** types, const char*** shadowed) {
+    Token* tokens = ast->tokens;
+    for (int i = block->start; i <= block->end; i++) {
+        int name = -1;
+        Type type = (Type){D_NULL, 0};
+        if (tokens[i].type == TOKEN_VAR_TYPE && tokens[i].carry != TYPE_FUNC && (i == block->start || tokens[i-1].type != TOKEN_VAR_TYPE)) {
+            // ARRAY ARRAY INT name declares a variable or an argument, casts are always followed by a bracket
+            int j = i;
+            while (j <= block->end && tokens[j].type == TOKEN_VAR_TYPE) {
+                if (tokens[j].carry == TYPE_ARRAY) type.array++;
+                j++;
+            }
+            if (j > block->end || tokens[j].type != TOKEN_IDENTIFIER) continue;
+            type.dataType = tokens[j-1].carry;
+            name = j;
+        } else if ((tokens[i].type == TOKEN_OPERATOR && tokens[i].carry == OPERATOR_AS) || (tokens[i].type == TOKEN_EXT && tokens[i].carry == NODE_INTO - NODE_WHEN)) {
+            // FOR loops declare the identifier after AS, INTO writes to the identifier after it
+            if (i + 1 > block->end || tokens[i+1].type != TOKEN_IDENTIFIER) continue;
+            name = i + 1;
+        } else {
+            continue;
+        }
+
+        int length = tokens[name].end - tokens[name].start + 1;
+        char* text = malloc(sizeof(char) * (length + 1));
+        strncpy(text, ast->full_code + tokens[name].start, length);
+        text[length] = '\0';
+        if (types != NULL && tokens[i].type != TOKEN_EXT) addStaticType(types, text, type);
+        if (shadowed != NULL) addShadowedConstant(shadowed, text);
+        free(text);
+    }
+}
+
+void optimizeLoops (AST* ast, Scope* globals, Node* node) {
+    int length = getNodeBodyLength(node->body);
+    if (node->type == NODE_FUNCTION_CALL) {
+        for (int i = 0; i < length; i++) {
+            if (node->body[i].type == NODE_WHILE || node->body[i].type == NODE_FOR || node->body[i].type == NODE_PFOR) optimizeLoop(ast, globals, node, i);
+        }
+    }
+    for (int i = 0; i < length; i++) {
+        optimizeLoops(ast, globals, &node->body[i]);
+    }
+}
+
+void optimizeLoop (AST* ast, Scope* globals, Node* statement, int extension) {
+    // the loop runs the chain since the last ELSE, the interpreter starts there when the WHEN before it fails
+    int start = 0;
+    for (int i = 0; i < extension; i++) {
+        if (statement->body[i].type == NODE_WHEN || statement->body[i].type == NODE_WHILE || statement->body[i].type == NODE_FOR || statement->body[i].type == NODE_PFOR) start = i + 3;
+    }
+    int end = extension + 1;
+    if (start >= extension || end >= getNodeBodyLength(statement->body)) return;
+
+    Node* loop = &statement->body[extension];
+    const Node* skip = NULL;
+    const char* variable = NULL;
+    if (loop->type == NODE_FOR || loop->type == NODE_PFOR) {
+        // the array is evaluated once before the loop starts, so it's left out
+        Node* expression = &statement->body[end];
+        if (getNodeBodyLength(expression->body) != 3 || expression->body[2].type != NODE_IDENTIFIER) return;
+        skip = &expression->body[0];
+        variable = expression->body[2].text;
+    }
+
+    const char** written = malloc(sizeof(char*));
+    written[0] = NULL;
+    addWrittenName(&written, "_"); // every call leaves it's result in _
+    int opaque = 0;
+    for (int i = start; i <= end && !opaque; i++) {
+        opaque = collectLoopWrites(ast, globals, &statement->body[i], skip, &written);
+    }
+
+    if (!opaque) {
+        int first = addInvariantSlot(ast, -1);
+        for (int i = start; i <= end; i++) {
+            hoistInvariants(ast, globals, written, &statement->body[i], skip, first);
+            if (variable != NULL) markBoundedIndices(ast, globals, written, &statement->body[i], variable, first);
+        }
+        if (ast->invariant_count == first + 1) {
+            ast->invariant_count--; // nothing to hoist
+        } else {
+            loop->invariant = first;
+        }
+    }
+    free(written);
+}
+
+int collectLoopWrites (AST* ast, Scope* globals, Node* node, const Node* skip, const char*** written) {
+    if (node == skip) return 0;
+    int length = getNodeBodyLength(node->body);
+    Node* declaration = node;
+    switch (node->type) {
+        default:
+            break;
+        case NODE_IMPORT:
+            return 1;
+        case NODE_UNPARSED_BLOCK:
+            return 0; // a function body only runs when the function is called
+        case NODE_FUNCTION_IDENTIFIER:
+            if (length > 0 && !isPureFunction(globals, node->body[0].text)) {
+                // standard functions only change _, except for the ones that call back into the program
+                Function* function = getFunction(globals, node->body[0].text);
+                if (function == NULL || !function->std_function || !strcmp(node->body[0].text, "ARRAYSORTFUNC")) return 1;
+            }
+            break;
+        case NODE_MAKE_VAR:
+        case NODE_ARRAY_DECLARATION:
+            while (getNodeBodyLength(declaration->body) > 1 && declaration->body[1].type != NODE_IDENTIFIER) {
+                declaration = &declaration->body[1];
+            }
+            if (getNodeBodyLength(declaration->body) > 1) addWrittenName(written, declaration->body[1].text);
+            break;
+        case NODE_SET_VAR:
+            if (length > 0) {
+                Node* target = &node->body[0];
+                while (target->type == NODE_EXPRESSION && getNodeBodyLength(target->body) > 0) {
+                    target = &target->body[0];
+                }
+                if (target->type != NODE_IDENTIFIER) return 1;
+                addWrittenName(written, target->text);
+            }
+            break;
+        case NODE_FUNCTION_CALL:
+            for (int i = 0; i < length - 1; i++) {
+                if (node->body[i].type != NODE_INTO) continue;
+                Node* target = &node->body[i + 1];
+                while (target->type == NODE_EXPRESSION && getNodeBodyLength(target->body) > 0) {
+                    target = &target->body[0];
+                }
+                if (target->type != NODE_IDENTIFIER) return 1;
+                addWrittenName(written, target->text);
+            }
+            break;
+        case NODE_EXPRESSION:
+            // FOR loops declare the identifier after AS
+            if (length == 3 && node->body[1].type == NODE_OPERATOR && ast->tokens[node->body[1].start].carry == OPERATOR_AS) addWrittenName(written, node->body[2].text);
+            break;
+    }
+
+    for (int i = 0; i < length; i++) {
+        if (collectLoopWrites(ast, globals, &node->body[i], skip, written)) return 1;
+    }
+    return 0;
+}
+
+void addWrittenName (const char*** written, const char* name) {
+    if (isWrittenName(*written, name)) return;
+    int length = 0;
+    while ((*written)[length] != NULL) length++;
+    *written = realloc(*written, sizeof(char*) * (length + 2));
+    (*written)[length] = name;
+    (*written)[length + 1] = NULL;
+}
+
+int isWrittenName (const char** written, const char* name) {
+    for (int i = 0; written[i] != NULL; i++) {
+        if (!strcmp(written[i], name)) return 1;
+    }
+    return 0;
+}
+
+int isLoopInvariant (AST* ast, Scope* globals, const char** written, const Node* node, int calls) {
+    if (node->constant != -1) return 1;
+    int length = getNodeBodyLength(node->body);
+    switch (node->type) {
+        default:
+            return 0;
+        case NODE_LITERAL:
+            return 1;
+        case NODE_IDENTIFIER:
+            return !isWrittenName(written, node->text);
+        case NODE_EXPRESSION:
+            if (length == 1) return isLoopInvariant(ast, globals, written, &node->body[0], calls);
+            if (length != 3 || node->body[1].type != NODE_OPERATOR || ast->tokens[node->body[1].start].carry == OPERATOR_AS) return 0;
+            return isLoopInvariant(ast, globals, written, &node->body[0], calls) && isLoopInvariant(ast, globals, written, &node->body[2], calls);
+        case NODE_UNARY_EXPRESSION:
+            return length == 2 && isLoopInvariant(ast, globals, written, &node->body[1], calls);
+        case NODE_ARRAY_EXPRESSION:
+            for (int i = 0; i < length; i++) {
+                if (!isLoopInvariant(ast, globals, written, &node->body[i], calls)) return 0;
+            }
+            return 1;
+        case NODE_FUNCTION_IDENTIFIER:
+            if (!calls || length != 2 || !isPureFunction(globals, node->body[0].text)) return 0;
+            for (int i = 0; i < getNodeBodyLength(node->body[1].body); i++) {
+                if (!isLoopInvariant(ast, globals, written, &node->body[1].body[i], 1)) return 0;
+            }
+            return 1;
+    }
+}
+
+void hoistInvariants (AST* ast, Scope* globals, const char** written, Node* node, const Node* skip, int loop) {
+    if (node == skip || node->constant != -1 || node->invariant != -1) return;
+    int length = getNodeBodyLength(node->body);
+    switch (node->type) {
+        default:
+            break;
+        case NODE_UNPARSED_BLOCK:
+            return;
+        case NODE_FUNCTION_CALL:
+            // the calls of a chain aren't expressions, only their arguments are
+            for (int i = 0; i < length; i++) {
+                if (node->body[i].type == NODE_FUNCTION_IDENTIFIER && getNodeBodyLength(node->body[i].body) == 2) {
+                    hoistInvariants(ast, globals, written, &node->body[i].body[1], skip, loop);
+                } else {
+                    hoistInvariants(ast, globals, written, &node->body[i], skip, loop);
+                }
+            }
+            return;
+        case NODE_EXPRESSION:
+            if (length == 1) break; // the wrapped expression is hoisted instead
+            if (length == 3 && node->body[1].type == NODE_OPERATOR && ast->tokens[node->body[1].start].carry == OPERATOR_HASH && !isLoopInvariant(ast, globals, written, node, 1)) {
+                // the arrays of an index chain are walked in place, only it's indices are worth hoisting
+                Node* level = node;
+                while (level->type == NODE_EXPRESSION && getNodeBodyLength(level->body) == 3 && level->body[1].type == NODE_OPERATOR && ast->tokens[level->body[1].start].carry == OPERATOR_HASH) {
+                    hoistInvariants(ast, globals, written, &level->body[2], skip, loop);
+                    level = unwrapExpression(&level->body[0]);
+                }
+                hoistInvariants(ast, globals, written, level, skip, loop);
+                return;
+            }
+            // other expressions are hoisted whole when they're invariant
+            // fall through
+        case NODE_UNARY_EXPRESSION:
+        case NODE_ARRAY_EXPRESSION:
+        case NODE_FUNCTION_IDENTIFIER:
+            if (isLoopInvariant(ast, globals, written, node, node->type == NODE_FUNCTION_IDENTIFIER)) {
+                node->invariant = addInvariantSlot(ast, loop);
+                return;
+            }
+            break;
+    }
+    for (int i = 0; i < length; i++) {
+        hoistInvariants(ast, globals, written, &node->body[i], skip, loop);
+    }
+}
+
+void markBoundedIndices (AST* ast, Scope* globals, const char** written, Node* node, const char* variable, int loop) {
+    int length = getNodeBodyLength(node->body);
+    if (node->type == NODE_UNPARSED_BLOCK) return;
+    if (node->type == NODE_EXPRESSION && length == 3 && node->bounds == -1 && node->body[1].type == NODE_OPERATOR && ast->tokens[node->body[1].start].carry == OPERATOR_HASH) {
+        Node* index = unwrapExpression(&node->body[2]);
+        if (index->type == NODE_IDENTIFIER && index->constant == -1 && !strcmp(index->text, variable)) {
+            // the array must be the same for the whole loop, so the levels before this one need invariant indices
+            Node* container = unwrapExpression(&node->body[0]);
+            int invariant = 1;
+            while (invariant && container->type == NODE_EXPRESSION && container->constant == -1) {
+                if (getNodeBodyLength(container->body) != 3 || container->body[1].type != NODE_OPERATOR || ast->tokens[container->body[1].start].carry != OPERATOR_HASH) {
+                    invariant = 0;
+                    break;
+                }
+                invariant = isLoopInvariant(ast, globals, written, &container->body[2], 1);
+                container = unwrapExpression(&container->body[0]);
+            }
+            if (invariant && container->type == NODE_IDENTIFIER && container->constant == -1 && !isWrittenName(written, container->text)) {
+                node->bounds = addInvariantSlot(ast, loop);
+            }
+        }
+    }
+    for (int i = 0; i < length; i++) {
+        markBoundedIndices(ast, globals, written, &node->body[i], variable, loop);
+    }
+}
+
+int addInvariantSlot (AST* ast, int loop) {
+    int index = ast->invariant_count;
+    ast->invariants = realloc(ast->invariants, sizeof(InvariantSlot) * (index + 1));
+    ast->invariants[index].value = createNullTerminatedVariable();
+    ast->invariants[index].bound = -1;
+    ast->invariants[index].loop = loop == -1 ? index : loop;
+    ast->invariants[index].valid = 0;
+    ast->invariant_count++;
+    return index;
+}
+
+int isPureFunction (Scope* globals, const char* name) {
+    static const char* pure[] = PURE_FUNCTIONS;
+    for (int i = 0; pure[i] != NULL; i++) {
+        if (!strcmp(pure[i], name)) {
+            Function* function = getFunction(globals, (char*)name);
+            return function != NULL && function->std_function;
+        }
+    }
+    return 0;
+}
+
+Node* unwrapExpression (Node* node) {
+    while (node->type == NODE_EXPRESSION && getNodeBodyLength(node->body) == 1 && node->constant == -1) {
+        node = &node->body[0];
+    }
+    return node;
+}
+
+Node* createInlineBody (Scope* globals, Function* function) {
+    Node* declaration = function->declaration;
+    if (declaration == NULL || function->return_type.dataType == TYPE_VOID) return NULL;
+    if (function->memo != NULL) return NULL; // the calls keep using the cache
+
+    // the body has to be a single RETURN of one expression
+    Node* body = function->body;
+    if (body->type != NODE_BLOCK || getNodeBodyLength(body->body) != 1) return NULL;
+    Node* statement = &body->body[0];
+    if (statement->type != NODE_FUNCTION_CALL || getNodeBodyLength(statement->body) != 1) return NULL;
+    Node* call = &statement->body[0];
+    if (call->type != NODE_FUNCTION_IDENTIFIER || strcmp(call->body[0].text, "RETURN") || getNodeBodyLength(call->body[1].body) != 1) return NULL;
+    Function* return_function = getFunction(globals, "RETURN");
+    if (return_function == NULL || !return_function->std_function) return NULL;
+
+    Node* returned = &call->body[1].body[0];
+    int size = getInlineSize(globals, returned);
+    if (size == -1 || size > INLINE_BUDGET) return NULL;
+
+    // the returned expression is cast like RETURN does, errors are shown at the RETURN
+    Node expression = createNullTerminatedNode();
+    expression.type = NODE_UNARY_EXPRESSION;
+    expression.start = call->start;
+    expression.end = returned->end;
+    addToBody(&expression.body, createInlineCast(declaration->body[0].start, declaration->body[0].end));
+    Node inlined = cloneNode(returned);
+    markInlineArguments(&inlined, function);
+    addToBody(&expression.body, inlined);
+
+    Node* inline_body = malloc(sizeof(Node));
+    *inline_body = createNullTerminatedNode();
+    inline_body->type = NODE_INLINE_CALL;
+    inline_body->start = call->start;
+    inline_body->end = call->end;
+    addToBody(&inline_body->body, expression);
+
+    // the arguments are cast to the types they're declared with, which are all the tokens before the name
+    for (int i = 0; i < function->arguments_length; i++) {
+        Node* argument = &declaration->body[2].body[i];
+        Node* name = argument;
+        while (name->type != NODE_IDENTIFIER) name = &name->body[1];
+        addToBody(&inline_body->body, createInlineCast(argument->start, name->start - 1));
+    }
+    return inline_body;
+}
+
+int getInlineSize (Scope* globals, const Node* node) {
+    if (node->constant != -1) return 1;
+    switch (node->type) {
+        case NODE_FUNCTION_IDENTIFIER:
+            if (!isPureFunction(globals, node->body[0].text)) return -1;
+            break;
+        case NODE_EXPRESSION:
+        case NODE_UNARY_EXPRESSION:
+        case NODE_LITERAL:
+        case NODE_IDENTIFIER:
+        case NODE_OPERATOR:
+        case NODE_OPERATOR_CAST:
+        case NODE_ARRAY_EXPRESSION:
+        case NODE_ARGUMENTS:
+            break;
+        default:
+            return -1;
+    }
+    int size = 1;
+    int length = getNodeBodyLength(node->body);
+    for (int i = 0; i < length; i++) {
+        int child = getInlineSize(globals, &node->body[i]);
+        if (child == -1) return -1;
+        size += child;
+    }
+    return size;
+}
+
+void markInlineArguments (Node* node, const Function* function) {
+    if (node->constant != -1) return;
+    if (node->type == NODE_IDENTIFIER) {
+        for (int i = 0; i < function->arguments_length; i++) {
+            if (!strcmp(node->text, function->arguments[i].name)) {
+                node->type = NODE_INLINE_ARGUMENT;
+                node->argument = i;
+                return;
+            }
+        }
+        return;
+    }
+    int length = getNodeBodyLength(node->body);
+    // the name of a called function isn't an argument
+    for (int i = node->type == NODE_FUNCTION_IDENTIFIER ? 1 : 0; i < length; i++) {
+        markInlineArguments(&node->body[i], function);
+    }
+}
+
+int isMemoizable (AST* ast, Scope* globals, const Function* function) {
+    const char** locals = malloc(sizeof(char*));
+    locals[0] = NULL;
+    for (int i = 0; i < function->arguments_length; i++) {
+        addWrittenName(&locals, function->arguments[i].name);
+    }
+    collectMemoLocals(ast, function->body, &locals);
+    const char** declared = malloc(sizeof(char*));
+    declared[0] = NULL;
+    for (int i = 0; i < function->arguments_length; i++) {
+        addWrittenName(&declared, function->arguments[i].name);
+    }
+    int pure = !readsUndeclaredLocal(locals, &declared, function->body) && isMemoNodePure(ast, globals, function, locals, function->body);
+    free(declared);
+    free(locals);
+    return pure;
+}
+
+void collectMemoLocals (AST* ast, Node* node, const char*** locals) {
+    int length = getNodeBodyLength(node->body);
+    Node* declaration = node;
+    switch (node->type) {
+        default:
+            break;
+        case NODE_MAKE_VAR:
+        case NODE_ARRAY_DECLARATION:
+            while (getNodeBodyLength(declaration->body) > 1 && declaration->body[1].type != NODE_IDENTIFIER) {
+                declaration = &declaration->body[1];
+            }
+            if (getNodeBodyLength(declaration->body) > 1) addWrittenName(locals, declaration->body[1].text);
+            break;
+        case NODE_EXPRESSION:
+            // FOR loops declare the identifier after AS
+            if (length == 3 && node->body[1].type == NODE_OPERATOR && ast->tokens[node->body[1].start].carry == OPERATOR_AS) addWrittenName(locals, node->body[2].text);
+            break;
+    }
+    for (int i = 0; i < length; i++) {
+        collectMemoLocals(ast, &node->body[i], locals);
+    }
+}
+
+int isMemoNodePure (AST* ast, Scope* globals, const Function* function, const char** locals, const Node* node) {
+    static const char* control[] = CONTROL_FUNCTIONS;
+    static const char* unshadowed[] = {NULL};
+    if (node->constant != -1) return 1;
+    int length = getNodeBodyLength(node->body);
+    int first = 0;
+    switch (node->type) {
+        default:
+            break;
+        case NODE_IMPORT:
+        case NODE_FUNCTION_DECLARATION:
+        case NODE_UNPARSED_BLOCK:
+            return 0;
+        case NODE_IDENTIFIER:
+            // global constants never change, other globals could change between calls
+            return isWrittenName(locals, node->text) || getFoldableConstant(node->text, unshadowed) != NULL;
+        case NODE_FUNCTION_IDENTIFIER: {}
+            const char* name = node->body[0].text;
+            int allowed = isPureFunction(globals, name) || !strcmp(name, function->name);
+            for (int i = 0; control[i] != NULL && !allowed; i++) {
+                allowed = !strcmp(control[i], name);
+            }
+            if (!allowed) {
+                // other MEMO functions were checked when they were declared
+                Function* called = getFunction(globals, (char*)name);
+                allowed = called != NULL && called->memo != NULL;
+            }
+            if (!allowed) return 0;
+            first = 1; // the name of the function isn't a variable
+            break;
+    }
+    for (int i = first; i < length; i++) {
+        if (!isMemoNodePure(ast, globals, function, locals, &node->body[i])) return 0;
+    }
+    return 1;
+}
+
+int isTailCallSafe (AST* ast, const Function* function) {
+    const char** locals = malloc(sizeof(char*));
+    locals[0] = NULL;
+    collectMemoLocals(ast, function->body, &locals);
+    const char** declared = malloc(sizeof(char*));
+    declared[0] = NULL;
+    for (int i = 0; i < function->arguments_length; i++) {
+        addWrittenName(&declared, function->arguments[i].name);
+    }
+    int safe = !readsUndeclaredLocal(locals, &declared, function->body);
+    free(declared);
+    free(locals);
+    return safe;
+}
+
+int readsUndeclaredLocal (const char** locals, const char*** declared, const Node* node) {
+    if (node->constant != -1) return 0;
+    int length = getNodeBodyLength(node->body);
+    int declared_length = 0;
+    while ((*declared)[declared_length] != NULL) declared_length++;
+    int reads = 0;
+    switch (node->type) {
+        default:
+            for (int i = node->type == NODE_FUNCTION_IDENTIFIER ? 1 : 0; i < length && !reads; i++) {
+                reads = readsUndeclaredLocal(locals, declared, &node->body[i]);
+            }
+            return reads;
+        case NODE_FUNCTION_DECLARATION:
+        case NODE_UNPARSED_BLOCK:
+        case NODE_IMPORT:
+            return 1;
+        case NODE_IDENTIFIER:
+            return isWrittenName(locals, node->text) && !isWrittenName(*declared, node->text);
+        case NODE_MAKE_VAR:
+        case NODE_ARRAY_DECLARATION: {}
+            // only the value is read, the name is declared after it
+            const Node* declaration = node;
+            while (getNodeBodyLength(declaration->body) > 1 && declaration->body[1].type != NODE_IDENTIFIER) {
+                declaration = &declaration->body[1];
+            }
+            int declaration_length = getNodeBodyLength(declaration->body);
+            for (int i = 2; i < declaration_length && !reads; i++) {
+                reads = readsUndeclaredLocal(locals, declared, &declaration->body[i]);
+            }
+            if (declaration_length > 1) addWrittenName(declared, declaration->body[1].text);
+            return reads;
+        case NODE_BLOCK:
+        case NODE_FUNCTION_CALL:
+            // the variable of a FOR is declared after it's array is evaluated, for the whole chain
+            for (int i = 0; node->type == NODE_FUNCTION_CALL && i + 1 < length && !reads; i++) {
+                if (node->body[i].type != NODE_FOR && node->body[i].type != NODE_PFOR) continue;
+                const Node* loop = &node->body[i + 1];
+                if (getNodeBodyLength(loop->body) != 3) continue;
+                reads = readsUndeclaredLocal(locals, declared, &loop->body[0]);
+                addWrittenName(declared, loop->body[2].text);
+            }
+            for (int i = 0; i < length && !reads; i++) {
+                if (i > 0 && (node->body[i - 1].type == NODE_FOR || node->body[i - 1].type == NODE_PFOR)) continue;
+                reads = readsUndeclaredLocal(locals, declared, &node->body[i]);
+            }
+            // the variables of the block and the FOR end with it
+            (*declared)[declared_length] = NULL;
+            return reads;
+    }
+}
+
+Node createInlineCast (int first, int last) {
+    // a cast holds the type between it's brackets
+    Node cast = createNullTerminatedNode();
+    cast.type = NODE_OPERATOR_CAST;
+    cast.start = first - 1;
+    cast.end = last + 1;
+    return cast;
+}
+
+const char* getFoldableConstant (const char* name, const char** shadowed) {
+    static const char* foldable[] = FOLDABLE_CONSTANTS;
+    for (int i = 0; shadowed[i] != NULL; i++) {
+        if (!strcmp(shadowed[i], name)) return NULL;
+    }
+    for (int i = 0; foldable[i] != NULL; i++) {
+        if (!strcmp(foldable[i], name)) return foldable[i];
+    }
+    return NULL;
+}
+
+#endif
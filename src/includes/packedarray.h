@@ -0,0 +1,158 @@
+/**
+ * @author Sebastiaan Heins
+ * @file packedarray.h
+ * @brief Chooses between the packed forms of arrays (bits and matrices) and the plain list of variables, and refrences the elements of packed arrays
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef PACKED_ARRAY_H
+#define PACKED_ARRAY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "token.h"
+#include "bitarray.h"
+#include "matrix.h"
+
+/**
+ * @brief A refrence to one element of a packed array, the value is written back to the element by commitRefrence
+*/
+typedef struct {
+    void* target; // the BitArray or Matrix, NULL when nothing is refrenced
+    long long int index; // the bit or the offset of the element
+    Variable value;
+} ElementRefrence;
+
+/**
+ * @brief Get whether or not the value of a variable is stored in a packed form
+ * @param variable The variable to check
+ * @return Whether or not the variable is packed
+*/
+int isPackedArray (const Variable* variable);
+
+/**
+ * @brief Store an array in it's packed form when it has one, BOOL arrays become bits and rectangular arrays of arrays of numbers become a matrix
+ * @param variable The variable to pack, variables of other types and jagged arrays are left untouched
+*/
+void packArray (Variable* variable);
+
+/**
+ * @brief Turn a packed array back into a list of variables
+ * @param variable The variable to unpack, variables that aren't packed are left untouched
+ * @note Only the array itself is unpacked, the elements of an unpacked matrix are matrices with one dimension less
+*/
+void unpackArray (Variable* variable);
+
+/**
+ * @brief Unpack an array and all of the packed arrays inside it, for code that walks every level of an array
+ * @param variable The variable to unpack
+*/
+void unpackNestedArrays (Variable* variable);
+
+/**
+ * @brief Refrence a bit of a packed array, the value of the refrence holds the current value of the bit
+ * @param refrence The refrence to fill, the old value is destroyed
+ * @param bits The packed array
+ * @param index The position of the bit
+ * @param constant Whether or not the array is constant
+*/
+void refrenceBit (ElementRefrence* refrence, BitArray* bits, int index, int constant);
+
+/**
+ * @brief Refrence an element of a matrix, the value of the refrence holds the current value of the element
+ * @param refrence The refrence to fill, the old value is destroyed
+ * @param matrix The matrix
+ * @param offset The offset of the element
+ * @param constant Whether or not the matrix is constant
+*/
+void refrenceMatrixElement (ElementRefrence* refrence, Matrix* matrix, long long int offset, int constant);
+
+/**
+ * @brief Write the value of a refrence back to it's element, and release the refrence
+ * @param refrence The refrence
+ * @return The error code
+*/
+int commitRefrence (ElementRefrence* refrence);
+
+
+int isPackedArray (const Variable* variable) {
+    return isBitArray(variable) || isMatrix(variable);
+}
+
+void packArray (Variable* variable) {
+    if (!variable->type.array || variable->value == NULL || isPackedArray(variable)) return;
+
+    if (variable->type.dataType == TYPE_BOOL) {
+        if (variable->type.array == 1) {
+            packBits(variable);
+            return;
+        }
+        Variable* array = (Variable*)variable->value;
+        int length = getVariablesLength(array);
+        for (int i = 0; i < length; i++) {
+            packArray(&array[i]);
+        }
+        return;
+    }
+    // a list of numbers is already one block, only arrays of arrays gain from a matrix
+    if (variable->type.array > 1 && isMatrixType(variable->type.dataType)) packMatrix(variable);
+}
+
+void unpackArray (Variable* variable) {
+    if (isBitArray(variable)) {
+        unpackBits(variable);
+    } else if (isMatrix(variable)) {
+        unpackMatrix(variable);
+    }
+}
+
+void unpackNestedArrays (Variable* variable) {
+    if (variable->type.array == 0 || variable->value == NULL) return;
+    unpackArray(variable);
+    if (variable->type.array == 1) return;
+    Variable* array = (Variable*)variable->value;
+    int length = getVariablesLength(array);
+    for (int i = 0; i < length; i++) {
+        unpackNestedArrays(&array[i]);
+    }
+}
+
+void refrenceBit (ElementRefrence* refrence, BitArray* bits, int index, int constant) {
+    destroyVariable(&refrence->value);
+    int* value = allocValue(sizeof(int));
+    *value = getBit(bits, index);
+    refrence->value = createVariable(NULL, TYPE_BOOL, value, constant, 0);
+    refrence->target = bits;
+    refrence->index = index;
+}
+
+void refrenceMatrixElement (ElementRefrence* refrence, Matrix* matrix, long long int offset, int constant) {
+    destroyVariable(&refrence->value);
+    void* value = allocValue(matrix->element_size);
+    memcpy(value, getMatrixData(matrix) + offset * matrix->element_size, matrix->element_size);
+    refrence->value = createVariable(NULL, matrix->element_type, value, constant, 0);
+    refrence->target = matrix;
+    refrence->index = offset;
+}
+
+int commitRefrence (ElementRefrence* refrence) {
+    if (refrence->target == NULL) return 0;
+    int cRes = 0;
+    if (((BitArray*)refrence->target)->type.dataType == TYPE_BITS) {
+        BitArray* bits = (BitArray*)refrence->target;
+        cRes = castValue(&refrence->value, (Type){TYPE_BOOL, 0});
+        if (!cRes) setBit(bits, refrence->index, *(int*)refrence->value.value != 0);
+    } else {
+        Matrix* matrix = (Matrix*)refrence->target;
+        cRes = castValue(&refrence->value, (Type){matrix->element_type, 0});
+        if (!cRes) memcpy(getMatrixData(matrix) + refrence->index * matrix->element_size, refrence->value.value, matrix->element_size);
+    }
+    destroyVariable(&refrence->value);
+    refrence->target = NULL;
+    return cRes;
+}
+
+#endif
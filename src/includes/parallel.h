@@ -0,0 +1,810 @@
+/**
+ * @author Sebastiaan Heins
+ * @file parallel.h
+ * @brief Runs the iterations of a PFOR on a pool of worker threads, every worker takes iterations from it's own range and steals from the others when it runs out
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include "ast.h"
+#include "scope.h"
+#include "allocator.h"
+#include "process.h"
+
+#define PARALLEL_STACK_SIZE (64 * 1024 * 1024) // the C stack of a worker thread, so deep calls in a loop fit like they do on the main thread
+
+/**
+ * @brief What the iterations of a PFOR write outside of their own variables, a loop only runs in parallel when the iterations can't see each other's writes
+*/
+typedef struct {
+    const char* variable; // the loop variable
+    const char** locals; // the null terminated names the iterations declare, including the loop variable
+    const char** arrays; // the null terminated outer arrays the iterations write the element of the loop variable of
+    int* depths; // for every array, the least amount of indices it's used with
+    const char** reductions; // the null terminated outer variables the iterations add to, subtract from or multiply
+    OperatorType* operators; // for every reduction, OPERATOR_ADD_ASSIGN or OPERATOR_MULTIPLY_ASSIGN to combine the results of the workers
+    const Function** functions; // the null terminated functions the iterations call, they're checked once
+} ParallelAccess;
+
+typedef struct ParallelLoop ParallelLoop;
+
+/**
+ * @brief A thread running iterations of a PFOR, with it's own copy of the process, scopes, _ and reductions
+*/
+typedef struct {
+    ParallelLoop* loop;
+    int id;
+    int next, end; // the iterations left in the range of the worker, other workers may take the end of it
+    #ifndef _WIN32
+    pthread_mutex_t lock;
+    #endif
+    int started; // whether or not the worker has made it's copy of the process
+    Allocator* allocator; // the values the worker makes, merged into the allocator of the process when the loop ends
+    Process process;
+    Scope* scope; // the copy of the scope the loop runs in, the iterations run their chain in it
+    Variable last; // the _ the last iteration left, when the worker ran it
+    int error_index; // the iteration that failed, -1 when none did
+} ParallelWorker;
+
+/**
+ * @brief The shared state of the workers of a PFOR
+*/
+struct ParallelLoop {
+    Process* process;
+    Scope* scope; // the scope the loop runs in
+    Statement* statement; // the statement of the loop
+    ParallelAccess* access;
+    Variable* elements; // the elements of the loop, every iteration takes the value of it's element
+    int length;
+    ParallelWorker* workers;
+    int worker_count;
+    int failed_index; // the first iteration that failed, the length while none has, the workers only take the iterations before it
+};
+
+/**
+ * @brief Check if the iterations of a PFOR can run at the same time, and collect what they write
+ * @param process The process to run
+ * @param statement The statement of the loop
+ * @param access Filled with what the iterations write (must be destroyed after use)
+ * @return Whether or not the loop can run in parallel
+ * @note The check is conservative, the iterations may only write their own variables, the element of an outer array at the loop variable, and add to or multiply an outer whole number
+*/
+int checkParallelLoop (Process* process, Statement* statement, ParallelAccess* access);
+
+/**
+ * @brief Destroy the lists of a parallel access
+ * @param access The access to destroy
+*/
+void destroyParallelAccess (ParallelAccess* access);
+
+/**
+ * @brief Check if the values the loop runs over and the variables it writes let the iterations run at the same time
+ * @param process The process to run
+ * @param access What the iterations write
+ * @param elements The elements of the loop
+ * @return Whether or not the loop can run in parallel
+ * @note Every iteration must write a different element of every array, so the elements have to be distinct indices into it
+*/
+int checkParallelValues (Process* process, const ParallelAccess* access, const Variable* elements);
+
+/**
+ * @brief Collect the variables a node of a PFOR writes, failing for the writes other iterations could see
+ * @param ast The AST the node belongs to
+ * @param access The access to add the writes to
+ * @param node The node to search
+ * @return Whether or not the writes are allowed
+*/
+int collectParallelWrites (AST* ast, ParallelAccess* access, Node* node);
+
+/**
+ * @brief Add a write of a PFOR to it's access
+ * @param ast The AST the write belongs to
+ * @param access The access of the loop
+ * @param target The expression that is written to
+ * @param operator The assignment operator
+ * @return Whether or not the write is allowed
+*/
+int addParallelWrite (AST* ast, ParallelAccess* access, Node* target, OperatorType operator);
+
+/**
+ * @brief Check if a node of a PFOR only reads what the other iterations don't write, and only calls functions that do the same
+ * @param process The process to run
+ * @param ast The AST the node belongs to
+ * @param access What the iterations write
+ * @param node The node to check
+ * @param blocks The amount of blocks of the loop around the node, a CONTINUE needs one to end
+ * @return Whether or not the node is allowed
+*/
+int checkParallelReads (Process* process, AST* ast, ParallelAccess* access, Node* node, int blocks);
+
+/**
+ * @brief Check if a function called by a PFOR only writes it's own variables and doesn't read what the iterations write
+ * @param process The process to run
+ * @param access What the iterations write, the function is added to it's functions
+ * @param function The function
+ * @return Whether or not the function may be called
+*/
+int checkParallelFunction (Process* process, ParallelAccess* access, const Function* function);
+
+/**
+ * @brief Check a node of a function called by a PFOR
+ * @param process The process to run
+ * @param access What the iterations write
+ * @param locals The null terminated names the function declares, including it's arguments
+ * @param ast The AST the node belongs to
+ * @param node The node to check
+ * @return Whether or not the node is allowed
+*/
+int checkParallelFunctionNode (Process* process, ParallelAccess* access, const char** locals, AST* ast, Node* node);
+
+/**
+ * @brief Check if a call to a function is allowed in a PFOR
+ * @param process The process to run
+ * @param access What the iterations write
+ * @param call The call
+ * @param loop Whether or not the call is in the chain of the loop itself, where only CONTINUE may change the flow
+ * @param blocks The amount of blocks of the loop around the call
+ * @return Whether or not the call is allowed
+*/
+int checkParallelCall (Process* process, ParallelAccess* access, Node* call, int loop, int blocks);
+
+/**
+ * @brief Get the variable an index chain (a#i#j) starts at
+ * @param ast The AST the chain belongs to
+ * @param node The chain
+ * @param first Filled with the first index of the chain
+ * @param depth Filled with the amount of indices
+ * @return The identifier of the variable, or NULL when the node isn't an index chain on a variable
+*/
+Node* getParallelChainRoot (AST* ast, Node* node, Node** first, int* depth);
+
+/**
+ * @brief Check if a name is written by other iterations of a PFOR, as an array or a reduction
+ * @param access What the iterations write
+ * @param name The name
+ * @return Whether or not the name is shared between the iterations
+*/
+int isParallelShared (const ParallelAccess* access, const char* name);
+
+/**
+ * @brief Get the position of a name in a null terminated list of names
+ * @param names The list
+ * @param name The name
+ * @return The position, -1 when the name isn't in the list
+*/
+int getNamePosition (const char** names, const char* name);
+
+/**
+ * @brief Run the iterations of a worker until there are none left, the main thread runs the first worker itself
+ * @param worker The worker
+ * @return NULL
+*/
+void* runParallelWorker (void* worker);
+
+/**
+ * @brief Take the next iteration of a worker, stealing half of the iterations another worker has left when it's own range is empty
+ * @param worker The worker
+ * @return The iteration, -1 when all of the iterations before the first one that failed are taken
+*/
+int takeIteration (ParallelWorker* worker);
+
+/**
+ * @brief Run an iteration of a PFOR in a worker
+ * @param worker The worker
+ * @param index The iteration
+ * @return The exit code of the iteration
+*/
+int runParallelIteration (ParallelWorker* worker, int index);
+
+/**
+ * @brief Make the copy of the process a worker runs in, with copies of the scopes up to the loop that share the values of their variables
+ * @param worker The worker, it's allocator must be active
+*/
+void createWorkerProcess (ParallelWorker* worker);
+
+/**
+ * @brief Destroy the copy of the process of a worker, the values it shares with the process are left alone
+ * @param worker The worker, it's allocator must have been merged
+*/
+void destroyWorkerProcess (ParallelWorker* worker);
+
+/**
+ * @brief Copy a scope for a worker, the copy has it's own list of variables holding the same values
+ * @param scope The scope to copy
+ * @return The copy, it's child isn't set
+*/
+Scope copyWorkerScope (const Scope* scope);
+
+
+int runParallelFor (Process* process, Scope* scope, Node* loop) {
+    #ifdef _WIN32
+    return -1; // there are no worker threads here
+    #else
+    // a PFOR in a worker runs on the thread of the worker
+    if (process->worker) return -1;
+    Statement* statement = &scope->statement;
+    Variable* elements = (Variable*)statement->loop_array.value;
+    int length = getVariablesLength(elements);
+    int worker_count = process->threads > 0 ? process->threads : getCoreCount();
+    if (worker_count > length) worker_count = length;
+    if (worker_count < 2) return -1;
+
+    ParallelAccess access;
+    if (!checkParallelLoop(process, statement, &access) || !checkParallelValues(process, &access, elements)) {
+        destroyParallelAccess(&access);
+        return -1;
+    }
+
+    ParallelLoop parallel = { process, scope, statement, &access, elements, length, NULL, worker_count, length };
+    parallel.workers = malloc(sizeof(ParallelWorker) * worker_count);
+    for (int i = 0; i < worker_count; i++) {
+        ParallelWorker* worker = &parallel.workers[i];
+        worker->loop = &parallel;
+        worker->id = i;
+        worker->next = (int)((long long int)length * i / worker_count);
+        worker->end = (int)((long long int)length * (i + 1) / worker_count);
+        pthread_mutex_init(&worker->lock, NULL);
+        worker->started = 0;
+        worker->allocator = createAllocator();
+        worker->allocator->parent = process->allocator;
+        worker->allocator->trim_threshold = process->allocator->trim_threshold;
+        worker->scope = NULL;
+        worker->last = createNullTerminatedVariable();
+        worker->error_index = -1;
+    }
+
+    // the range of a worker that couldn't start is stolen by the others
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, PARALLEL_STACK_SIZE);
+    pthread_t* threads = malloc(sizeof(pthread_t) * worker_count);
+    int* created = calloc(worker_count, sizeof(int));
+    for (int i = 1; i < worker_count; i++) {
+        created[i] = pthread_create(&threads[i], &attributes, runParallelWorker, &parallel.workers[i]) == 0;
+    }
+    runParallelWorker(&parallel.workers[0]); // this thread works along
+    for (int i = 1; i < worker_count; i++) {
+        if (created[i]) pthread_join(threads[i], NULL);
+    }
+    pthread_attr_destroy(&attributes);
+    free(threads);
+    free(created);
+
+    for (int i = 0; i < worker_count; i++) {
+        mergeAllocator(process->allocator, parallel.workers[i].allocator);
+    }
+    active_allocator = process->allocator;
+
+    // the error of the first iteration that failed is reported
+    ParallelWorker* failed = NULL;
+    for (int i = 0; i < worker_count; i++) {
+        ParallelWorker* worker = &parallel.workers[i];
+        if (worker->error_index != -1 && (failed == NULL || worker->error_index < failed->error_index)) failed = worker;
+    }
+    int code = 0;
+    if (failed != NULL) {
+        code = error(process, failed->process.error_ast_index, failed->process.error_code, failed->process.error_location);
+    } else {
+        for (int i = 0; i < worker_count; i++) {
+            ParallelWorker* worker = &parallel.workers[i];
+            if (worker->last.type.dataType != D_NULL) setReturnValue(process, &worker->last);
+        }
+
+        // the reductions of the workers are combined in the order of the workers
+        for (int i = 0; access.reductions[i] != NULL && !code; i++) {
+            Variable* total = getVariable(&process->main_scope, (char*)access.reductions[i]);
+            for (int j = 0; j < worker_count && !code; j++) {
+                ParallelWorker* worker = &parallel.workers[j];
+                if (!worker->started) continue;
+                Variable part = cloneVariable(getVariable(&worker->process.main_scope, (char*)access.reductions[i]));
+                int set_res = setVariableValue(total, &part, access.operators[i]);
+                destroyLiteral(&part);
+                if (set_res) code = error(process, scope->running_ast, set_res, getTokenStart(process, loop->start));
+            }
+        }
+    }
+
+    for (int i = 0; i < worker_count; i++) {
+        if (parallel.workers[i].started) destroyWorkerProcess(&parallel.workers[i]);
+        pthread_mutex_destroy(&parallel.workers[i].lock);
+    }
+    free(parallel.workers);
+    destroyParallelAccess(&access);
+    return code;
+    #endif
+}
+
+int checkParallelLoop (Process* process, Statement* statement, ParallelAccess* access) {
+    Node* func = statement->node;
+    AST* ast = &process->code[process->running_ast];
+    access->variable = func->body[statement->end + 1].body[2].text;
+    access->locals = malloc(sizeof(char*));
+    access->locals[0] = NULL;
+    access->arrays = malloc(sizeof(char*));
+    access->arrays[0] = NULL;
+    access->depths = malloc(sizeof(int));
+    access->reductions = malloc(sizeof(char*));
+    access->reductions[0] = NULL;
+    access->operators = malloc(sizeof(OperatorType));
+    access->functions = malloc(sizeof(Function*));
+    access->functions[0] = NULL;
+
+    addWrittenName(&access->locals, access->variable);
+    for (int i = statement->start; i < statement->end; i++) {
+        collectMemoLocals(ast, &func->body[i], &access->locals);
+    }
+    for (int i = statement->start; i < statement->end; i++) {
+        if (!collectParallelWrites(ast, access, &func->body[i])) return 0;
+    }
+    for (int i = statement->start; i < statement->end; i++) {
+        if (!checkParallelReads(process, ast, access, &func->body[i], 0)) return 0;
+    }
+    return 1;
+}
+
+void destroyParallelAccess (ParallelAccess* access) {
+    free(access->locals);
+    free(access->arrays);
+    free(access->depths);
+    free(access->reductions);
+    free(access->operators);
+    free(access->functions);
+}
+
+int checkParallelValues (Process* process, const ParallelAccess* access, const Variable* elements) {
+    // the iterations must not find the variables they declare already there, that is an error the loop reports one by one
+    for (int i = 0; access->locals[i] != NULL; i++) {
+        if (access->locals[i] != access->variable && getVariable(&process->main_scope, (char*)access->locals[i]) != NULL) return 0;
+    }
+
+    for (int i = 0; access->reductions[i] != NULL; i++) {
+        Variable* variable = getVariable(&process->main_scope, (char*)access->reductions[i]);
+        // adding floats up in another order changes the result, so only whole numbers are split over the workers
+        if (variable == NULL || variable->constant || variable->type.array || !checkIfNumber(variable->type.dataType) || checkIfFloating(variable->type.dataType)) return 0;
+    }
+
+    // bits share their bytes, and a part of a matrix can only be written by unpacking it
+    long long int bound = -1;
+    for (int i = 0; access->arrays[i] != NULL; i++) {
+        Variable* variable = getVariable(&process->main_scope, (char*)access->arrays[i]);
+        if (variable == NULL || variable->constant || !variable->type.array || variable->value == NULL || isBitArray(variable)) return 0;
+        if (isMatrix(variable) && access->depths[i] < ((Matrix*)variable->value)->dimensions) return 0;
+        long long int length = getVariablesLength((Variable*)variable->value);
+        if (bound == -1 || length < bound) bound = length;
+    }
+    if (bound == -1) return 1;
+
+    // an index that is out of bounds or taken twice leaves the loop to report it or to write it in order
+    char* taken = calloc(bound + 1, sizeof(char));
+    int distinct = 1;
+    for (int i = 0; elements[i].type.dataType != D_NULL && distinct; i++) {
+        Variable* element = (Variable*)&elements[i];
+        if (element->type.array || !checkIfNumber(element->type.dataType) || checkIfFloating(element->type.dataType)) {
+            distinct = 0;
+            break;
+        }
+        long long int index = getSignedNumber(element);
+        distinct = index >= 0 && index < bound && !taken[index];
+        if (distinct) taken[index] = 1;
+    }
+    free(taken);
+    return distinct;
+}
+
+int collectParallelWrites (AST* ast, ParallelAccess* access, Node* node) {
+    int length = getNodeBodyLength(node->body);
+    switch (node->type) {
+        default:
+            break;
+        case NODE_IMPORT:
+        case NODE_FUNCTION_DECLARATION:
+        case NODE_UNPARSED_BLOCK:
+            return 0;
+        case NODE_SET_VAR:
+            if (length != 3 || !addParallelWrite(ast, access, &node->body[0], ast->tokens[node->body[1].start].carry)) return 0;
+            break;
+        case NODE_FUNCTION_CALL:
+            for (int i = 0; i < length - 1; i++) {
+                if (node->body[i].type == NODE_INTO && !addParallelWrite(ast, access, &node->body[i + 1], OPERATOR_ASSIGN)) return 0;
+            }
+            break;
+    }
+    for (int i = 0; i < length; i++) {
+        if (!collectParallelWrites(ast, access, &node->body[i])) return 0;
+    }
+    return 1;
+}
+
+int addParallelWrite (AST* ast, ParallelAccess* access, Node* target, OperatorType operator) {
+    Node* identifier = unwrapExpression(target);
+    if (identifier->type == NODE_IDENTIFIER) {
+        if (!strcmp(identifier->text, access->variable)) return 0; // the loop variable decides which elements are written
+        if (isWrittenName(access->locals, identifier->text)) return 1;
+
+        // every worker adds to or multiplies it's own copy, the copies are combined afterwards
+        if (operator != OPERATOR_ADD_ASSIGN && operator != OPERATOR_SUBTRACT_ASSIGN && operator != OPERATOR_MULTIPLY_ASSIGN) return 0;
+        OperatorType combine = operator == OPERATOR_MULTIPLY_ASSIGN ? OPERATOR_MULTIPLY_ASSIGN : OPERATOR_ADD_ASSIGN;
+        if (isWrittenName(access->arrays, identifier->text)) return 0;
+        int position = getNamePosition(access->reductions, identifier->text);
+        if (position != -1) return access->operators[position] == combine;
+        addWrittenName(&access->reductions, identifier->text);
+        int length = getNamePosition(access->reductions, identifier->text);
+        access->operators = realloc(access->operators, sizeof(OperatorType) * (length + 1));
+        access->operators[length] = combine;
+        return 1;
+    }
+
+    Node* first = NULL;
+    int depth = 0;
+    identifier = getParallelChainRoot(ast, target, &first, &depth);
+    if (identifier == NULL) return 0;
+    if (isWrittenName(access->locals, identifier->text)) return 1;
+
+    // only the element at the loop variable belongs to the iteration
+    first = unwrapExpression(first);
+    if (first->type != NODE_IDENTIFIER || first->constant != -1 || strcmp(first->text, access->variable)) return 0;
+    if (isWrittenName(access->reductions, identifier->text)) return 0;
+    int position = getNamePosition(access->arrays, identifier->text);
+    if (position == -1) {
+        addWrittenName(&access->arrays, identifier->text);
+        position = getNamePosition(access->arrays, identifier->text);
+        access->depths = realloc(access->depths, sizeof(int) * (position + 1));
+        access->depths[position] = depth;
+    }
+    if (depth < access->depths[position]) access->depths[position] = depth;
+    return 1;
+}
+
+int checkParallelReads (Process* process, AST* ast, ParallelAccess* access, Node* node, int blocks) {
+    if (node->constant != -1) return 1;
+    int length = getNodeBodyLength(node->body);
+    int first = 0;
+    switch (node->type) {
+        default:
+            break;
+        case NODE_IMPORT:
+        case NODE_FUNCTION_DECLARATION:
+        case NODE_UNPARSED_BLOCK:
+            return 0;
+        case NODE_INLINE_ARGUMENT:
+            return 1;
+        case NODE_IDENTIFIER:
+            return isWrittenName(access->locals, node->text) || !isParallelShared(access, node->text);
+        case NODE_BLOCK:
+            blocks++;
+            break;
+        case NODE_SET_VAR: {}
+            // the target of a reduction is only written
+            Node* target = unwrapExpression(&node->body[0]);
+            if (target->type == NODE_IDENTIFIER && isWrittenName(access->reductions, target->text) && !isWrittenName(access->locals, target->text)) first = 1;
+            break;
+        case NODE_EXPRESSION: {}
+            Node* index = NULL;
+            int depth = 0;
+            Node* array = getParallelChainRoot(ast, node, &index, &depth);
+            if (array == NULL || isWrittenName(access->locals, array->text)) break;
+            int position = getNamePosition(access->arrays, array->text);
+            if (position == -1) break;
+
+            // an element of a written array is only read by the iteration it belongs to
+            index = unwrapExpression(index);
+            if (index->type != NODE_IDENTIFIER || index->constant != -1 || strcmp(index->text, access->variable)) return 0;
+            if (depth < access->depths[position]) access->depths[position] = depth;
+            for (Node* level = unwrapExpression(node); level != array; level = unwrapExpression(&level->body[0])) {
+                if (!checkParallelReads(process, ast, access, &level->body[2], blocks)) return 0;
+            }
+            return 1;
+        case NODE_FUNCTION_IDENTIFIER:
+            if (!checkParallelCall(process, access, node, 1, blocks)) return 0;
+            first = 1; // the name of the function isn't a variable
+            break;
+    }
+    for (int i = first; i < length; i++) {
+        if (!checkParallelReads(process, ast, access, &node->body[i], blocks)) return 0;
+    }
+    return 1;
+}
+
+int checkParallelFunction (Process* process, ParallelAccess* access, const Function* function) {
+    int length = 0;
+    while (access->functions[length] != NULL) {
+        if (access->functions[length] == function) return 1; // already checked, or being checked by a call it makes to itself
+        length++;
+    }
+    access->functions = realloc(access->functions, sizeof(Function*) * (length + 2));
+    access->functions[length] = function;
+    access->functions[length + 1] = NULL;
+
+    // the workers can't parse the body, they share the AST (a body with an error is left to the call to report)
+    if (prepareFunction(process, (Function*)function)) return 0;
+
+    AST* ast = &process->code[function->ast_index];
+    const char** locals = malloc(sizeof(char*));
+    locals[0] = NULL;
+    for (int i = 0; i < function->arguments_length; i++) {
+        addWrittenName(&locals, function->arguments[i].name);
+    }
+    collectMemoLocals(ast, function->body, &locals);
+    int allowed = checkParallelFunctionNode(process, access, locals, ast, function->body);
+    free(locals);
+    return allowed;
+}
+
+int checkParallelFunctionNode (Process* process, ParallelAccess* access, const char** locals, AST* ast, Node* node) {
+    if (node->constant != -1) return 1;
+    int length = getNodeBodyLength(node->body);
+    int first = 0;
+    Node* target = NULL;
+    switch (node->type) {
+        default:
+            break;
+        case NODE_IMPORT:
+        case NODE_FUNCTION_DECLARATION:
+        case NODE_UNPARSED_BLOCK:
+            return 0;
+        case NODE_INLINE_ARGUMENT:
+            return 1;
+        case NODE_IDENTIFIER:
+            return isWrittenName(locals, node->text) || !isParallelShared(access, node->text);
+        case NODE_SET_VAR:
+            target = &node->body[0];
+            break;
+        case NODE_FUNCTION_CALL:
+            for (int i = 0; i < length - 1; i++) {
+                if (node->body[i].type == NODE_INTO) target = &node->body[i + 1];
+            }
+            break;
+        case NODE_FUNCTION_IDENTIFIER:
+            if (!checkParallelCall(process, access, node, 0, 0)) return 0;
+            first = 1;
+            break;
+    }
+
+    // a function only writes it's own variables
+    if (target != NULL) {
+        Node* index = NULL;
+        int depth = 0;
+        Node* identifier = unwrapExpression(target);
+        if (identifier->type != NODE_IDENTIFIER) identifier = getParallelChainRoot(ast, target, &index, &depth);
+        if (identifier == NULL || !isWrittenName(locals, identifier->text)) return 0;
+    }
+    for (int i = first; i < length; i++) {
+        if (!checkParallelFunctionNode(process, access, locals, ast, &node->body[i])) return 0;
+    }
+    return 1;
+}
+
+int checkParallelCall (Process* process, ParallelAccess* access, Node* call, int loop, int blocks) {
+    static const char* control[] = CONTROL_FUNCTIONS;
+    const char* name = call->body[0].text;
+    if (isPureFunction(&process->main_scope, name)) return 1;
+    for (int i = 0; control[i] != NULL; i++) {
+        if (strcmp(control[i], name)) continue;
+        // in the loop a BREAK or RETURN would end the other iterations too, a CONTINUE only ends the block it's in
+        return !loop || (!strcmp(name, "CONTINUE") && blocks > 0);
+    }
+    Function* function = getFunction(&process->main_scope, (char*)name);
+    if (function == NULL || function->std_function) return 0;
+    return checkParallelFunction(process, access, function);
+}
+
+Node* getParallelChainRoot (AST* ast, Node* node, Node** first, int* depth) {
+    Node* level = unwrapExpression(node);
+    *depth = 0;
+    while (level->type == NODE_EXPRESSION && level->constant == -1 && getNodeBodyLength(level->body) == 3 && level->body[1].type == NODE_OPERATOR && ast->tokens[level->body[1].start].carry == OPERATOR_HASH) {
+        *first = &level->body[2];
+        (*depth)++;
+        level = unwrapExpression(&level->body[0]);
+    }
+    if (*depth == 0 || level->type != NODE_IDENTIFIER || level->constant != -1) return NULL;
+    return level;
+}
+
+int isParallelShared (const ParallelAccess* access, const char* name) {
+    return isWrittenName(access->arrays, name) || isWrittenName(access->reductions, name);
+}
+
+int getNamePosition (const char** names, const char* name) {
+    for (int i = 0; names[i] != NULL; i++) {
+        if (!strcmp(names[i], name)) return i;
+    }
+    return -1;
+}
+
+void* runParallelWorker (void* data) {
+    ParallelWorker* worker = data;
+    ParallelLoop* loop = worker->loop;
+    active_allocator = worker->allocator;
+    createWorkerProcess(worker);
+    // the first worker runs on the thread of the loop, the others have a stack of their own
+    char stack_base;
+    if (worker != &loop->workers[0]) {
+        worker->process.stack_base = &stack_base;
+        worker->process.stack_size = PARALLEL_STACK_SIZE;
+    }
+    worker->started = 1;
+
+    for (int index = takeIteration(worker); index != -1; index = takeIteration(worker)) {
+        int code = runParallelIteration(worker, index);
+        if (code) {
+            worker->error_index = index;
+            // the iterations before this one still run, like they would in a FOR
+            int failed_index = __atomic_load_n(&loop->failed_index, __ATOMIC_RELAXED);
+            while (index < failed_index && !__atomic_compare_exchange_n(&loop->failed_index, &failed_index, index, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+            break;
+        }
+        if (index == loop->length - 1) worker->last = cloneVariable(getScopeVariable(&worker->process.main_scope, "_"));
+    }
+    active_allocator = NULL;
+    return NULL;
+}
+
+int takeIteration (ParallelWorker* worker) {
+    ParallelLoop* loop = worker->loop;
+    int failed_index = __atomic_load_n(&loop->failed_index, __ATOMIC_RELAXED);
+
+    #ifndef _WIN32
+    pthread_mutex_lock(&worker->lock);
+    #endif
+    int index = worker->next < worker->end && worker->next < failed_index ? worker->next++ : -1;
+    #ifndef _WIN32
+    pthread_mutex_unlock(&worker->lock);
+    #endif
+    if (index != -1) return index;
+
+    // the workers after this one are robbed first, so the thieves spread out
+    for (int i = 1; i < loop->worker_count; i++) {
+        ParallelWorker* victim = &loop->workers[(worker->id + i) % loop->worker_count];
+        #ifndef _WIN32
+        pthread_mutex_lock(&victim->lock);
+        #endif
+        int end = victim->end < failed_index ? victim->end : failed_index;
+        int left = end - victim->next;
+        int first = victim->next + left / 2;
+        if (left > 0) victim->end = first;
+        #ifndef _WIN32
+        pthread_mutex_unlock(&victim->lock);
+        #endif
+        if (left <= 0) continue;
+
+        #ifndef _WIN32
+        pthread_mutex_lock(&worker->lock);
+        #endif
+        worker->next = first + 1;
+        worker->end = end;
+        #ifndef _WIN32
+        pthread_mutex_unlock(&worker->lock);
+        #endif
+        return first;
+    }
+    return -1;
+}
+
+int runParallelIteration (ParallelWorker* worker, int index) {
+    ParallelLoop* loop = worker->loop;
+    Process* process = &worker->process;
+    Scope* scope = worker->scope;
+    Variable* variable = &scope->variables[loop->statement->loop_variable];
+
+    // the loop variable takes over the value of the element, like it does in a FOR
+    variable->value = loop->elements[index].value;
+    loop->elements[index].value = NULL;
+
+    // the chain runs like an IMPORT runs it's statements, without moving the scope to it's next line
+    scope->statement = createStatement();
+    scope->statement.node = loop->statement->node;
+    scope->statement.start = loop->statement->start;
+    scope->statement.end = loop->statement->end;
+    scope->statement.link = loop->statement->start;
+    scope->statement.loop = NODE_PFOR;
+    scope->statement.step = STATEMENT_CHAIN;
+    scope->statement.inline_statement = 1;
+    process->running_ast = scope->running_ast;
+    int code = runStatement(process, scope, 0);
+    while (code == STATEMENT_SUSPENDED) {
+        code = next(process);
+        if (code == STATEMENT_INLINE_END) code = scope->statement.result;
+        else if (!code) code = STATEMENT_SUSPENDED;
+    }
+    destroyValue(variable);
+    return code > 0 ? code : 0;
+}
+
+void createWorkerProcess (ParallelWorker* worker) {
+    ParallelLoop* loop = worker->loop;
+    Process* process = &worker->process;
+    *process = *loop->process;
+    process->running = 1;
+    process->exit_code = 0;
+    process->error_code = 0;
+    process->error_ast_index = 0;
+    process->error_location = 0;
+    process->allocator = worker->allocator;
+    process->element_refrence = (ElementRefrence){ NULL, 0, createNullTerminatedVariable() };
+    process->tail_call = (TailCall){ NULL, NULL, 0 };
+    process->inline_functions = 0; // inlining rewrites the AST the workers share
+    process->inline_function = NULL;
+    process->inline_arguments = NULL;
+    process->worker = 1;
+
+    Scope* copy = &process->main_scope;
+    for (Scope* scope = &loop->process->main_scope; ; scope = scope->child) {
+        *copy = copyWorkerScope(scope);
+        if (scope == loop->scope) break;
+        copy->child = malloc(sizeof(Scope));
+        copy = copy->child;
+    }
+    copy->child = malloc(sizeof(Scope));
+    *copy->child = createNullTerminatedScope();
+    worker->scope = copy;
+
+    // every worker has it's own return value
+    Variable* underscore = getScopeVariable(&process->main_scope, "_");
+    *underscore = cloneVariable(underscore);
+    underscore->name = malloc(sizeof(char) * 2);
+    strcpy(underscore->name, "_");
+    underscore->constant = 1;
+    underscore->literal = 0;
+
+    // and starts the reductions from nothing
+    const ParallelAccess* access = loop->access;
+    for (int i = 0; access->reductions[i] != NULL; i++) {
+        Variable* variable = getVariable(&process->main_scope, (char*)access->reductions[i]);
+        long long int* identity = allocValue(sizeof(long long int));
+        *identity = access->operators[i] == OPERATOR_MULTIPLY_ASSIGN ? 1 : 0;
+        Variable value = createLiteral(TYPE_LONG, identity, 0, 0);
+        castValue(&value, variable->type);
+        variable->value = value.value;
+    }
+}
+
+void destroyWorkerProcess (ParallelWorker* worker) {
+    Process* process = &worker->process;
+    removeChildScope(worker->scope); // the scopes an error left
+
+    const ParallelAccess* access = worker->loop->access;
+    for (int i = 0; access->reductions[i] != NULL; i++) {
+        destroyValue(getVariable(&process->main_scope, (char*)access->reductions[i]));
+    }
+    free(worker->scope->child);
+    destroyVariable(getScopeVariable(&process->main_scope, "_"));
+    destroyValue(&worker->last);
+    destroyVariable(&process->element_refrence.value);
+    clearTailCall(&process->tail_call);
+
+    Scope* scope = &process->main_scope;
+    while (scope != NULL) {
+        Scope* child = scope == worker->scope ? NULL : scope->child;
+        free(scope->variables);
+        free(scope->variable_index);
+        if (scope != &process->main_scope) free(scope);
+        scope = child;
+    }
+}
+
+Scope copyWorkerScope (const Scope* scope) {
+    Scope copy = *scope;
+    copy.variables = malloc(sizeof(Variable) * (scope->variable_count + 1));
+    memcpy(copy.variables, scope->variables, sizeof(Variable) * (scope->variable_count + 1));
+    copy.variable_capacity = scope->variable_count + 1;
+    if (scope->variable_index != NULL) {
+        copy.variable_index = malloc(sizeof(int) * scope->index_capacity);
+        memcpy(copy.variable_index, scope->variable_index, sizeof(int) * scope->index_capacity);
+    }
+    copy.statement = createStatement();
+    copy.child = NULL;
+    return copy;
+}
+
+#endif
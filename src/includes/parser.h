@@ -25,14 +25,181 @@
 */
 Node parse (const char* code, Token* tokens, const int start, const int end, const NodeType type);
 
-Node parse (const char* full_code, Token* tokens, const int start, const int end, const NodeType type) {
+/**
+ * @brief Create an empty node spanning a range of tokens
+ * @param full_code The full code
+ * @param tokens The list of tokens
+ * @param start The index of the first token of the node
+ * @param end The index of the last token of the node
+ * @param type The type of the node
+ * @return The node, without a body
+*/
+Node createNode (const char* full_code, Token* tokens, const int start, const int end, const NodeType type);
+
+/**
+ * @brief Check if a token is the MEMO keyword in front of a function declaration
+ * @param full_code The full code
+ * @param tokens The list of tokens
+ * @param token The index of the token
+ * @return Whether or not the token is MEMO followed by FUNC
+*/
+int isMemoKeyword (const char* full_code, Token* tokens, const int token);
+
+/**
+ * @brief Parse a binary expression using precedence climbing
+ * @param full_code The full code
+ * @param tokens The list of tokens
+ * @param pos The index of the first token, moved past the parsed expression
+ * @param end The index of the last token that may be used
+ * @param max_precedence The highest precedence value (loosest binding) an operator may have to be included
+ * @return The expression node
+*/
+Node parseBinaryExpression (const char* full_code, Token* tokens, int* pos, const int end, const int max_precedence);
+
+/**
+ * @brief Parse an operand, including unary operators and type casts in front of it
+ * @param full_code The full code
+ * @param tokens The list of tokens
+ * @param pos The index of the first token, moved past the parsed operand
+ * @param end The index of the last token that may be used
+ * @return The operand node
+*/
+Node parsePrefixExpression (const char* full_code, Token* tokens, int* pos, const int end);
+
+Node createNode (const char* full_code, Token* tokens, const int start, const int end, const NodeType type) {
     Node root;
     root.start = start;
     root.end = end;
     root.text = getStringFromNode(full_code, tokens, &root);
     root.type = type;
     root.body = NULL;
-    root.validated = 0;
+    root.constant = -1;
+    root.kernel = -1;
+    root.chain = -1;
+    root.invariant = -1;
+    root.bounds = -1;
+    root.argument = -1;
+    return root;
+}
+
+int isMemoKeyword (const char* full_code, Token* tokens, const int token) {
+    int length = tokens[token].end - tokens[token].start + 1;
+    if (tokens[token].type != TOKEN_IDENTIFIER || length != strlen(MEMO_KEYWORD) || strncmp(full_code + tokens[token].start, MEMO_KEYWORD, length)) return 0;
+    return tokens[token + 1].type == TOKEN_VAR_TYPE && tokens[token + 1].carry == TYPE_FUNC;
+}
+
+Node parseBinaryExpression (const char* full_code, Token* tokens, int* pos, const int end, const int max_precedence) {
+    int p_values[] = OPERATOR_PRECEDENCE;
+    int start = *pos;
+    Node left = parsePrefixExpression(full_code, tokens, pos, end);
+
+    // operators of the same precedence are collected in this loop, making them left associative
+    while (*pos <= end && tokens[*pos].type == TOKEN_OPERATOR && p_values[tokens[*pos].carry] <= max_precedence) {
+        int operator = (*pos)++;
+        Node right = parseBinaryExpression(full_code, tokens, pos, end, p_values[tokens[operator].carry] - 1);
+
+        Node expression = createNode(full_code, tokens, start, *pos - 1, NODE_EXPRESSION);
+        addToBody(&expression.body, left);
+        addToBody(&expression.body, createNode(full_code, tokens, operator, operator, NODE_OPERATOR));
+        addToBody(&expression.body, right);
+        left = expression;
+    }
+    return left;
+}
+
+Node parsePrefixExpression (const char* full_code, Token* tokens, int* pos, const int end) {
+    int start = *pos;
+    if (start > end) {
+        printError(full_code, tokens[start].start, ERROR_EXPECTED_EXPRESSION);
+    }
+    Node operand;
+    int block = getBlock(tokens, start);
+    switch (tokens[start].type) {
+        // unary operators bind tighter than any binary operator (e.g. -a#0 is (-a)#0)
+        case TOKEN_OPERATOR:
+            (*pos)++;
+            operand = parsePrefixExpression(full_code, tokens, pos, end);
+            Node unary = createNode(full_code, tokens, start, *pos - 1, NODE_UNARY_EXPRESSION);
+            addToBody(&unary.body, createNode(full_code, tokens, start, start, NODE_OPERATOR));
+            addToBody(&unary.body, operand);
+            return unary;
+        case TOKEN_PARENTHESIS:
+            if (block == start || block > end) {
+                printError(full_code, tokens[start].start, ERROR_INVALID_EXPRESSION);
+            }
+            *pos = block + 1;
+            Node wrapper = createNode(full_code, tokens, start, block, NODE_EXPRESSION);
+            if (tokens[start].carry & BRACKET_SQUARE) {
+                addToBody(&wrapper.body, parse(full_code, tokens, start, block, NODE_ARRAY_EXPRESSION));
+                return wrapper;
+            }
+            if (tokens[start].carry & BRACKET_CURLY) {
+                addToBody(&wrapper.body, parse(full_code, tokens, start + 1, block - 1, NODE_BLOCK_EXPRESSION));
+                return wrapper;
+            }
+            // a type cast is a unary operator as well
+            if (checkIfOnly(tokens, TOKEN_VAR_TYPE, start, block)) {
+                destroyNode(&wrapper);
+                operand = parsePrefixExpression(full_code, tokens, pos, end);
+                Node cast = createNode(full_code, tokens, start, *pos - 1, NODE_UNARY_EXPRESSION);
+                addToBody(&cast.body, createNode(full_code, tokens, start, block, NODE_OPERATOR_CAST));
+                addToBody(&cast.body, operand);
+                return cast;
+            }
+            // parentheses group an expression, the expression takes over their bounds
+            int inner_pos = start + 1;
+            operand = parseBinaryExpression(full_code, tokens, &inner_pos, block - 1, 15);
+            if (inner_pos != block) {
+                printError(full_code, tokens[inner_pos].start, ERROR_INVALID_EXPRESSION);
+            }
+            if (operand.type == NODE_UNARY_EXPRESSION) {
+                destroyNode(&wrapper);
+                return operand;
+            }
+            if (operand.type == NODE_EXPRESSION) {
+                destroyNode(&wrapper);
+                free(operand.text);
+                operand.start = start;
+                operand.end = block;
+                operand.text = getStringFromNode(full_code, tokens, &operand);
+                return operand;
+            }
+            addToBody(&wrapper.body, operand);
+            return wrapper;
+        case TOKEN_IDENTIFIER:
+            if (start + 1 <= end && tokens[start + 1].type == TOKEN_PARENTHESIS && full_code[tokens[start + 1].start] == '(') {
+                block = getBlock(tokens, start + 1);
+                if (block == start + 1 || block > end) {
+                    printError(full_code, tokens[start + 1].start, ERROR_INVALID_EXPRESSION);
+                }
+                *pos = block + 1;
+                Node call = createNode(full_code, tokens, start, block, NODE_EXPRESSION);
+                addToBody(&call.body, parse(full_code, tokens, start, block, NODE_FUNCTION_IDENTIFIER));
+                return call;
+            }
+            (*pos)++;
+            return createNode(full_code, tokens, start, start, NODE_IDENTIFIER);
+        case TOKEN_NUMBER:
+        case TOKEN_STRING:
+            (*pos)++;
+            return createNode(full_code, tokens, start, start, NODE_LITERAL);
+        default:
+            printError(full_code, tokens[start].start, ERROR_EXPECTED_IDENTIFIER);
+            return createNullTerminatedNode();
+    }
+}
+
+Node parse (const char* full_code, Token* tokens, const int start, const int end, const NodeType type) {
+    // expressions are parsed in a single pass, starting at the loosest binding operators
+    if (type == NODE_EXPRESSION) {
+        int pos = start;
+        Node expression = parseBinaryExpression(full_code, tokens, &pos, end, 15);
+        if (pos <= end) {
+            printError(full_code, tokens[pos].start, ERROR_INVALID_EXPRESSION);
+        }
+        return expression;
+    }
+    Node root = createNode(full_code, tokens, start, end, type);
     switch (type) {
         // if the node is a program or a block, check for full lines of code
         case NODE_PROGRAM:
@@ -41,7 +208,7 @@ Node parse (const char* full_code, Token* tokens, const int start, const int end
             for (int i = start; i < end; i++) {
                 if (tokens[i].type == TOKEN_MASTER_KEYWORD) {
                     int full_line = getFullLine(tokens, i);
-                    addToBody(&root.body, parse(full_code, tokens, i+1, full_line, NODE_FUNCTION_CALL + tokens[i].carry));
+                    addToBody(&root.body, parse(full_code, tokens, i+1, full_line, tokens[i].carry == MASTER_IMPORT ? NODE_IMPORT : NODE_FUNCTION_CALL + tokens[i].carry));
                     i = full_line;
                 } else if (tokens[i].type != TOKEN_SEPARATOR) {
                     printError(full_code, tokens[i].start, ERROR_EXPECTED_MASTER);
@@ -128,6 +295,14 @@ Node parse (const char* full_code, Token* tokens, const int start, const int end
             break;
         // when the MAKE keyword is the first keyword, check for a type, an identifier and an expression
         case NODE_MAKE_VAR:
+            // MAKE MEMO FUNC is parsed like MAKE FUNC, the declaration starts at MEMO so the interpreter can tell them apart
+            if (start < end && isMemoKeyword(full_code, tokens, start)) {
+                Node declaration = parse(full_code, tokens, start + 1, end, NODE_MAKE_VAR);
+                declaration.start = start;
+                destroyNode(&root);
+                return declaration;
+            }
+
             // if the first token is not a type, throw an error
             if (tokens[start].type != TOKEN_VAR_TYPE) {
                 printError(full_code, tokens[start].start, ERROR_EXPECTED_TYPE);
@@ -176,7 +351,8 @@ Node parse (const char* full_code, Token* tokens, const int start, const int end
                 if (block_end - 2 - args_end <= 0) {
                     printError(full_code, tokens[args_end + 1].start, ERROR_EMPTY_BLOCK);
                 } 
-                addToBody(&root.body, parse(full_code, tokens, args_end + 2, block_end-1, NODE_BLOCK));
+                // the body is parsed when the function is first called, most functions of a library are never called
+                addToBody(&root.body, createNode(full_code, tokens, args_end + 2, block_end-1, NODE_UNPARSED_BLOCK));
                 break;
             } else if (tokens[start].carry == TYPE_ARRAY) {
                 // add the array type identifier to the body
@@ -223,6 +399,12 @@ Node parse (const char* full_code, Token* tokens, const int start, const int end
             if (tokens[end].type != TOKEN_SEPARATOR) printError(full_code, tokens[end].start, ERROR_EXPECTED_SEPERATOR);
             addToBody(&root.body, parse(full_code, tokens, t_end + 2, end-1, NODE_EXPRESSION));
             break;
+        // when an IMPORT keyword is the first keyword, the rest of the statement is the path of the module
+        case NODE_IMPORT:
+            if (tokens[end].type != TOKEN_SEPARATOR) printError(full_code, tokens[end].start, ERROR_EXPECTED_SEPERATOR);
+            if (start >= end) printError(full_code, tokens[end].start, ERROR_EXPECTED_EXPRESSION);
+            addToBody(&root.body, parse(full_code, tokens, start, end-1, NODE_EXPRESSION));
+            break;
         // if the node is a function identifier, check if arguments are present
         case NODE_FUNCTION_IDENTIFIER:
             if (tokens[start].type != TOKEN_IDENTIFIER) {
@@ -298,106 +480,6 @@ Node parse (const char* full_code, Token* tokens, const int start, const int end
                 addToBody(&root.body, parse(full_code, tokens, start + 3, end, NODE_EXPRESSION));
             }
             break;
-        // binary expressions are expressions that have an operator in the middle (e.g. 1 + 1, true && false, 0b1010 | 0b0101)
-        case NODE_EXPRESSION:
-            if (end - start > 0) {
-                // splitting the expression into blocks of parentheses and operators
-                int p_values[] = OPERATOR_PRECEDENCE;
-                int exit_loop = 0;
-                for (int o = 0; o < (end - start)/2 && !exit_loop; o++) { // o is the offset, discarding the first and last token when parentheses are present
-                    if (tokens[start + o].type == TOKEN_PARENTHESIS && tokens[start + o].carry & (BRACKET_SQUARE | BRACKET_CURLY) && tokens[end - o].type == TOKEN_PARENTHESIS && tokens[end - o].carry & (BRACKET_SQUARE | BRACKET_CURLY)
-                    && getBlock(tokens, start + o) == end - o) {
-                        break; // found an array expression or block expression, don't parse it as a binary expression
-                    }
-                    for (int p = 15; p > 0; p--) { // looping through the precedence values, meaning that the highest precedence is checked first
-                        for (int i = end - o; i >= start + o; i--) { // looping backwards through the tokens
-                            if (tokens[i].type == TOKEN_PARENTHESIS && tokens[i].carry) {
-                                i = getBlockReverse(tokens, i);
-                                if (p == 1 && i != start) { // if the precedence is 1 (it first checked all the other operators), check if the expression is unary with a type cast
-                                    if (tokens[i-1].type == TOKEN_PARENTHESIS && tokens[i-1].carry & BRACKET_ROUND && checkIfOnly(tokens, TOKEN_VAR_TYPE, getBlockReverse(tokens, i-1), i-1)) {
-                                        exit_loop = 1; // exit loop if a type cast has been found
-                                        continue;
-                                    }
-                                }
-                                if (p == 1 && tokens[i-1].type == TOKEN_IDENTIFIER) {
-                                    exit_loop = 1; // exit the loop if a function call has been found
-                                    continue;
-                                }
-                            }
-                            if (tokens[i].type == TOKEN_OPERATOR && p_values[tokens[i].carry] == p) {
-                                if (!(tokens[i-1].type == TOKEN_IDENTIFIER || tokens[i-1].type == TOKEN_STRING || tokens[i-1].type == TOKEN_NUMBER || (full_code[tokens[i-1].start] == ')' && !checkIfOnly(tokens, TOKEN_VAR_TYPE, getBlockReverse(tokens, i-1), i-1)) || full_code[tokens[i-1].start] == ']' || full_code[tokens[i-1].start] == '}')) {
-                                    exit_loop = 1; // exit loop if the token before the operator is not an identifier, string, number or closing bracket (unary operators)
-                                    continue;
-                                }
-                                addToBody(&root.body, parse(full_code, tokens, start + o, i-1, NODE_EXPRESSION));
-                                addToBody(&root.body, parse(full_code, tokens, i, i, NODE_OPERATOR));
-                                addToBody(&root.body, parse(full_code, tokens, i+1, end - o, NODE_EXPRESSION));
-                                return root;
-                            }
-                            if (tokens[i].type == TOKEN_MASTER_KEYWORD || tokens[i].type == TOKEN_EXT || tokens[i].type == TOKEN_SEPARATOR) {
-                                // unexpected token
-                                return root;
-                            }
-                        }
-                    }
-                }
-                // if no operators were found, check if the expression is valid
-                for (int o = 0; o < (end - start + 2)/2; o++) {
-                    if (tokens[start + o].type == TOKEN_PARENTHESIS && tokens[start + o].carry & BRACKET_SQUARE) {
-                        addToBody(&root.body, parse(full_code, tokens, start + o, end - o, NODE_ARRAY_EXPRESSION));
-                        return root;
-                    }
-                    if (tokens[start + o].type == TOKEN_PARENTHESIS && tokens[start + o].carry & BRACKET_CURLY) {
-                        addToBody(&root.body, parse(full_code, tokens, start + o + 1, end - o - 1, NODE_BLOCK_EXPRESSION));
-                        return root;
-                    }
-                    if (tokens[start + o].type == TOKEN_IDENTIFIER && full_code[tokens[start + o + 1].start] == '(') {
-                        addToBody(&root.body, parse(full_code, tokens, start + o, end - o, NODE_FUNCTION_IDENTIFIER));
-                        return root;
-                    }
-                    if (getBlock(tokens, start + o) != end - o) {
-                        if (tokens[start + o].type == TOKEN_OPERATOR || (getBlock(tokens, start + o) != start + o && tokens[start + o].type == TOKEN_PARENTHESIS && tokens[start + o].carry & BRACKET_ROUND && checkIfOnly(tokens, TOKEN_VAR_TYPE, start + o, getBlock(tokens, start + o)))) {
-                            return parse(full_code, tokens, start + o, end - o, NODE_UNARY_EXPRESSION);
-                        }
-                        else {
-                            if (end - o - start + o <= 0) printError(full_code, tokens[start + o].start, ERROR_INVALID_EXPRESSION);
-                            addToBody(&root.body, parse(full_code, tokens, start + o, end - o, NODE_EXPRESSION));
-                        }
-                        return root;
-                    }
-                    
-                    if (o == (end - start + 2)/2 - 1) {
-                        addToBody(&root.body, parse(full_code, tokens, start + o, end - o, NODE_EXPRESSION));
-                        return root;
-                    }
-                }
-                printError(full_code, tokens[start].start, ERROR_INVALID_EXPRESSION);
-            } else if (end - start == 0) {
-                // if the expression is only one token, check if it's a literal or identifier
-                if (tokens[start].type == TOKEN_IDENTIFIER) {
-                    root.type = NODE_IDENTIFIER;
-                } else if (tokens[start].type == TOKEN_NUMBER || tokens[start].type == TOKEN_STRING) {
-                    root.type = NODE_LITERAL;
-                } else {
-                    printError(full_code, tokens[start].start, ERROR_EXPECTED_IDENTIFIER);
-                }
-                break;
-            }
-            printError(full_code, tokens[start].start, ERROR_EXPECTED_EXPRESSION);
-            break;
-        // Unary expressions are expressions that start with an operator (e.g. -1, !true, ~0b1010)
-        case NODE_UNARY_EXPRESSION:
-            if (tokens[start].type != TOKEN_OPERATOR && !(getBlock(tokens, start) - start > 1)) {
-                printError(full_code, tokens[start].start, ERROR_OPERATOR_NOT_UNARY);
-            }
-            if (getBlock(tokens, start) - start > 1) {
-                addToBody(&root.body, parse(full_code, tokens, start, getBlock(tokens, start), NODE_OPERATOR_CAST));
-                addToBody(&root.body, parse(full_code, tokens, getBlock(tokens, start) + 1, end, NODE_EXPRESSION));
-            } else {
-                addToBody(&root.body, parse(full_code, tokens, start, start, NODE_OPERATOR));
-                addToBody(&root.body, parse(full_code, tokens, start+1, end, NODE_EXPRESSION));
-            }
-            break;
         default:
         
             // the rest are base nodes and therefore don't need to be parsed
@@ -14,17 +14,39 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 #include "ast.h"
+#include "astcache.h"
+#include "module.h"
 #include "scope.h"
+#include "allocator.h"
 #include "garbagecollector.h"
 
+#define STACK_SIZE_FALLBACK (8 * 1024 * 1024) // the C stack of the main thread when the system doesn't limit it
+#define STACK_SIZE_WINDOWS (1024 * 1024) // the C stack the linker gives the main thread on windows
+#define STACK_RESERVE (256 * 1024) // the C stack kept free for the standard functions and error handling, at most a quarter of it
+
 typedef struct Process Process;
 
+/**
+ * @brief A call that takes the place of the function that returns it's result, it's made by callFunction once that function has ended
+*/
+typedef struct {
+    Function* function; // NULL when there is no call waiting
+    Variable* args;
+    int args_length;
+} TailCall;
+
 struct Process{
     AST* code;
 
     int debug;
+    int eager_logic; // evaluate both sides of && and || like older versions did, instead of short-circuiting
     int running;
     int exit_code;
 
@@ -32,6 +54,21 @@ struct Process{
     int error_ast_index;
     int error_location;
 
+    int running_ast; // the AST of the code that is running, the same as the running_ast of the last scope
+    char* cache_dir; // the directory of the parsed program cache used for imported modules, NULL when it's disabled
+    const char* version; // the version of the interpreter, part of the key of the cache
+    PreloadedModule* preloaded; // modules parsed before the program runs, moved into code when they're imported
+    Allocator* allocator; // the small values of the process, made active when the process is created
+    ElementRefrence element_refrence; // the element of a packed array the last refrence expression pointed to
+    TailCall tail_call; // the call a RETURN left to callFunction
+    int inline_functions; // replace calls to small functions with the expression they return
+    Function* inline_function; // the function the last callFunction ran, when the call may be replaced by it's inline body
+    Variable* inline_arguments; // the arguments of the inlined call that is being evaluated
+    int threads; // the most threads a PFOR runs on, 0 for one per core
+    int worker; // runs the iterations of a PFOR next to other workers, it leaves the invariant slots and MEMO caches they share alone
+    char* stack_base; // the C stack where the thread of the process started running it, NULL before it runs
+    size_t stack_size; // the C stack of that thread, a call in an expression errors before it's used up
+
     Scope main_scope;
 };
 
@@ -58,6 +95,19 @@ void destroyProcess (Process* process);
 */
 int runProcess (Process* process);
 
+/**
+ * @brief Get the size of the C stack of the main thread
+ * @return The size in bytes
+*/
+size_t getStackSize ();
+
+/**
+ * @brief Check if the C stack of a process is close to overflowing, calls in expressions grow it until the function returns
+ * @param process The process to check
+ * @return Whether or not the stack is too deep for another call
+*/
+int isStackExhausted (Process* process);
+
 /**
  * @brief Set the return value of a process
  * @param process The process to set the return value of
@@ -99,6 +149,32 @@ char* getNodeText (Process* process, Node* node, int ast_index);
 */
 int callFunction (char* name, Variable* args, int args_length, Process* process);
 
+/**
+ * @brief Enter a function that isn't a standard function, giving it a new scope after the last scope
+ * @param process The process to run the function in
+ * @param function The function to enter
+ * @param args The arguments to pass to the function
+ * @param args_length The length of the arguments
+ * @return The error code
+*/
+int enterFunction (Process* process, Function* function, Variable* args, int args_length);
+
+/**
+ * @brief Run a function that isn't a standard function in a new scope, until it ends
+ * @param process The process to run the function in
+ * @param function The function to run
+ * @param args The arguments to pass to the function
+ * @param args_length The length of the arguments
+ * @return The error code, or a negative code when the function ended
+*/
+int runFunction (Process* process, Function* function, Variable* args, int args_length);
+
+/**
+ * @brief Destroy the arguments of a waiting tail call, and clear it
+ * @param tail_call The tail call
+*/
+void clearTailCall (TailCall* tail_call);
+
 /**
  * @brief Get the position in the full code of a tokens start
  * @param process The process to get the token from
@@ -131,6 +207,15 @@ Token getTokenAtPosition (Process* process, int position);
 */
 int getTypeFromCastNode (Process* process, Type* t, Node* cast);
 
+/**
+ * @brief Get the type from a cast node, reading the type tokens from a token list
+ * @param tokens The token list of the AST the cast node belongs to
+ * @param t The type to fill
+ * @param cast The cast node
+ * @return The error code
+*/
+int getTypeFromCastTokens (Token* tokens, Type* t, Node* cast);
+
 /**
  * @brief Get the type from a type node
  * @param t The type to fill
@@ -139,11 +224,79 @@ int getTypeFromCastNode (Process* process, Type* t, Node* cast);
 */
 int getTypeFromNode (Process* process, Type* t, Node* typeNode);
 
+/**
+ * @brief Parse the body of a function in place, the first time the function is called
+ * @param process The process the function belongs to
+ * @param ast_index The index of the AST the body belongs to
+ * @param body The unparsed block, replaced by the parsed, validated and optimized block
+ * @return The error code, the body stays unparsed when it has an error
+ * @note The program is running, so errors are returned to the call instead of quitting, a CATCH can handle them
+*/
+int parseFunctionBody (Process* process, int ast_index, Node* body);
+
+/**
+ * @brief Parse the body of a function the first time it's needed, and make the expression calls to it can be inlined with
+ * @param process The process the function belongs to
+ * @param function The function
+ * @return The error code
+*/
+int prepareFunction (Process* process, Function* function);
+
+/**
+ * @brief Parse the body of a MEMO function when it's declared and give the function a result cache, if the body is pure
+ * @param process The process the function belongs to
+ * @param function The function, not yet added to the scope
+ * @return 0 on success, ERROR_FUNCTION_NOT_PURE when the results can't be cached
+*/
+int prepareMemoFunction (Process* process, Function* function);
+
+/**
+ * @brief Run the iterations of a PFOR on several threads, when they can't see each other's writes
+ * @param process The process to run
+ * @param scope The scope the statement runs in, the FOR has been started
+ * @param loop The PFOR node
+ * @return The exit code, or -1 when the loop has to run like a FOR
+ * @note When an iteration fails every iteration before it still runs and it's error is reported, like in a FOR, the writes of the iterations after it are unspecified because some of them may already have run
+*/
+int runParallelFor (Process* process, Scope* scope, Node* loop);
+
+/**
+ * @brief Validate, optimize and link an AST of a process before it runs
+ * @param process The process the AST belongs to
+ * @param ast_index The index of the AST
+ * @param report Whether or not to print every error in the AST, before the program runs all of them are shown
+ * @return The code of the first error, 0 when the AST is valid
+*/
+int prepareAST (Process* process, int ast_index, int report);
+
+/**
+ * @brief Check if the program of a process is made of more than one file
+ * @param process The process
+ * @return Whether or not a module has been loaded or the main file imports one
+*/
+int isLinkedProgram (Process* process);
+
+/**
+ * @brief Load a module into a process, every file is only loaded once
+ * @param process The process to load the module into
+ * @param path The absolute path of the module
+ * @param ast_index Filled with the index of the AST of the module
+ * @return 0 when the module has just been loaded, -1 when it was already loaded, otherwise the error code
+*/
+int loadModule (Process* process, const char* path, int* ast_index);
+
 // include these after the struct definition to prevent circular dependencies
 #include "interpreter.h"
+#include "optimizer.h"
+#include "validator.h"
+#include "modulepool.h"
+#include "parallel.h"
 
 Process createProcess (int debug, int main, AST root_ast) {
     Process process;
+    process.allocator = createAllocator();
+    active_allocator = process.allocator;
+
     process.code = malloc(sizeof(AST));
     process.code[0] = createNullTerminatedAST();
     addAST(&process.code, root_ast);
@@ -154,8 +307,32 @@ Process createProcess (int debug, int main, AST root_ast) {
     process.exit_code = 0;
     process.running = 0;
 
+    process.running_ast = 0;
+    process.cache_dir = NULL;
+    process.version = "";
+    process.preloaded = malloc(sizeof(PreloadedModule));
+    process.preloaded[0].path = NULL;
+    process.element_refrence = (ElementRefrence){ NULL, 0, createNullTerminatedVariable() };
+    process.tail_call = (TailCall){ NULL, NULL, 0 };
+    process.inline_functions = 1;
+    process.inline_function = NULL;
+    process.inline_arguments = NULL;
+    process.threads = 0;
+    process.worker = 0;
+    process.stack_base = NULL;
+    process.stack_size = 0;
+
     process.main_scope = createScope(&process.code[0].root, 0, main, 0, SCOPE_ROOT);
+    int validate_res = prepareAST(&process, 0, 1);
+    if (validate_res) {
+        // every error has been reported, nothing has run yet
+        #ifdef _WIN32
+        _fcloseall(); // close all files if any were opened
+        #endif
+        exit(validate_res);
+    }
     process.debug = debug;
+    process.eager_logic = 0;
     
     return process;
 }
@@ -165,10 +342,23 @@ void destroyProcess (Process* process) {
         destroyAST(&process->code[i]);
     }
     free(process->code);
+    for (int i = 0; process->preloaded[i].path != NULL; i++) {
+        if (process->preloaded[i].state == MODULE_PARSED && process->preloaded[i].error_code == 0) destroyAST(&process->preloaded[i].ast);
+        free(process->preloaded[i].full_code);
+        free(process->preloaded[i].path);
+    }
+    free(process->preloaded);
+    free(process->cache_dir);
+    destroyVariable(&process->element_refrence.value);
+    clearTailCall(&process->tail_call);
     destroyScope(&process->main_scope);
+    destroyAllocator(process->allocator); // releases the values that are left at once
 }
 
 int runProcess (Process* process) {
+    char stack_base;
+    process->stack_base = &stack_base;
+    process->stack_size = getStackSize();
     process->running = 1;
     process->exit_code = 0; // the exit code of the process, defaults to 0 (success)
     process->error_code = 0; // the error code of the process, defaults to 0 (no error)
@@ -195,16 +385,35 @@ int runProcess (Process* process) {
     return process->exit_code;
 }
 
+size_t getStackSize () {
+    #ifdef _WIN32
+    return STACK_SIZE_WINDOWS;
+    #else
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) || limit.rlim_cur == RLIM_INFINITY) return STACK_SIZE_FALLBACK;
+    return (size_t)limit.rlim_cur;
+    #endif
+}
+
+int isStackExhausted (Process* process) {
+    if (process->stack_base == NULL) return 0;
+    // the stack grows down, from the base to the variable made here
+    char stack_top;
+    uintptr_t used = (uintptr_t)process->stack_base - (uintptr_t)&stack_top;
+    size_t reserve = process->stack_size / 4 < STACK_RESERVE ? process->stack_size / 4 : STACK_RESERVE;
+    return used > process->stack_size - reserve;
+}
+
 void setReturnValue (Process* process, Variable* var) {
     Variable* returnVariable = getVariable(&process->main_scope, "_");
 
     destroyVariable(returnVariable);
 
     *returnVariable = cloneVariable(var);
-    free (returnVariable->name);
     returnVariable->name = malloc(sizeof(char) * 2);
     strcpy(returnVariable->name, "_");
     returnVariable->constant = 1;
+    returnVariable->literal = 0;
 }
 
 Variable* getReturnValue (Process* process) {
@@ -242,21 +451,25 @@ Token getTokenAtPosition (Process* process, int position) {
 }
 
 int getTypeFromCastNode (Process* process, Type* t, Node* cast) {
+    return getTypeFromCastTokens(process->code[getLastScope(&process->main_scope)->running_ast].tokens, t, cast);
+}
+
+int getTypeFromCastTokens (Token* tokens, Type* t, Node* cast) {
     if (cast->type != NODE_OPERATOR_CAST) return ERROR_INVALID_CAST;
     if (cast->start + 1 >= cast->end) return ERROR_INVALID_CAST;
 
     for (int i = cast->start + 1; i < cast->end-1; i++) {
-        if (getTokenAtPosition(process, i).carry == TYPE_ARRAY) {
+        if (tokens[i].carry == TYPE_ARRAY) {
             t->array++;
         } else {
             return ERROR_INVALID_CAST;
         }
     }
 
-    if (getTokenAtPosition(process, cast->end-1).carry == TYPE_ARRAY) {
+    if (tokens[cast->end-1].carry == TYPE_ARRAY) {
         return ERROR_INVALID_CAST;
     } else {
-        t->dataType = getTokenAtPosition(process, cast->end-1).carry;
+        t->dataType = tokens[cast->end-1].carry;
     }
     
     return 0;
@@ -282,6 +495,116 @@ int getTypeFromNode (Process* process, Type* t, Node* typeNode) {
     
     return 0;
 }
+
+int parseFunctionBody (Process* process, int ast_index, Node* body) {
+    AST* ast = &process->code[ast_index];
+
+    // the parser quits on errors, the trap turns them into an error of the call (the partly built block is lost)
+    ErrorTrap trap;
+    ErrorTrap* outer_trap = error_trap;
+    error_trap = &trap;
+    if (setjmp(trap.jump)) {
+        error_trap = outer_trap;
+        return trap.code;
+    }
+    Node block = parse(ast->full_code, ast->tokens, body->start, body->end, NODE_BLOCK);
+    error_trap = outer_trap;
+
+    Validator validator = createValidator(ast, 0);
+    if (validateTree(&validator, &block)) {
+        destroyNode(&block);
+        return validator.first_error;
+    }
+    destroyNode(body);
+    *body = block;
+    optimizeTree(ast, &process->main_scope, body, isLinkedProgram(process));
+    linkCallChains(body);
+    return 0;
+}
+
+int prepareFunction (Process* process, Function* function) {
+    if (function->body->type != NODE_UNPARSED_BLOCK) return 0;
+    int code = parseFunctionBody(process, function->ast_index, function->body);
+    if (code) return code;
+    function->inline_body = createInlineBody(&process->main_scope, function);
+    function->tail_call = isTailCallSafe(&process->code[function->ast_index], function);
+    return 0;
+}
+
+int prepareMemoFunction (Process* process, Function* function) {
+    if (function->body->type == NODE_UNPARSED_BLOCK) {
+        int code = parseFunctionBody(process, function->ast_index, function->body);
+        if (code) return code;
+        function->tail_call = isTailCallSafe(&process->code[function->ast_index], function);
+    }
+    if (!isMemoizable(&process->code[function->ast_index], &process->main_scope, function)) return ERROR_FUNCTION_NOT_PURE;
+    function->memo = createMemoCache();
+    return 0;
+}
+
+int prepareAST (Process* process, int ast_index, int report) {
+    Validator validator = createValidator(&process->code[ast_index], report);
+    if (validateAST(&validator)) return validator.first_error;
+    optimizeAST(&process->code[ast_index], &process->main_scope, isLinkedProgram(process));
+    linkCallChains(&process->code[ast_index].root);
+    return 0;
+}
+
+int isLinkedProgram (Process* process) {
+    if (getASTsLength(process->code) > 1) return 1;
+    // the IMPORT may be in a function body that isn't parsed yet
+    AST* ast = &process->code[0];
+    for (int i = 0; i < ast->token_count; i++) {
+        if (ast->tokens[i].type == TOKEN_MASTER_KEYWORD && ast->tokens[i].carry == MASTER_IMPORT) return 1;
+    }
+    return 0;
+}
+
+int loadModule (Process* process, const char* path, int* ast_index) {
+    // modules are cached by their absolute path, so every file is only parsed and run once
+    int length = getASTsLength(process->code);
+    for (int i = 0; i < length; i++) {
+        char* loaded = getAbsolutePath(process->code[i].filename);
+        int found = loaded != NULL && !strcmp(loaded, path);
+        free(loaded);
+        if (found) {
+            *ast_index = i;
+            return -1;
+        }
+    }
+
+    // use the module parsed ahead of time if there is one, it's errors are reported now like the parser would have
+    AST ast = createNullTerminatedAST();
+    for (int i = 0; process->preloaded[i].path != NULL; i++) {
+        PreloadedModule* module = &process->preloaded[i];
+        if (module->state != MODULE_PARSED || strcmp(module->path, path)) continue;
+        if (module->error_code) printError(module->full_code, module->error_position, module->error_code);
+        ast = module->ast;
+        module->state = MODULE_IMPORTED;
+        break;
+    }
+    if (checkIfNullTerminatedAST(&ast)) {
+        char* contents = NULL;
+        int code = readModuleFile(path, &contents);
+        if (code) return code;
+        ast = loadCachedAST(path, contents, process->cache_dir, process->version);
+        free(contents);
+    }
+    addAST(&process->code, ast);
+
+    // the ASTs may have moved, the main scope runs the root of the first one
+    process->main_scope.body = &process->code[0].root;
+
+    // an invalid module is an error of the IMPORT, it isn't kept so it isn't seen as loaded
+    int validate_res = prepareAST(process, length, 0);
+    if (validate_res) {
+        destroyAST(&process->code[length]);
+        process->code[length] = createNullTerminatedAST();
+        return validate_res;
+    }
+    *ast_index = length;
+    return 0;
+}
 #include "standard-library/dosato-std.h" // include the dosato standard library, after all the other definitions
 
 int callFunction (char* name, Variable* args, int args_length, Process* process) {
@@ -291,39 +614,108 @@ int callFunction (char* name, Variable* args, int args_length, Process* process)
     }
     
     if (function->std_function) {
-        return standard_call(process, name, args, args_length);
+        // only the bit functions work on packed arrays, the others get the arrays as lists of variables
+        if (!takesPackedArrays(name)) {
+            for (int i = 0; i < args_length; i++) {
+                unpackNestedArrays(&args[i]);
+            }
+        }
+        int code = standard_call(process, name, args, args_length);
+        process->inline_function = NULL; // a standard function may have called a user function
+        return code;
     }
 
+    // a call in an expression runs the function on the C stack, too many of them in each other would overflow it
+    if (isStackExhausted(process)) return ERROR_RECURSION;
+
+    // a MEMO function returns the result it had for the same arguments before, the cache isn't moved by new functions
+    MemoCache* memo = process->worker ? NULL : function->memo;
+    if (memo != NULL) {
+        Variable* cached = getMemoResult(memo, args, args_length);
+        if (cached != NULL) {
+            setReturnValue(process, cached);
+            process->inline_function = NULL;
+            return 0;
+        }
+    }
+
+    // the first call parses the body and makes the inline body, so calls are inlined from their second run on
+    // a function with an inline body can't declare functions, so the pointer stays valid while it runs
+    Function* inline_function = process->inline_functions && function->inline_body != NULL ? function : NULL;
+
+    int caller_ast = process->running_ast;
+    int depth = getScopeLength(&process->main_scope);
+    int code = runFunction(process, function, args, args_length);
+
+    // a RETURN of a call in tail position leaves the call to be made here, so it runs in place of the function that returned
+    while (code <= 0 && process->tail_call.function != NULL) {
+        TailCall tail_call = process->tail_call;
+        process->tail_call = (TailCall){ NULL, NULL, 0 };
+        code = runFunction(process, tail_call.function, tail_call.args, tail_call.args_length);
+        clearTailCall(&tail_call);
+    }
+    clearTailCall(&process->tail_call);
+
+    if (code > 0) unwindScopes(&process->main_scope, depth); // the error left the function before it finished
+    process->running_ast = caller_ast;
+    process->inline_function = inline_function;
+    if (memo != NULL && code <= 0) setMemoResult(memo, args, args_length, getReturnValue(process));
+    return code > 0 ? code : 0;
+}
+
+int enterFunction (Process* process, Function* function, Variable* args, int args_length) {
     if (function->arguments_length != args_length) {
         return ERROR_FUNCTION_ARG_NOT_CORRECT_AMOUNT;
     }
 
-    // create a new scope to run the function in
-    Scope scope = createScope(function->body, getLastScope(&process->main_scope)->running_ast, 0, getScopeLength(&process->main_scope), SCOPE_FUNCTION);
+    int prepare_res = prepareFunction(process, function);
+    if (prepare_res) return prepare_res;
+
+    // create a new scope to run the function in, in the AST the function was declared in
+    int depth = getScopeLength(&process->main_scope);
+    Scope scope = createScope(function->body, function->ast_index, 0, depth, SCOPE_FUNCTION);
     scope.returnType = function->return_type;
     
     // add the arguments to the scope
     for (int i = 0; i < args_length; i++) {
-        Variable arg = cloneVariable(&args[i]); // clone the variable, so we can change the name
-        free(arg.name);
+        Variable arg = cloneVariable(&args[i]); // clone the variable, so we can give it a name
         arg.name = malloc(sizeof(char) * (strlen(function->arguments[i].name) + 1));
         strcpy(arg.name, function->arguments[i].name);
+        arg.literal = 0;
         if (!compareType(function->arguments[i].type, arg.type)) {
             int cRes = castValue(&arg, function->arguments[i].type);
-            if (cRes) return cRes;
+            if (cRes) {
+                destroyVariable(&arg);
+                destroyScope(&scope);
+                return cRes;
+            }
         }
+        packArray(&arg);
         addVariable(&scope, arg);
     }
 
     *getLastScope(&process->main_scope)->child = scope;
+    return 0;
+}
+
+int runFunction (Process* process, Function* function, Variable* args, int args_length) {
+    int code = enterFunction(process, function, args, args_length);
+    if (code) return code;
 
     // excute the function in here
-    int code = 0;
     while (process->running) {
         code = next(process);
         if (code) break;
     }
-    return code > 0 ? code : 0;
+    return code;
+}
+
+void clearTailCall (TailCall* tail_call) {
+    for (int i = 0; i < tail_call->args_length; i++) {
+        destroyVariable(&tail_call->args[i]);
+    }
+    free(tail_call->args);
+    *tail_call = (TailCall){ NULL, NULL, 0 };
 }
 
 #endif
\ No newline at end of file
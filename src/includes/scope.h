@@ -15,6 +15,9 @@
 #include "variable.h"
 #include "function.h"
 
+// scopes with more variables than this find them through a hash of their names
+#define SCOPE_INDEX_THRESHOLD 16
+
 typedef struct Scope Scope;
 
 typedef enum {
@@ -30,10 +33,48 @@ typedef enum {
     TERMINATE_RETURN = -4
 } TerminateType;
 
+typedef enum {
+    STATEMENT_BEGIN, // find the extension of the chain, and test a WHEN
+    STATEMENT_WHILE, // test the condition of a WHILE
+    STATEMENT_FOR, // take the next element of a FOR
+    STATEMENT_CHAIN, // run the first call of the chain
+    STATEMENT_THEN, // run the next THEN of the chain
+    STATEMENT_CHAIN_END, // run the CATCH or INTO at the end of the chain
+    STATEMENT_CATCH // the CATCH block has ended
+} StatementStep;
+
+#define STATEMENT_SUSPENDED -10 // the statement waits for the scope after it to end
+#define STATEMENT_INLINE_END -11 // a statement run by an IMPORT has ended
+
+/**
+ * @brief The state of the call statement a scope is running, so it can wait for the block or function it called without holding on to the C stack
+*/
+typedef struct {
+    Node* node; // NULL when the scope isn't running a call statement
+    StatementStep step;
+    NodeType loop; // NODE_WHILE or NODE_FOR when the chain runs in a loop, NODE_PFOR for an iteration run by a worker
+    int start; // the first call of the chain, moves when the ELSE of a WHEN is taken
+    int link; // the first call of the chain in this run, moves when the ELSE of an IF is taken
+    int chain_start; // the call the THEN, CATCH and INTO of the chain follow
+    int position; // the last call that ran
+    int end; // the end of the chain, before the extension
+    int result; // the code of the last call
+    int waiting; // whether or not the statement waits for the scope after it to end
+    int inline_statement; // run by an IMPORT, it doesn't move the scope to it's next line
+    Node* call; // the call that is waited for
+    Variable loop_array; // the elements of a FOR
+    int loop_index;
+    int loop_variable; // the position of the variable of a FOR in the scope
+} Statement;
+
 struct Scope {
     int running_line;
     int running_ast;
     Variable* variables;
+    int variable_count;
+    int variable_capacity;
+    int* variable_index; // open addressed hash of the positions in variables (-1 is empty), NULL while the scope is small
+    int index_capacity;
     Function* functions;
     Node* body;
     Scope* child;
@@ -42,10 +83,9 @@ struct Scope {
 
     Type returnType;
     ScopeType callType;
-};
-
-#include "garbagecollector.h"
 
+    Statement statement;
+};
 
 /**
  * @brief Populate the default variables in a scope
@@ -68,6 +108,12 @@ Scope createScope (Node* body, int ast_index, int main, int depth, ScopeType cal
 */
 Scope createNullTerminatedScope ();
 
+/**
+ * @brief Create the state of a scope that isn't running a call statement
+ * @return The statement
+*/
+Statement createStatement ();
+
 /**
  * @brief Get the length of a scope chain
  * @param scope The scope to get the length of
@@ -95,11 +141,49 @@ Scope* getLastScope (Scope* scope);
 */
 Scope* getLastNonTerminatedScope (Scope* scope);
 
+/**
+ * @brief Get the last scope in a scope chain that isn't a block, the scope a RETURN returns from
+ * @param scope The scope to get the scope of
+ * @return The last function, expression or root scope
+*/
+Scope* getReturnScope (Scope* scope);
+
+/**
+ * @brief Terminate the last non terminated scopes in a scope chain, walking the chain once instead of once per scope
+ * @param scope The scope to terminate the last scopes of
+ * @param count The amount of scopes to terminate
+ * @param type The type of termination
+ * @return The amount of scopes that were terminated, only the blocks after the last scope that isn't a block are
+*/
+int terminateBlocks (Scope* scope, int count, TerminateType type);
+
+/**
+ * @brief Terminate the blocks at the end of a scope chain and the scope they return from, walking the chain once
+ * @param scope The scope to terminate the last scopes of
+ * @return The function, expression or root scope that is returned from
+*/
+Scope* terminateReturn (Scope* scope);
+
+/**
+ * @brief Get the scope an ended scope chain unwinds to, the scopes after it ended together and can be removed at once
+ * @param scope The scope to get the scope of
+ * @return The scope to remove the child of, NULL when the last scope hasn't ended
+ * @note Only scopes that a waiting statement called are removed together, a scope run from inside an expression ends the unwinding
+*/
+Scope* getUnwindScope (Scope* scope);
+
+/**
+ * @brief Remove the child of a scope, together with all the scopes after it
+ * @param scope The scope to remove the child of
+*/
+void removeChildScope (Scope* scope);
+
 /**
  * @brief Remove the last scope in a scope chain
  * @param scope The scope to remove the last scope of
+ * @return The new last scope
 */
-void removeLastScope (Scope* scope);
+Scope* removeLastScope (Scope* scope);
 
 /**
  * @brief Add a variable to a scope
@@ -123,6 +207,42 @@ void addFunction (Scope* scope, Function func);
 */
 Variable* getVariable (Scope* scope, char* name);
 
+/**
+ * @brief Get a variable from the variables of one scope, without looking in it's children
+ * @param scope The scope to get the variable from
+ * @param name The name of the variable
+ * @return The variable, or NULL when it isn't in the scope
+*/
+Variable* getScopeVariable (Scope* scope, char* name);
+
+/**
+ * @brief Hash the name of a variable (FNV-1a)
+ * @param name The name
+ * @return The hash
+*/
+unsigned int hashVariableName (const char* name);
+
+/**
+ * @brief Rebuild the hash index of a scope with a new capacity
+ * @param scope The scope
+ * @param capacity The capacity of the index, a power of 2
+*/
+void rebuildVariableIndex (Scope* scope, int capacity);
+
+/**
+ * @brief Add the variable at a position to the hash index of a scope
+ * @param scope The scope
+ * @param position The position of the variable
+*/
+void indexVariable (Scope* scope, int position);
+
+/**
+ * @brief Remove the variable at a position from the hash index of a scope
+ * @param scope The scope
+ * @param position The position of the variable
+*/
+void unindexVariable (Scope* scope, int position);
+
 /**
  * @brief Get a variable from a list of variables
  * @param list The list of variables to get the variable from
@@ -144,6 +264,8 @@ Function* getFunction (Scope* scope, char* name);
 */
 void addScope (Scope** scope, Scope new_scope);
 
+#include "garbagecollector.h"
+
 void populateDefaultVariables (Scope* scope, int main, int depth) {
     // define constants in the global scope
     // ALL pointers ownership is transferred to the variable, and must be freed in the variable's destroy function
@@ -154,31 +276,31 @@ void populateDefaultVariables (Scope* scope, int main, int depth) {
         // this variable is the only variable that can mutate it's type
         // despite it being constant, the return value of a function can modify it
         // it defaults to 0
-        int* return_value = malloc(sizeof(int));
+        int* return_value = allocValue(sizeof(int));
         *return_value = 0;
         addVariable(scope, createVariable("_", TYPE_INT, return_value, 1, 0));
 
         // BOOL constants
-        int* const_true  = malloc(sizeof(int));
+        int* const_true  = allocValue(sizeof(int));
         *const_true = 1;
-        int* const_false = malloc(sizeof(int));
+        int* const_false = allocValue(sizeof(int));
         *const_false = 0;
         addVariable(scope, createVariable("TRUE", TYPE_BOOL, const_true, 1, 0));
         addVariable(scope, createVariable("FALSE", TYPE_BOOL, const_false, 1, 0));
 
         // MATH constants
-        double* const_pi = malloc(sizeof(double));
+        double* const_pi = allocValue(sizeof(double));
         *const_pi = 3.14159265358979323846;
         addVariable(scope, createVariable("MATH_PI", TYPE_DOUBLE, const_pi, 1, 0));
-        double* const_e = malloc(sizeof(double));
+        double* const_e = allocValue(sizeof(double));
         *const_e = 2.71828182845904523536;
         addVariable(scope, createVariable("MATH_E", TYPE_DOUBLE, const_e, 1, 0));
 
         // MAXINT and MININT constants
-        int* const_maxint = malloc(sizeof(int));
+        int* const_maxint = allocValue(sizeof(int));
         *const_maxint = 2147483647;
         addVariable(scope, createVariable("MAXINT", TYPE_INT, const_maxint, 1, 0));
-        int* const_minint = malloc(sizeof(int));
+        int* const_minint = allocValue(sizeof(int));
         *const_minint = -2147483648;
         addVariable(scope, createVariable("MININT", TYPE_INT, const_minint, 1, 0));
 
@@ -187,14 +309,14 @@ void populateDefaultVariables (Scope* scope, int main, int depth) {
         strcpy(const_dosato, "DOSATO");
         addVariable(scope, createVariable("__DOSATO", TYPE_STRING, const_dosato, 1, 0));
 
-        char* const_warrioralex = malloc(sizeof(char));
+        char* const_warrioralex = allocValue(sizeof(char));
         *const_warrioralex = 'W';
         addVariable(scope, createVariable("__WARRIORALEXONE", TYPE_CHAR, const_warrioralex, 1, 0));
 
     }
 
     // the depth of the scope is stored in the __depth variable
-    int* const_scope_depth = malloc(sizeof(int));
+    int* const_scope_depth = allocValue(sizeof(int));
     *const_scope_depth = depth;
     addVariable(scope, createVariable("__depth", TYPE_INT, const_scope_depth, 1, 0));
 }
@@ -437,6 +559,24 @@ void addSystemFunctions (Scope* scope, int main, int depth) {
 
         // FILL
         addFunction(scope, createFunction("FILL", NULL, NULL, 0, (Type){TYPE_ARRAY, 0}, 1));
+
+        // COUNTTRUE
+        addFunction(scope, createFunction("COUNTTRUE", NULL, NULL, 0, (Type){TYPE_LONG, 0}, 1));
+
+        // ANY
+        addFunction(scope, createFunction("ANY", NULL, NULL, 0, (Type){TYPE_BOOL, 0}, 1));
+
+        // ALL
+        addFunction(scope, createFunction("ALL", NULL, NULL, 0, (Type){TYPE_BOOL, 0}, 1));
+
+        // ARRAYAND
+        addFunction(scope, createFunction("ARRAYAND", NULL, NULL, 0, (Type){TYPE_ARRAY, 0}, 1));
+
+        // ARRAYOR
+        addFunction(scope, createFunction("ARRAYOR", NULL, NULL, 0, (Type){TYPE_ARRAY, 0}, 1));
+
+        // ARRAYXOR
+        addFunction(scope, createFunction("ARRAYXOR", NULL, NULL, 0, (Type){TYPE_ARRAY, 0}, 1));
         
     }
 }
@@ -453,28 +593,59 @@ Scope createScope (Node* body, int ast_index, int main, int depth, ScopeType cal
     
     scope.variables = malloc(sizeof(Variable));
     scope.variables[0] = createNullTerminatedVariable();
+    scope.variable_count = 0;
+    scope.variable_capacity = 0;
+    scope.variable_index = NULL;
+    scope.index_capacity = 0;
     populateDefaultVariables(&scope, main, depth);
 
     scope.functions = malloc(sizeof(Function));
     scope.functions[0] = createNullTerminatedFunction();
     addSystemFunctions(&scope, main, depth);
 
+    scope.statement = createStatement();
+
     Scope* child = malloc(sizeof(Scope));
     *child = createNullTerminatedScope();
     scope.child = child;
     return scope;
 }
 
+Statement createStatement () {
+    Statement statement;
+    statement.node = NULL;
+    statement.step = STATEMENT_BEGIN;
+    statement.loop = NODE_NULL;
+    statement.start = 0;
+    statement.link = 0;
+    statement.chain_start = 0;
+    statement.position = 0;
+    statement.end = 0;
+    statement.result = 0;
+    statement.waiting = 0;
+    statement.inline_statement = 0;
+    statement.call = NULL;
+    statement.loop_array = createNullTerminatedVariable();
+    statement.loop_index = 0;
+    statement.loop_variable = -1;
+    return statement;
+}
+
 Scope createNullTerminatedScope () {
     Scope scope;
     scope.body = NULL;
     scope.running_line = -1;
     scope.variables = NULL;
+    scope.variable_count = 0;
+    scope.variable_capacity = 0;
+    scope.variable_index = NULL;
+    scope.index_capacity = 0;
     scope.child = NULL;
 
     scope.returnType = (Type){TYPE_VOID, 0};
     scope.callType = SCOPE_ROOT;
     scope.terminated = 0;
+    scope.statement = createStatement();
     return scope;
 }
 
@@ -507,36 +678,124 @@ Scope* getLastNonTerminatedScope (Scope* scope) {
     return last_scope;
 }
 
-void removeLastScope (Scope* scope) {
+Scope* getReturnScope (Scope* scope) {
+    Scope* return_scope = scope;
+    while (scope->running_line != -1) {
+        if (scope->callType != SCOPE_BLOCK) return_scope = scope;
+        scope = scope->child;
+    }
+    return return_scope;
+}
+
+int terminateBlocks (Scope* scope, int count, TerminateType type) {
+    if (count <= 0) return 0;
+    Scope* last_scope = scope;
+    int depth = 0;
+    while (last_scope->child->running_line != -1 && !last_scope->child->terminated) {
+        last_scope = last_scope->child;
+        depth++;
+    }
+
+    // the first of the scopes to terminate, the root scope is never a block
+    Scope* first_scope = scope;
+    for (int i = 0; i < depth - count + 1; i++) {
+        first_scope = first_scope->child;
+    }
+    for (Scope* current = first_scope; current != last_scope->child; current = current->child) {
+        if (current->callType != SCOPE_BLOCK) first_scope = current->child;
+    }
+
+    int terminated = 0;
+    for (Scope* current = first_scope; current != last_scope->child; current = current->child) {
+        current->terminated = type;
+        terminated++;
+    }
+    return terminated;
+}
+
+Scope* terminateReturn (Scope* scope) {
+    Scope* return_scope = scope;
+    Scope* last_scope = scope;
+    while (last_scope->child->running_line != -1 && !last_scope->child->terminated) {
+        last_scope = last_scope->child;
+        if (last_scope->callType != SCOPE_BLOCK) return_scope = last_scope;
+    }
+    for (Scope* current = return_scope->child; current != last_scope->child; current = current->child) {
+        current->terminated = TERMINATE_RETURN;
+    }
+    return_scope->terminated = -1;
+    return return_scope;
+}
+
+Scope* getUnwindScope (Scope* scope) {
+    Scope* unwind_scope = NULL;
+    Scope* parent = scope;
+    while (parent->child->running_line != -1) {
+        Scope* current = parent->child;
+        int ended = current->terminated || (current->child->running_line == -1 && current->running_line >= getNodeBodyLength(current->body->body));
+        if (!ended) {
+            unwind_scope = NULL;
+        } else if (unwind_scope == NULL || !parent->statement.waiting) {
+            unwind_scope = parent;
+        }
+        parent = current;
+    }
+    return unwind_scope;
+}
+
+void removeChildScope (Scope* scope) {
+    if (scope->child->running_line == -1) return;
+    destroyScope(scope->child);
+    *scope->child = createNullTerminatedScope();
+    trimSlabs(active_allocator); // most values are freed when a scope ends
+}
+
+Scope* removeLastScope (Scope* scope) {
     Scope* last_scope = scope;
-    if (getLastScope(scope) == scope) {
+    if (scope->child->running_line == -1) {
         // there is only one scope, this scope cannot be removed
-        return;
+        return scope;
     }
 
-    while (last_scope->child->child != NULL) {
+    while (last_scope->child->child->running_line != -1) {
         last_scope = last_scope->child;
     }
-    destroyScope(last_scope);
-    *last_scope = createNullTerminatedScope();
+    removeChildScope(last_scope);
+    return last_scope;
 }
 
 Variable* addVariable (Scope* scope, Variable variable) {
-    int length = getVariablesLength(scope->variables);
-    scope->variables = realloc(scope->variables, sizeof(Variable) * (length + 2));
+    int length = scope->variable_count;
+    if (length + 1 >= scope->variable_capacity) {
+        scope->variable_capacity = scope->variable_capacity < 4 ? 4 : scope->variable_capacity * 2;
+        scope->variables = realloc(scope->variables, sizeof(Variable) * scope->variable_capacity);
+    }
     scope->variables[length] = variable;
     scope->variables[length+1] = createNullTerminatedVariable();
+    scope->variable_count++;
+
+    if (scope->variable_index != NULL) {
+        // keep the index at most half full
+        if (scope->variable_count * 2 > scope->index_capacity) {
+            rebuildVariableIndex(scope, scope->index_capacity * 2);
+        } else {
+            indexVariable(scope, length);
+        }
+    } else if (scope->variable_count > SCOPE_INDEX_THRESHOLD) {
+        rebuildVariableIndex(scope, SCOPE_INDEX_THRESHOLD * 4);
+    }
     return &scope->variables[length];
 }
 
 void popVariable (Scope* scope) {
-    int length = getVariablesLength(scope->variables);
+    int length = scope->variable_count;
     if (length == 0) {
         return;
     }
+    if (scope->variable_index != NULL) unindexVariable(scope, length-1);
     destroyVariable(&scope->variables[length-1]);
-    scope->variables = realloc(scope->variables, sizeof(Variable) * length);
     scope->variables[length-1] = createNullTerminatedVariable();
+    scope->variable_count--;
 }
 
 void addFunction (Scope* scope, Function func) {
@@ -556,10 +815,79 @@ Variable* getVariableFromList (Variable* list, char* name) {
     return NULL;
 }
 
+Variable* getScopeVariable (Scope* scope, char* name) {
+    if (scope->variable_index == NULL) {
+        for (int i = 0; i < scope->variable_count; i++) {
+            if (!strcmp(scope->variables[i].name, name)) {
+                return &scope->variables[i];
+            }
+        }
+        return NULL;
+    }
+    int mask = scope->index_capacity - 1;
+    for (int slot = hashVariableName(name) & mask; scope->variable_index[slot] != -1; slot = (slot + 1) & mask) {
+        Variable* variable = &scope->variables[scope->variable_index[slot]];
+        if (!strcmp(variable->name, name)) {
+            return variable;
+        }
+    }
+    return NULL;
+}
+
+unsigned int hashVariableName (const char* name) {
+    unsigned int hash = 2166136261u;
+    for (const char* c = name; *c != '\0'; c++) {
+        hash ^= (unsigned char)*c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void rebuildVariableIndex (Scope* scope, int capacity) {
+    free(scope->variable_index);
+    scope->variable_index = malloc(sizeof(int) * capacity);
+    scope->index_capacity = capacity;
+    for (int i = 0; i < capacity; i++) {
+        scope->variable_index[i] = -1;
+    }
+    for (int i = 0; i < scope->variable_count; i++) {
+        indexVariable(scope, i);
+    }
+}
+
+void indexVariable (Scope* scope, int position) {
+    int mask = scope->index_capacity - 1;
+    int slot = hashVariableName(scope->variables[position].name) & mask;
+    while (scope->variable_index[slot] != -1) {
+        slot = (slot + 1) & mask;
+    }
+    scope->variable_index[slot] = position;
+}
+
+void unindexVariable (Scope* scope, int position) {
+    int mask = scope->index_capacity - 1;
+    int slot = hashVariableName(scope->variables[position].name) & mask;
+    while (scope->variable_index[slot] != position) {
+        slot = (slot + 1) & mask;
+    }
+
+    // shift the entries after it back, so no lookup stops early at the hole
+    int hole = slot;
+    for (slot = (hole + 1) & mask; scope->variable_index[slot] != -1; slot = (slot + 1) & mask) {
+        int home = hashVariableName(scope->variables[scope->variable_index[slot]].name) & mask;
+        // the entry may only move back when its home isn't between the hole and itself
+        if ((slot > hole && (home <= hole || home > slot)) || (slot < hole && (home <= hole && home > slot))) {
+            scope->variable_index[hole] = scope->variable_index[slot];
+            hole = slot;
+        }
+    }
+    scope->variable_index[hole] = -1;
+}
+
 Variable* getVariable (Scope* scope, char* name) {
     Variable* ret = NULL;
     while (scope->running_line != -1) {
-        Variable* variable = getVariableFromList(scope->variables, name);
+        Variable* variable = getScopeVariable(scope, name);
         if (variable != NULL) {
             ret = variable;
         }
@@ -41,6 +41,28 @@ int std_RANGEF (Process* process, const Variable* args, int argc);
 
 int std_FILL (Process* process, const Variable* args, int argc);
 
+int std_COUNTTRUE (Process* process, const Variable* args, int argc);
+
+int std_ANY (Process* process, const Variable* args, int argc);
+
+int std_ALL (Process* process, const Variable* args, int argc);
+
+int std_ARRAYBITWISE (Process* process, const Variable* args, int argc, OperatorType operator);
+
+/**
+ * @brief Get whether or not a function takes packed arrays as they are, the other functions get their arrays unpacked
+ * @param name The name of the function
+ * @return Whether or not the function works on packed arrays
+*/
+int takesPackedArrays (const char* name);
+
+/**
+ * @brief Cast an argument to a BOOL array and pack it
+ * @param arg The argument
+ * @return The error code
+*/
+int packBitArgument (const Variable* arg);
+
 int std_ARRAYSHIFT (Process* process, const Variable* args, int argc) {
     if (argc < 1) {
         return ERROR_TOO_FEW_ARGUMENTS;
@@ -67,13 +89,13 @@ int std_ARRAYSHIFT (Process* process, const Variable* args, int argc) {
 
     newArr[len-1] = createNullTerminatedVariable();
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", args[0].type.dataType, newArr, 0, args[0].type.array);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(args[0].type.dataType, newArr, 0, args[0].type.array);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -121,13 +143,13 @@ int std_ARRAYREMOVE (Process* process, const Variable* args, int argc) {
 
     newArr[len - amount] = createNullTerminatedVariable();
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", args[0].type.dataType, newArr, 0, args[0].type.array);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(args[0].type.dataType, newArr, 0, args[0].type.array);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
 
     return 0; // return code
@@ -175,13 +197,13 @@ int std_ARRAYINSERT (Process* process, const Variable* args, int argc) {
 
     newArr[len + 1] = createNullTerminatedVariable();
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", args[0].type.dataType, newArr, 0, args[0].type.array);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(args[0].type.dataType, newArr, 0, args[0].type.array);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -225,13 +247,13 @@ int std_ARRAYSLICE (Process* process, const Variable* args, int argc) {
 
     newArr[amount] = createNullTerminatedVariable();
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", args[0].type.dataType, newArr, 0, args[0].type.array);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(args[0].type.dataType, newArr, 0, args[0].type.array);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -255,32 +277,32 @@ int std_ARRAYFINDINDEX (Process* process, const Variable* args, int argc) {
 
     for (int i = 0; i < len; i++) {
         if (compareVariables(&((Variable*)args[0].value)[i], (Variable*)&args[1])) {
-            Variable* var = malloc(sizeof(Variable));
+            Variable* var = allocValue(sizeof(Variable));
 
-            int* val = malloc(sizeof(int));
+            int* val = allocValue(sizeof(int));
             *val = i;
-            *var = createVariable("-lit", TYPE_INT, val, 0, 0);
+            *var = createLiteral(TYPE_INT, val, 0, 0);
 
             setReturnValue(process, var);
 
             destroyVariable(var);
-            free(var);
+            freeValue(var);
 
             return 0; // return code
         }
     }
 
-    Variable* var = malloc(sizeof(Variable));
+    Variable* var = allocValue(sizeof(Variable));
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     *val = -1;
 
-    *var = createVariable("-lit", TYPE_INT, val, 0, 0);
+    *var = createLiteral(TYPE_INT, val, 0, 0);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -304,32 +326,32 @@ int std_ARRAYLASTINDEX (Process* process, const Variable* args, int argc) {
 
     for (int i = len - 1; i >= 0; i--) {
         if (compareVariables(&((Variable*)args[0].value)[i], (Variable*)&args[1])) {
-            Variable* var = malloc(sizeof(Variable));
+            Variable* var = allocValue(sizeof(Variable));
 
-            int* val = malloc(sizeof(int));
+            int* val = allocValue(sizeof(int));
             *val = i;
-            *var = createVariable("-lit", TYPE_INT, val, 0, 0);
+            *var = createLiteral(TYPE_INT, val, 0, 0);
 
             setReturnValue(process, var);
 
             destroyVariable(var);
-            free(var);
+            freeValue(var);
 
             return 0; // return code
         }
     }
 
-    Variable* var = malloc(sizeof(Variable));
+    Variable* var = allocValue(sizeof(Variable));
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     *val = -1;
 
-    *var = createVariable("-lit", TYPE_INT, val, 0, 0);
+    *var = createLiteral(TYPE_INT, val, 0, 0);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -353,32 +375,32 @@ int std_ARRAYCONTAINS (Process* process, const Variable* args, int argc) {
 
     for (int i = 0; i < len; i++) {
         if (compareVariables(&((Variable*)args[0].value)[i], (Variable*)&args[1])) {
-            Variable* var = malloc(sizeof(Variable));
+            Variable* var = allocValue(sizeof(Variable));
 
-            int* val = malloc(sizeof(int));
+            int* val = allocValue(sizeof(int));
             *val = 1;
-            *var = createVariable("-lit", TYPE_BOOL, val, 0, 0);
+            *var = createLiteral(TYPE_BOOL, val, 0, 0);
 
             setReturnValue(process, var);
 
             destroyVariable(var);
-            free(var);
+            freeValue(var);
 
             return 0; // return code
         }
     }
 
-    Variable* var = malloc(sizeof(Variable));
+    Variable* var = allocValue(sizeof(Variable));
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     *val = 0;
 
-    *var = createVariable("-lit", TYPE_BOOL, val, 0, 0);
+    *var = createLiteral(TYPE_BOOL, val, 0, 0);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -405,13 +427,13 @@ int std_ARRAYREVERSE (Process* process, const Variable* args, int argc) {
 
     newArr[len] = createNullTerminatedVariable();
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", args[0].type.dataType, newArr, 0, args[0].type.array);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(args[0].type.dataType, newArr, 0, args[0].type.array);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -440,13 +462,13 @@ int std_ARRAYSORT (Process* process, const Variable* args, int argc) {
 
     qsort(newArr, len, sizeof(Variable), sortCompareVariables);
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", args[0].type.dataType, newArr, 0, args[0].type.array);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(args[0].type.dataType, newArr, 0, args[0].type.array);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -534,13 +556,13 @@ int std_ARRAYSORTFUNC (Process* process, const Variable* args, int argc) {
     newArr[len] = createNullTerminatedVariable();
     std_dosato_quicksort(newArr, len, (char*)args[1].value, process);
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", args[0].type.dataType, newArr, 0, args[0].type.array);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(args[0].type.dataType, newArr, 0, args[0].type.array);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
 
     return 0; // return code
@@ -588,21 +610,21 @@ int std_RANGE (Process* process, const Variable* args, int argc) {
 
     int arr_i = 0;
     for (int i = start; i < end; i += step) {
-        int* val = malloc(sizeof(int));
+        int* val = allocValue(sizeof(int));
         *val = i;
-        newArr[arr_i++] = createVariable("-lit", TYPE_INT, val, 0, 0);
+        newArr[arr_i++] = createLiteral(TYPE_INT, val, 0, 0);
     }
 
     newArr[arraylen] = createNullTerminatedVariable();  
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, newArr, 0, 1);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, newArr, 0, 1);
     
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
 
     return 0; // return code
@@ -654,22 +676,22 @@ int std_RANGEF (Process* process, const Variable* args, int argc) {
 
     int i = 0;
     while (start < end) {
-        double* val = malloc(sizeof(double));
+        double* val = allocValue(sizeof(double));
         *val = start;
-        newArr[i] = createVariable("-lit", TYPE_DOUBLE, val, 0, 0);
+        newArr[i] = createLiteral(TYPE_DOUBLE, val, 0, 0);
         start += step;
         i++;
     }
 
     newArr[arraylen] = createNullTerminatedVariable();  
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_FLOAT, newArr, 0, 1);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_FLOAT, newArr, 0, 1);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -694,6 +716,60 @@ int std_FILL (Process* process, const Variable* args, int argc) {
         return ERROR_NUMBER_CANNOT_BE_NEGATIVE;
     }
 
+    if (args[0].type.dataType == TYPE_BOOL && !args[0].type.array) {
+        // BOOL arrays are filled packed, a word at a time
+        BitArray* bits = createBitArray(len);
+        if (*(int*)args[0].value) {
+            memset(bits->words, 0xFF, sizeof(unsigned long long int) * (len / BITS_PER_WORD));
+            if (len % BITS_PER_WORD) bits->words[len / BITS_PER_WORD] = (1ULL << (len % BITS_PER_WORD)) - 1;
+        }
+
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_BOOL, bits, 0, 1);
+
+        setReturnValue(process, var);
+
+        destroyVariable(var);
+        freeValue(var);
+
+        return 0; // return code
+    }
+
+    // numbers, and rectangular arrays of them, are filled into a matrix by copying the block of the value
+    Matrix* value = NULL;
+    if (!args[0].type.array && isMatrixType(args[0].type.dataType)) {
+        long long int shape = 1;
+        value = createMatrix(args[0].type.dataType, 1, &shape);
+        memcpy(getMatrixData(value), args[0].value, value->element_size);
+    } else if (args[0].type.array) {
+        value = buildMatrix(&args[0]);
+    }
+    if (value != NULL && len > 0) {
+        int dimensions = args[0].type.array + 1;
+        long long int* shape = malloc(sizeof(long long int) * dimensions);
+        shape[0] = len;
+        if (args[0].type.array) memcpy(shape + 1, getMatrixShape(value), sizeof(long long int) * value->dimensions);
+        Matrix* matrix = createMatrix(value->element_type, dimensions, shape);
+        free(shape);
+
+        size_t size = value->element_size * value->element_count;
+        for (int i = 0; i < len; i++) {
+            memcpy(getMatrixData(matrix) + i * size, getMatrixData(value), size);
+        }
+        freeValue(value);
+
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(args[0].type.dataType, matrix, 0, dimensions);
+
+        setReturnValue(process, var);
+
+        destroyVariable(var);
+        freeValue(var);
+
+        return 0; // return code
+    }
+    freeValue(value);
+
     Variable* newArr = malloc(sizeof(Variable) * (len + 1)); // new array
 
     for (int i = 0; i < len; i++) {
@@ -703,15 +779,152 @@ int std_FILL (Process* process, const Variable* args, int argc) {
 
     newArr[len] = createNullTerminatedVariable();
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", args[0].type.dataType, newArr, 0, args[0].type.array + 1);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(args[0].type.dataType, newArr, 0, args[0].type.array + 1);
+
+    setReturnValue(process, var);
+
+    destroyVariable(var);
+    freeValue(var);
+
+    return 0; // return code
+}
+
+int std_COUNTTRUE (Process* process, const Variable* args, int argc) {
+    if (argc < 1) {
+        return ERROR_TOO_FEW_ARGUMENTS;
+    }
+    if (argc > 1) {
+        return ERROR_TOO_MANY_ARGUMENTS;
+    }
+
+    int cRes = packBitArgument(&args[0]);
+    if (cRes) return cRes;
+
+    long long int* val = allocValue(sizeof(long long int));
+    *val = countBits((BitArray*)args[0].value);
+
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_LONG, val, 0, 0);
+
+    setReturnValue(process, var);
+
+    destroyVariable(var);
+    freeValue(var);
+
+    return 0; // return code
+}
+
+int std_ANY (Process* process, const Variable* args, int argc) {
+    if (argc < 1) {
+        return ERROR_TOO_FEW_ARGUMENTS;
+    }
+    if (argc > 1) {
+        return ERROR_TOO_MANY_ARGUMENTS;
+    }
+
+    int cRes = packBitArgument(&args[0]);
+    if (cRes) return cRes;
+
+    // stop at the first word with a bit set
+    BitArray* bits = (BitArray*)args[0].value;
+    int words = getBitWordCount(bits->length);
+    int* val = allocValue(sizeof(int));
+    *val = 0;
+    for (int i = 0; i < words && !*val; i++) {
+        *val = bits->words[i] != 0;
+    }
+
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_BOOL, val, 0, 0);
+
+    setReturnValue(process, var);
+
+    destroyVariable(var);
+    freeValue(var);
+
+    return 0; // return code
+}
+
+int std_ALL (Process* process, const Variable* args, int argc) {
+    if (argc < 1) {
+        return ERROR_TOO_FEW_ARGUMENTS;
+    }
+    if (argc > 1) {
+        return ERROR_TOO_MANY_ARGUMENTS;
+    }
+
+    int cRes = packBitArgument(&args[0]);
+    if (cRes) return cRes;
+
+    // every full word must be all ones, the last word only up to the length
+    BitArray* bits = (BitArray*)args[0].value;
+    int full_words = bits->length / BITS_PER_WORD;
+    int rest = bits->length % BITS_PER_WORD;
+    int* val = allocValue(sizeof(int));
+    *val = 1;
+    for (int i = 0; i < full_words && *val; i++) {
+        *val = bits->words[i] == ~0ULL;
+    }
+    if (*val && rest) {
+        *val = bits->words[full_words] == (1ULL << rest) - 1;
+    }
+
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_BOOL, val, 0, 0);
+
+    setReturnValue(process, var);
+
+    destroyVariable(var);
+    freeValue(var);
+
+    return 0; // return code
+}
+
+int std_ARRAYBITWISE (Process* process, const Variable* args, int argc, OperatorType operator) {
+    if (argc < 2) {
+        return ERROR_TOO_FEW_ARGUMENTS;
+    }
+    if (argc > 2) {
+        return ERROR_TOO_MANY_ARGUMENTS;
+    }
+
+    int cRes = packBitArgument(&args[0]);
+    if (cRes) return cRes;
+    cRes = packBitArgument(&args[1]);
+    if (cRes) return cRes;
+
+    BitArray* left = (BitArray*)args[0].value;
+    BitArray* right = (BitArray*)args[1].value;
+    if (left->length != right->length) {
+        return ERROR_ARRAY_OUT_OF_BOUNDS;
+    }
+
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_BOOL, combineBitArrays(left, right, operator), 0, 1);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
 
-#endif
\ No newline at end of file
+int takesPackedArrays (const char* name) {
+    return !strcmp(name, "COUNTTRUE") || !strcmp(name, "ANY") || !strcmp(name, "ALL")
+        || !strcmp(name, "ARRAYAND") || !strcmp(name, "ARRAYOR") || !strcmp(name, "ARRAYXOR")
+        || !strcmp(name, "FILL"); // FILL only copies it's value
+}
+
+int packBitArgument (const Variable* arg) {
+    if (!arg->type.array) {
+        return ERROR_EXPECTED_ARRAY;
+    }
+    int cRes = castValue((Variable*)arg, (Type){TYPE_BOOL, 1});
+    if (cRes) return cRes;
+    packArray((Variable*)arg);
+    return 0;
+}
+
+#endif
@@ -27,12 +27,8 @@ int std_BREAK (Process* process, const Variable* args, int argc) {
         if (cRes) return cRes;
         len = *(long*)args[0].value;
     }
-    for (int i = 0; i < len; i++) {
-        Scope* lastScope = getLastNonTerminatedScope(&process->main_scope);
-        if (lastScope->callType != SCOPE_BLOCK) {
-            return ERROR_BREAK_OUTSIDE_OF_LOOP;
-        }
-        lastScope->terminated = TERMINATE_BREAK;
+    if (terminateBlocks(&process->main_scope, len, TERMINATE_BREAK) < len) {
+        return ERROR_BREAK_OUTSIDE_OF_LOOP;
     }
     return 0; // return code
 }
@@ -43,28 +39,20 @@ int std_CONTINUE (Process* process, const Variable* args, int argc) {
     if (argc > 0) {
         return ERROR_TOO_MANY_ARGUMENTS;
     }
-    Scope* lastScope = getLastNonTerminatedScope(&process->main_scope);
-    if (lastScope->callType != SCOPE_BLOCK) {
+    if (terminateBlocks(&process->main_scope, 1, TERMINATE_CONTINUE) < 1) {
         return ERROR_CONTINUE_OUTSIDE_OF_LOOP;
     }
-    lastScope->terminated = TERMINATE_CONTINUE;
     return 0; // return code
 }
 
 int std_RETURN (Process* process, const Variable* args, int argc);
 
 int std_RETURN (Process* process, const Variable* args, int argc) {
-    Scope* lastScope = NULL;
-
-    do {
-        lastScope = getLastNonTerminatedScope(&process->main_scope);
-        lastScope->terminated = TERMINATE_RETURN;
-    } while (lastScope->callType == SCOPE_BLOCK);
+    Scope* lastScope = terminateReturn(&process->main_scope);
 
     if (lastScope->callType != SCOPE_FUNCTION && lastScope->callType != SCOPE_EXPRESSION) {
         return ERROR_RETURN_OUTSIDE_OF_FUNCTION;
     }
-    lastScope->terminated = -1;
 
     if (lastScope->callType == SCOPE_FUNCTION) {
         if (lastScope->returnType.dataType != TYPE_VOID) {
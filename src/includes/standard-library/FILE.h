@@ -59,12 +59,12 @@ int std_READ (Process* process, const Variable* args, int argc) {
     fclose(file);
     val[size] = '\0';
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
 
     return 0; // return code
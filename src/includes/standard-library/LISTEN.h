@@ -33,12 +33,12 @@ int std_LISTEN (Process* process, const Variable* args, int argc) {
     char* input = getInput();
 
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, input, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, input, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
     // input gets freed in destroyVariable (the variable owns the value)
 
     return 0; // return code
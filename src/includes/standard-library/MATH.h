@@ -75,27 +75,27 @@ int std_SQRT (Process* process, const Variable* args, int argc) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         if (in_val < 0) return ERROR_MATH_DOMAIN_ERROR;
 
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = sqrt(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         if (in_val < 0) return ERROR_MATH_DOMAIN_ERROR;
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = sqrt(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
 
     return 0; // return code
@@ -112,27 +112,27 @@ int std_ABS (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        long long int* value = malloc(sizeof(long long int));
+        long long int* value = allocValue(sizeof(long long int));
         *value = llabs(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_LONG, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_LONG, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = fabs(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
 
     return 0; // return code
@@ -148,27 +148,27 @@ int std_ROUND (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = round(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = round(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
 
     return 0; // return code
@@ -184,27 +184,27 @@ int std_FLOOR (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = floor(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = floor(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
 
     return 0; // return code
@@ -220,27 +220,27 @@ int std_CEIL (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = ceil(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = ceil(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
 
     return 0; // return code
@@ -257,28 +257,28 @@ int std_POW (Process* process, const Variable* args, int argc) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         long long int in_val2 = getSignedNumber((Variable*)&args[1]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = pow(in_val, in_val2);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         double in_val2 = getFloatNumber((Variable*)&args[1]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = pow(in_val, in_val2);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
 
     return 0; // return code
@@ -294,7 +294,7 @@ int std_MIN (Process* process, const Variable* args, int argc) {
             if (!checkIfFloating(args[0].type.dataType) && !checkIfFloating(args[1].type.dataType)) {
                 int cRes = castValue((Variable*)&args[0], (Type){TYPE_LONG, 1});
                 
-                long long int* value = malloc(sizeof(long long int));
+                long long int* value = allocValue(sizeof(long long int));
 
                 int arr_len = getVariablesLength((Variable*)args[0].value);
 
@@ -306,16 +306,16 @@ int std_MIN (Process* process, const Variable* args, int argc) {
 
                 *value = min;
 
-                Variable* var = malloc(sizeof(Variable));
-                *var = createVariable("-lit", TYPE_LONG, value, 0, 0);
+                Variable* var = allocValue(sizeof(Variable));
+                *var = createLiteral(TYPE_LONG, value, 0, 0);
                 setReturnValue(process, var);
 
                 destroyVariable(var);
-                free(var);
+                freeValue(var);
             } else {
                 int cRes = castValue((Variable*)&args[0], (Type){TYPE_DOUBLE, 1});
                 
-                double* value = malloc(sizeof(double));
+                double* value = allocValue(sizeof(double));
 
                 int arr_len = getVariablesLength((Variable*)args[0].value);
 
@@ -327,12 +327,12 @@ int std_MIN (Process* process, const Variable* args, int argc) {
 
                 *value = min;
                 
-                Variable* var = malloc(sizeof(Variable));
-                *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+                Variable* var = allocValue(sizeof(Variable));
+                *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
                 setReturnValue(process, var);
 
                 destroyVariable(var);
-                free(var);
+                freeValue(var);
             }
         } else {
             return ERROR_TYPE_MISMATCH;
@@ -342,28 +342,28 @@ int std_MIN (Process* process, const Variable* args, int argc) {
             long long int in_val = getSignedNumber((Variable*)&args[0]);
             long long int in_val2 = getSignedNumber((Variable*)&args[1]);
             
-            long long int* value = malloc(sizeof(long long int));
+            long long int* value = allocValue(sizeof(long long int));
             *value = in_val < in_val2 ? in_val : in_val2;
 
-            Variable* var = malloc(sizeof(Variable));
-            *var = createVariable("-lit", TYPE_LONG, value, 0, 0);
+            Variable* var = allocValue(sizeof(Variable));
+            *var = createLiteral(TYPE_LONG, value, 0, 0);
             setReturnValue(process, var);
 
             destroyVariable(var);
-            free(var);
+            freeValue(var);
         } else {
             double in_val = getFloatNumber((Variable*)&args[0]);
             double in_val2 = getFloatNumber((Variable*)&args[1]);
             
-            double* value = malloc(sizeof(double));
+            double* value = allocValue(sizeof(double));
             *value = in_val < in_val2 ? in_val : in_val2;
             
-            Variable* var = malloc(sizeof(Variable));
-            *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+            Variable* var = allocValue(sizeof(Variable));
+            *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
             setReturnValue(process, var);
 
             destroyVariable(var);
-            free(var);
+            freeValue(var);
         }
     }
     return 0; // return code
@@ -383,7 +383,7 @@ int std_MAX (Process* process, const Variable* args, int argc) {
                 int cRes = castValue((Variable*)&args[0], (Type){TYPE_LONG, 1});
                 if (cRes) return cRes;
                 
-                long long int* value = malloc(sizeof(long long int));
+                long long int* value = allocValue(sizeof(long long int));
 
                 int arr_len = getVariablesLength((Variable*)args[0].value);
 
@@ -395,17 +395,17 @@ int std_MAX (Process* process, const Variable* args, int argc) {
 
                 *value = max;
 
-                Variable* var = malloc(sizeof(Variable));
-                *var = createVariable("-lit", TYPE_LONG, value, 0, 0);
+                Variable* var = allocValue(sizeof(Variable));
+                *var = createLiteral(TYPE_LONG, value, 0, 0);
                 setReturnValue(process, var);
 
                 destroyVariable(var);
-                free(var);
+                freeValue(var);
             } else {
                 int cRes = castValue((Variable*)&args[0], (Type){TYPE_DOUBLE, 1});
                 if (cRes) return cRes;
                 
-                double* value = malloc(sizeof(double));
+                double* value = allocValue(sizeof(double));
 
                 int arr_len = getVariablesLength((Variable*)args[0].value);
 
@@ -417,12 +417,12 @@ int std_MAX (Process* process, const Variable* args, int argc) {
                 
                 *value = max;
                 
-                Variable* var = malloc(sizeof(Variable));
-                *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+                Variable* var = allocValue(sizeof(Variable));
+                *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
                 setReturnValue(process, var);
 
                 destroyVariable(var);
-                free(var);
+                freeValue(var);
             }
         } else {
             return ERROR_TYPE_MISMATCH;
@@ -432,28 +432,28 @@ int std_MAX (Process* process, const Variable* args, int argc) {
             long long int in_val = getSignedNumber((Variable*)&args[0]);
             long long int in_val2 = getSignedNumber((Variable*)&args[1]);
             
-            long long int* value = malloc(sizeof(long long int));
+            long long int* value = allocValue(sizeof(long long int));
             *value = in_val > in_val2 ? in_val : in_val2;
 
-            Variable* var = malloc(sizeof(Variable));
-            *var = createVariable("-lit", TYPE_LONG, value, 0, 0);
+            Variable* var = allocValue(sizeof(Variable));
+            *var = createLiteral(TYPE_LONG, value, 0, 0);
             setReturnValue(process, var);
 
             destroyVariable(var);
-            free(var);
+            freeValue(var);
         } else {
             double in_val = getFloatNumber((Variable*)&args[0]);
             double in_val2 = getFloatNumber((Variable*)&args[1]);
             
-            double* value = malloc(sizeof(double));
+            double* value = allocValue(sizeof(double));
             *value = in_val > in_val2 ? in_val : in_val2;
             
-            Variable* var = malloc(sizeof(Variable));
-            *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+            Variable* var = allocValue(sizeof(Variable));
+            *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
             setReturnValue(process, var);
 
             destroyVariable(var);
-            free(var);
+            freeValue(var);
         }
     }
     return 0; // return code
@@ -467,27 +467,27 @@ int std_LOG (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = log(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = log(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -500,27 +500,27 @@ int std_LOG10 (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = log10(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = log10(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -533,27 +533,27 @@ int std_SIN (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = sin(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = sin(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
 
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -566,27 +566,27 @@ int std_COS (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = cos(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = cos(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -599,27 +599,27 @@ int std_TAN (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = tan(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = tan(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -633,30 +633,30 @@ int std_ASIN (Process* process, const Variable* args, int argc) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         if (in_val < -1 || in_val > 1) return ERROR_MATH_DOMAIN_ERROR;
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = asin(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         if (in_val < -1 || in_val > 1) return ERROR_MATH_DOMAIN_ERROR;
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = asin(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -670,30 +670,30 @@ int std_ACOS (Process* process, const Variable* args, int argc) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         if (in_val < -1 || in_val > 1) return ERROR_MATH_DOMAIN_ERROR;
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = acos(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         if (in_val < -1 || in_val > 1) return ERROR_MATH_DOMAIN_ERROR;
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = acos(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -706,29 +706,29 @@ int std_ATAN (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = atan(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = atan(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -745,30 +745,30 @@ int std_ATAN2 (Process* process, const Variable* args, int argc) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         long long int in_val2 = getSignedNumber((Variable*)&args[1]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = atan2(in_val, in_val2);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         double in_val2 = getFloatNumber((Variable*)&args[1]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = atan2(in_val, in_val2);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -781,29 +781,29 @@ int std_EXP (Process* process, const Variable* args, int argc) {
     if (!checkIfFloating(args[0].type.dataType)) {
         long long int in_val = getSignedNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(long long int));
+        double* value = allocValue(sizeof(long long int));
         *value = exp(in_val);
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double in_val = getFloatNumber((Variable*)&args[0]);
         
-        double* value = malloc(sizeof(double));
+        double* value = allocValue(sizeof(double));
         *value = exp(in_val);
         
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 0);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 0);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -824,28 +824,28 @@ int std_QUADRATIC (Process* process, const Variable* args, int argc) {
         Variable* value = malloc(sizeof(Variable) * 3); // Array of 2 variables
 
         Variable* var1 = malloc(sizeof(Variable));
-        Variable* var2 = malloc(sizeof(Variable));
+        Variable* var2 = allocValue(sizeof(Variable));
 
-        double* value1 = malloc(sizeof(double));
-        double* value2 = malloc(sizeof(double));
+        double* value1 = allocValue(sizeof(double));
+        double* value2 = allocValue(sizeof(double));
 
         *value1 = (-b + sqrt(pow(b, 2) - 4 * a * c)) / (2 * a);
         *value2 = (-b - sqrt(pow(b, 2) - 4 * a * c)) / (2 * a);
 
-        *var1 = createVariable("-lit", TYPE_DOUBLE, value1, 0, 0);
-        *var2 = createVariable("-lit", TYPE_DOUBLE, value2, 0, 0);
+        *var1 = createLiteral(TYPE_DOUBLE, value1, 0, 0);
+        *var2 = createLiteral(TYPE_DOUBLE, value2, 0, 0);
 
         ((Variable*)value)[0] = *var1;
         ((Variable*)value)[1] = *var2;
         ((Variable*)value)[2] = createNullTerminatedVariable();
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 1);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 1);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     } else {
         double a = getFloatNumber((Variable*)&args[0]);
         double b = getFloatNumber((Variable*)&args[1]);
@@ -854,28 +854,28 @@ int std_QUADRATIC (Process* process, const Variable* args, int argc) {
         Variable* value = malloc(sizeof(Variable) * 3); // Array of 2 variables
         
         Variable* var1 = malloc(sizeof(Variable));
-        Variable* var2 = malloc(sizeof(Variable));
+        Variable* var2 = allocValue(sizeof(Variable));
 
-        double* value1 = malloc(sizeof(double));
-        double* value2 = malloc(sizeof(double));
+        double* value1 = allocValue(sizeof(double));
+        double* value2 = allocValue(sizeof(double));
 
         *value1 = (-b + sqrt(pow(b, 2) - 4 * a * c)) / (2 * a);
         *value2 = (-b - sqrt(pow(b, 2) - 4 * a * c)) / (2 * a);
 
-        *var1 = createVariable("-lit", TYPE_DOUBLE, value1, 0, 0);
-        *var2 = createVariable("-lit", TYPE_DOUBLE, value2, 0, 0);
+        *var1 = createLiteral(TYPE_DOUBLE, value1, 0, 0);
+        *var2 = createLiteral(TYPE_DOUBLE, value2, 0, 0);
 
         ((Variable*)value)[0] = *var1;
         ((Variable*)value)[1] = *var2;
         ((Variable*)value)[2] = createNullTerminatedVariable();
 
-        Variable* var = malloc(sizeof(Variable));
-        *var = createVariable("-lit", TYPE_DOUBLE, value, 0, 1);
+        Variable* var = allocValue(sizeof(Variable));
+        *var = createLiteral(TYPE_DOUBLE, value, 0, 1);
         
         setReturnValue(process, var);
         
         destroyVariable(var);
-        free(var);
+        freeValue(var);
     }
     return 0;
 }
@@ -44,16 +44,16 @@ int std_RANDINT (Process* process, const Variable* args, int argc) {
         return ERROR_TOO_MANY_ARGUMENTS;
     }
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
 
     *val = rand();
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -63,16 +63,16 @@ int std_RAND (Process* process, const Variable* args, int argc) {
         return ERROR_TOO_MANY_ARGUMENTS;
     }
 
-    double* val = malloc(sizeof(int));
+    double* val = allocValue(sizeof(int));
 
     *val = rand() / (double)RAND_MAX;
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_DOUBLE, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_DOUBLE, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -90,16 +90,16 @@ int std_RANDRANGE (Process* process, const Variable* args, int argc) {
     cRes = castValue((Variable*)&args[1], (Type){TYPE_INT, 0});
     if (cRes) return cRes;
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
 
     *val = rand() % (*(int*)args[1].value - *(int*)args[0].value) + *(int*)args[0].value;
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -69,21 +69,19 @@ int std_SPLIT (Process* process, const Variable* args, int argc) {
 
     char* sep = (char*)args[1].value;
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, NULL, 0, 1);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, NULL, 0, 1);
 
     char* token = strtok(str, sep);
 
     while (token != NULL) {
-        Variable* var2 = malloc(sizeof(Variable));
-        char* val = malloc(sizeof(char) * (strlen(token) + 1));
-        strcpy(val, token);
-        *var2 = createVariable("-lit", TYPE_STRING, val, 0, 0);
+        Variable* var2 = allocValue(sizeof(Variable));
+        *var2 = createLiteral(TYPE_STRING, allocString(token), 0, 0);
         int pRes = pushArray(var, var2);
         if (pRes) return pRes;
 
         destroyVariable(var2);
-        free(var2);
+        freeValue(var2);
         token = strtok(NULL, sep);
     }
 
@@ -95,7 +93,7 @@ int std_SPLIT (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -113,8 +111,8 @@ int std_LOWERCASE (Process* process, const Variable* args, int argc) {
 
     char* str = (char*)args[0].value;
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, NULL, 0, 0);
 
     char* val = malloc(sizeof(char) * (strlen(str) + 1));
     strcpy(val, str);
@@ -130,7 +128,7 @@ int std_LOWERCASE (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -148,8 +146,8 @@ int std_UPPERCASE (Process* process, const Variable* args, int argc) {
 
     char* str = (char*)args[0].value;
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, NULL, 0, 0);
 
     char* val = malloc(sizeof(char) * (strlen(str) + 1));
     strcpy(val, str);
@@ -165,7 +163,7 @@ int std_UPPERCASE (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -181,10 +179,10 @@ int std_LENGTH (Process* process, const Variable* args, int argc) {
     int cRes = castValue((Variable*)&args[0], (Type){TYPE_STRING, 0});
     if (cRes) return cRes;
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, NULL, 0, 0);
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     *val = strlen((char*)args[0].value);
 
     var->value = val;
@@ -192,7 +190,7 @@ int std_LENGTH (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -231,8 +229,8 @@ int std_SUBSTRING (Process* process, const Variable* args, int argc) {
         return ERROR_ARRAY_OUT_OF_BOUNDS;
     }
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, NULL, 0, 0);
 
     char* val = malloc(sizeof(char) * (end - start + 2));
     strncpy(val, str + start, end - start + 1);
@@ -243,7 +241,7 @@ int std_SUBSTRING (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -281,10 +279,10 @@ int std_INDEXOF (Process* process, const Variable* args, int argc) {
 
     char* res = strstr(str + start, substr);
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, NULL, 0, 0);
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     if (res == NULL) {
         *val = -1;
     } else {
@@ -296,7 +294,7 @@ int std_INDEXOF (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -340,10 +338,10 @@ int std_LASTINDEXOF (Process* process, const Variable* args, int argc) {
         }
     }
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, NULL, 0, 0);
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     if (res == NULL) {
         *val = -1;
     } else {
@@ -355,7 +353,7 @@ int std_LASTINDEXOF (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -393,10 +391,10 @@ int std_STARTSWITH (Process* process, const Variable* args, int argc) {
 
     int res = strncmp(str + start, substr, strlen(substr)) == 0;
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, NULL, 0, 0);
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     *val = res;
 
     var->value = val;
@@ -404,7 +402,7 @@ int std_STARTSWITH (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -442,10 +440,10 @@ int std_ENDSWITH (Process* process, const Variable* args, int argc) {
 
     int res = strncmp(str + start, substr, strlen(substr)) == 0;
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, NULL, 0, 0);
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     *val = res;
 
     var->value = val;
@@ -453,7 +451,7 @@ int std_ENDSWITH (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -471,8 +469,8 @@ int std_TRIM (Process* process, const Variable* args, int argc) {
     
     char* str = (char*)args[0].value;
     
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, NULL, 0, 0);
     
     char* val = malloc(sizeof(char) * (strlen(str) + 1));
     strcpy(val, str);
@@ -490,15 +488,13 @@ int std_TRIM (Process* process, const Variable* args, int argc) {
     
     val[end + 1] = '\0';
     
-    char* val2 = malloc(sizeof(char) * (strlen(val + start) + 1));
-    strcpy(val2, val + start);
-    
-    var->value = val2;
+    var->value = allocString(val + start);
+    free(val);
     
     setReturnValue(process, var);
     
     destroyVariable(var);
-    free(var);
+    freeValue(var);
     
     return 0; // return code
 }
@@ -516,8 +512,8 @@ int std_REVERSE (Process* process, const Variable* args, int argc) {
     
     char* str = (char*)args[0].value;
     
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, NULL, 0, 0);
     
     char* val = malloc(sizeof(char) * (strlen(str) + 1));
     strcpy(val, str);
@@ -533,7 +529,7 @@ int std_REVERSE (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
     
     destroyVariable(var);
-    free(var);
+    freeValue(var);
     
     return 0; // return code
 }
@@ -594,13 +590,13 @@ int std_REPLACE (Process* process, const Variable* args, int argc) {
         res = strstr(val + start, substr);
     }
     
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, val, 0, 0);
     
     setReturnValue(process, var);
     
     destroyVariable(var);
-    free(var);
+    freeValue(var);
     
     return 0; // return code
 }
@@ -640,10 +636,10 @@ int std_CONTAINS (Process* process, const Variable* args, int argc) {
     
     char* res = strstr(str + start, substr);
     
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_BOOL, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_BOOL, NULL, 0, 0);
     
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     *val = res != NULL;
     
     var->value = val;
@@ -651,7 +647,7 @@ int std_CONTAINS (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
     
     destroyVariable(var);
-    free(var);
+    freeValue(var);
     
     return 0; // return code
 }
@@ -696,13 +692,13 @@ int std_REMOVE (Process* process, const Variable* args, int argc) {
     strcat(val, str + start + amount);
 
     
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, val, 0, 0);
     
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -745,13 +741,13 @@ int std_INSERT (Process* process, const Variable* args, int argc) {
     strcat(val, substr);
     strcat(val, str + index);
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, val, 0, 0);
 
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -769,10 +765,10 @@ int std_STRINGTOINT (Process* process, const Variable* args, int argc) {
     
     char* str = (char*)args[0].value;
     
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_LONG, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_LONG, NULL, 0, 0);
     
-    long long int* val = malloc(sizeof(long long int));
+    long long int* val = allocValue(sizeof(long long int));
     *val = atoll(str);
     
     var->value = val;
@@ -780,7 +776,7 @@ int std_STRINGTOINT (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
     
     destroyVariable(var);
-    free(var);
+    freeValue(var);
     
     return 0; // return code
 }
@@ -798,10 +794,10 @@ int std_STRINGTODOUBLE (Process* process, const Variable* args, int argc) {
     
     char* str = (char*)args[0].value;
     
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_DOUBLE, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_DOUBLE, NULL, 0, 0);
     
-    double* val = malloc(sizeof(double));
+    double* val = allocValue(sizeof(double));
     *val = atof(str);
     
     var->value = val;
@@ -809,7 +805,7 @@ int std_STRINGTODOUBLE (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
     
     destroyVariable(var);
-    free(var);
+    freeValue(var);
     
     return 0; // return code
 }
@@ -842,10 +838,10 @@ int std_COUNT (Process* process, const Variable* args, int argc) {
         res = strstr(res + strlen(substr), substr);
     }
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, NULL, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, NULL, 0, 0);
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
     *val = count;
 
     var->value = val;
@@ -853,7 +849,7 @@ int std_COUNT (Process* process, const Variable* args, int argc) {
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
     
     return 0; // return code
 }
@@ -27,17 +27,17 @@ int std_SYSTEM (Process* process, const Variable* args, int argc) {
     int cRes = castValue((Variable*)&args[0], (Type){TYPE_STRING, 0});
     if (cRes) return cRes;
 
-    int* returnCode = malloc(sizeof(int));
+    int* returnCode = allocValue(sizeof(int));
 
     *returnCode = system((char*)args[0].value); // storing cmd code in returnCode
 
     
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, returnCode, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, returnCode, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
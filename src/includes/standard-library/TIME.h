@@ -34,16 +34,16 @@ int std_TIME (Process* process, const Variable* args, int argc) {
         return ERROR_TOO_MANY_ARGUMENTS;
     }
 
-    int* val = malloc(sizeof(int));
+    int* val = allocValue(sizeof(int));
 
     *val = time(NULL);
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_INT, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_INT, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -65,12 +65,12 @@ int std_DATE (Process* process, const Variable* args, int argc) {
 
     sprintf(val, "%d-%d-%d", tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900);
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -92,12 +92,12 @@ int std_DATETIME (Process* process, const Variable* args, int argc) {
 
     sprintf(val, "%d-%d-%d %d:%d:%d", tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -119,12 +119,12 @@ int std_TIMESTAMP (Process* process, const Variable* args, int argc) {
 
     sprintf(val, "%d:%d:%d", tm.tm_hour, tm.tm_min, tm.tm_sec);
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_STRING, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_STRING, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -134,16 +134,16 @@ int std_CLOCK (Process* process, const Variable* args, int argc) {
         return ERROR_TOO_MANY_ARGUMENTS;
     }
 
-    long long int* val = malloc(sizeof(long long int));
+    long long int* val = allocValue(sizeof(long long int));
 
     *val = (long long int)clock();
 
-    Variable* var = malloc(sizeof(Variable));
-    *var = createVariable("-lit", TYPE_LONG, val, 0, 0);
+    Variable* var = allocValue(sizeof(Variable));
+    *var = createLiteral(TYPE_LONG, val, 0, 0);
     setReturnValue(process, var);
 
     destroyVariable(var);
-    free(var);
+    freeValue(var);
 
     return 0; // return code
 }
@@ -188,6 +188,18 @@ int standard_call (Process* process, const char* name, const Variable* args, int
         return std_RANGEF(process, args, argc);
     } else if (!strcmp (name, "FILL")) {
         return std_FILL(process, args, argc);
+    } else if (!strcmp (name, "COUNTTRUE")) {
+        return std_COUNTTRUE(process, args, argc);
+    } else if (!strcmp (name, "ANY")) {
+        return std_ANY(process, args, argc);
+    } else if (!strcmp (name, "ALL")) {
+        return std_ALL(process, args, argc);
+    } else if (!strcmp (name, "ARRAYAND")) {
+        return std_ARRAYBITWISE(process, args, argc, OPERATOR_AND);
+    } else if (!strcmp (name, "ARRAYOR")) {
+        return std_ARRAYBITWISE(process, args, argc, OPERATOR_OR);
+    } else if (!strcmp (name, "ARRAYXOR")) {
+        return std_ARRAYBITWISE(process, args, argc, OPERATOR_XOR);
     }
     return ERROR_FUNCTION_NOT_FOUND;
 }
@@ -11,11 +11,12 @@
 
 #include <stdio.h>
 
-#define MASTER_KEYWORDS {"DO", "MAKE", "SET"}
-#define EXTENSION_KEYWORDS {"WHEN", "WHILE", "ELSE", "CATCH", "INTO", "THEN", "FOR", "IF"}
-#define EXTENSION_ACCEPTS {NEEDS_EXPRESSION, NEEDS_EXPRESSION, NEEDS_IF_OR_FUNCTION, NEEDS_FUNCTION, NEEDS_EXPRESSION, NEEDS_FUNCTION, NEEDS_EXPRESSION, NEEDS_EXPRESSION}
+#define MASTER_KEYWORDS {"DO", "MAKE", "SET", "IMPORT"}
+#define EXTENSION_KEYWORDS {"WHEN", "WHILE", "ELSE", "CATCH", "INTO", "THEN", "FOR", "IF", "PFOR"}
+#define EXTENSION_ACCEPTS {NEEDS_EXPRESSION, NEEDS_EXPRESSION, NEEDS_IF_OR_FUNCTION, NEEDS_FUNCTION, NEEDS_EXPRESSION, NEEDS_FUNCTION, NEEDS_EXPRESSION, NEEDS_EXPRESSION, NEEDS_EXPRESSION}
 #define VAR_TYPES {"INT", "BOOL", "STRING", "FLOAT", "DOUBLE", "CHAR", "SHORT", "LONG", "BYTE", "VOID", "ARRAY", "FUNC", "UINT", "USHORT", "ULONG", "UBYTE", "STRUCT"}
 #define SEPARATORS {';'}
+#define MEMO_KEYWORD "MEMO" // written between MAKE and FUNC, the function caches it's results
 #define OPERATORS {"+", "-", "*", "/", "%", "=", ">", "<", "!", "&", "^", "|", "~", "?", ":", ".", ",", "#",  \
                    "+=","-=","*=","/=","%=","++","--","==","!=",">=","<=","&&","||","<<",">>","&=","|=","^=", \
                    "**","^/","|>","<|","!-", "=>"}
@@ -113,13 +114,16 @@ typedef enum {
     TYPE_USHORT,
     TYPE_ULONG,
     TYPE_UBYTE,
-    TYPE_STRUCT
+    TYPE_STRUCT,
+    TYPE_BITS, // marks the header of a packed BOOL array, never the type of a variable
+    TYPE_MATRIX // marks the header of a dense array of numbers, never the type of a variable
 } DataType;
 
 typedef enum {
     MASTER_DO,
     MASTER_MAKE,
     MASTER_SET,
+    MASTER_IMPORT,
 
     M_NULL = -1
 } MasterKeywordType;
@@ -133,6 +137,7 @@ typedef enum {
     EXT_THEN,
     EXT_FOR,
     EXT_IF,
+    EXT_PFOR,
 
     E_NULL = -1
 } ExtensionKeywordType;
@@ -141,6 +146,7 @@ typedef struct {
     int start, end;
     TokenType type;
     int carry;
+    int block; // for brackets, the index of the matching bracket (the token's own index when unmatched)
 } Token;
 
 typedef enum {
@@ -0,0 +1,310 @@
+/**
+ * @author Sebastiaan Heins
+ * @file validator.h
+ * @brief Checks the shape of an AST before it is executed, so the interpreter doesn't have to check it while running
+ * @version 1.0
+ * @date 18-10-2026
+*/
+
+#ifndef VALIDATOR_H
+#define VALIDATOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "token.h"
+#include "node.h"
+#include "ast.h"
+#include "log.h"
+#include "error.h"
+
+/**
+ * @brief The state of a validation pass
+*/
+typedef struct {
+    AST* ast;
+    int report; // whether or not every error is printed when it's found
+    int error_count;
+    int first_error;
+    int first_position; // the character the first error is at
+} Validator;
+
+/**
+ * @brief Create a validator for an AST
+ * @param ast The AST to validate
+ * @param report Whether or not to print every error when it's found, errors found while the program runs are left to the caller
+ * @return The validator
+*/
+Validator createValidator (AST* ast, int report);
+
+/**
+ * @brief Validate the AST of a validator
+ * @param validator The validator, it keeps the first error found
+ * @return The amount of errors found
+*/
+int validateAST (Validator* validator);
+
+/**
+ * @brief Validate a subtree of the AST of a validator
+ * @param validator The validator, it keeps the first error found
+ * @param node The root of the subtree
+ * @return The amount of errors found
+*/
+int validateTree (Validator* validator, Node* node);
+
+/**
+ * @brief Validate a node and all of it's children
+ * @param validator The validator
+ * @param node The node to validate
+*/
+void validateNode (Validator* validator, Node* node);
+
+/**
+ * @brief Validate a call chain starting at a given extension, together with the chains of its ELSE branches
+ * @param validator The validator
+ * @param func The function call node
+ * @param start The index of the first call of the chain
+ * @param visited Marks which starts have already been validated, so every ELSE branch is reported once
+*/
+void validateCallChain (Validator* validator, Node* func, int start, char* visited);
+
+/**
+ * @brief Validate a function call to an existing function
+ * @param validator The validator
+ * @param call The function identifier node
+*/
+void validateCall (Validator* validator, Node* call);
+
+/**
+ * @brief Validate a FOR expression, which must be: array => identifier
+ * @param validator The validator
+ * @param expression The expression after the FOR
+*/
+void validateForExpression (Validator* validator, Node* expression);
+
+/**
+ * @brief Record an error found during validation
+ * @param validator The validator
+ * @param code The error code
+ * @param token The index of the token the error is at
+*/
+void addValidationError (Validator* validator, ErrorType code, int token);
+
+/**
+ * @brief Link every call chain in a tree, storing the location of the WHEN, WHILE or FOR of every call so it doesn't have to be searched for on every call
+ * @param node The root of the tree
+ * @note This must run after the optimizer, since it may remove extensions from call chains
+*/
+void linkCallChains (Node* node);
+
+
+Validator createValidator (AST* ast, int report) {
+    Validator validator = { ast, report, 0, 0, 0 };
+    return validator;
+}
+
+int validateAST (Validator* validator) {
+    return validateTree(validator, &validator->ast->root);
+}
+
+int validateTree (Validator* validator, Node* node) {
+    validateNode(validator, node);
+    return validator->error_count;
+}
+
+void validateNode (Validator* validator, Node* node) {
+    switch (node->type) {
+        case NODE_FUNCTION_CALL: {
+            int length = getNodeBodyLength(node->body);
+            char* visited = calloc(length + 1, sizeof(char));
+            validateCallChain(validator, node, 0, visited);
+            free(visited);
+            break;
+        }
+        case NODE_FUNCTION_IDENTIFIER:
+            validateCall(validator, node);
+            break;
+        case NODE_MAKE_VAR:
+            if (node->body[0].type != NODE_TYPE_IDENTIFIER) {
+                addValidationError(validator, ERROR_EXPECTED_TYPE, node->body[0].start);
+            } else if (node->body[1].type != NODE_IDENTIFIER) {
+                addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, node->body[1].start);
+            }
+            break;
+        case NODE_SET_VAR:
+            if (node->body[1].type != NODE_OPERATOR || !isAssignmentOperator(validator->ast->tokens[node->body[1].start].carry)) {
+                addValidationError(validator, ERROR_EXPECTED_ASSIGN_OPERATOR, node->body[1].start);
+            }
+            break;
+        case NODE_FUNCTION_DECLARATION:
+            if (node->body[0].type != NODE_TYPE_IDENTIFIER) {
+                addValidationError(validator, ERROR_EXPECTED_TYPE, node->body[0].start);
+            } else if (node->body[1].type != NODE_IDENTIFIER) {
+                addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, node->body[1].start);
+            } else if (node->body[2].type != NODE_FUNCTION_DECLARATION_ARGUMENTS) {
+                addValidationError(validator, ERROR_EXPECTED_ARGUMENTS, node->body[2].start);
+            } else if (node->body[3].type != NODE_BLOCK && node->body[3].type != NODE_UNPARSED_BLOCK) {
+                addValidationError(validator, ERROR_EXPECTED_BLOCK, node->body[3].start);
+            } else {
+                // every argument is a type followed by a name, array types nest the rest of the argument
+                for (int i = 0; i < getNodeBodyLength(node->body[2].body); i++) {
+                    Node* end_node = &node->body[2].body[i];
+                    while (validator->ast->tokens[end_node->body[0].start].carry == TYPE_ARRAY) {
+                        end_node = &end_node->body[1];
+                    }
+                    if (end_node->body[1].type != NODE_IDENTIFIER) {
+                        addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, end_node->body[1].start);
+                    }
+                }
+            }
+            break;
+        case NODE_BLOCK_EXPRESSION:
+            if (node->start > node->end) {
+                addValidationError(validator, ERROR_INVALID_EXPRESSION, node->start); // an empty block can't produce a value
+            }
+            break;
+        default:
+            break;
+    }
+
+    for (int i = 0; i < getNodeBodyLength(node->body); i++) {
+        validateNode(validator, &node->body[i]);
+    }
+}
+
+void validateCallChain (Validator* validator, Node* func, int start, char* visited) {
+    if (func->body == NULL) {
+        addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, func->start);
+        return;
+    }
+    int length = getNodeBodyLength(func->body);
+    if (start >= length || visited[start]) return;
+    visited[start] = 1;
+
+    Node* body = func->body;
+    if (body[start].type != NODE_FUNCTION_IDENTIFIER && body[start].type != NODE_BLOCK && body[start].type != NODE_IF) {
+        addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, body[start].start);
+        return;
+    }
+
+    // find the WHEN, WHILE or FOR, these encompass everything before it
+    int condition = -1;
+    for (int i = start; i < length; i++) {
+        if (body[i].type == NODE_WHEN || body[i].type == NODE_WHILE || body[i].type == NODE_FOR || body[i].type == NODE_PFOR) {
+            condition = i;
+            break;
+        }
+    }
+    int end = condition == -1 ? length : condition;
+
+    int chain_start = start;
+    if (body[start].type == NODE_IF) {
+        if (start + 1 >= length || body[start + 1].type != NODE_EXPRESSION) {
+            addValidationError(validator, ERROR_EXPECTED_EXPRESSION, start + 1 >= length ? body[start].start : body[start + 1].start);
+            return;
+        }
+        if (start + 2 >= length || body[start + 2].type != NODE_THEN) {
+            addValidationError(validator, ERROR_INVALID_EXTENSION, body[start].start);
+            return;
+        }
+        if (start + 3 >= length || (body[start + 3].type != NODE_FUNCTION_IDENTIFIER && body[start + 3].type != NODE_BLOCK)) {
+            addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, body[start + 2].start);
+            return;
+        }
+        if (start + 4 < end && body[start + 4].type == NODE_ELSE) {
+            validateCallChain(validator, func, start + 5, visited);
+        }
+
+        // the chain continues after the ELSE IF branches
+        chain_start = start + 3;
+        if (chain_start + 1 < length && body[chain_start + 1].type == NODE_ELSE) {
+            chain_start++;
+            while (chain_start + 1 < end && body[chain_start].type == NODE_ELSE && body[chain_start + 1].type == NODE_IF) {
+                chain_start += 5;
+            }
+        }
+    }
+
+    // CATCH and INTO can only be at the end of the call chain
+    for (int i = chain_start + 1; i < end; i += 2) {
+        if ((body[i].type == NODE_CATCH || body[i].type == NODE_INTO) && i + 2 != end) {
+            addValidationError(validator, ERROR_EXTENSION_NOT_FINAL, body[i].start);
+        }
+    }
+
+    if (condition == -1) return;
+    if (condition + 1 >= length) {
+        addValidationError(validator, ERROR_EXPECTED_EXPRESSION, body[condition].start);
+        return;
+    }
+    switch (body[condition].type) {
+        case NODE_WHILE:
+            if (condition + 1 != length - 1) {
+                addValidationError(validator, ERROR_WHILE_NOT_LAST, body[condition].start);
+            }
+            break;
+        case NODE_WHEN:
+            if (condition + 1 == length - 1) break;
+            if (condition + 2 >= length || body[condition + 2].type != NODE_ELSE) {
+                addValidationError(validator, ERROR_EXPECTED_ELSE, body[condition].start);
+                break;
+            }
+            validateCallChain(validator, func, condition + 3, visited);
+            break;
+        case NODE_FOR:
+        case NODE_PFOR:
+            validateForExpression(validator, &body[condition + 1]);
+            break;
+        default:
+            break;
+    }
+}
+
+void validateCall (Validator* validator, Node* call) {
+    if (call->body[0].type != NODE_IDENTIFIER) {
+        addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, call->body[0].start);
+    } else if (call->body[1].type != NODE_ARGUMENTS) {
+        addValidationError(validator, ERROR_EXPECTED_ARGUMENTS, call->body[1].start);
+    }
+}
+
+void validateForExpression (Validator* validator, Node* expression) {
+    if (expression->type != NODE_EXPRESSION) {
+        addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, expression->start);
+    } else if (getNodeBodyLength(expression->body) != 3) {
+        addValidationError(validator, ERROR_INVALID_EXPRESSION, expression->start);
+    } else if (expression->body[1].type != NODE_OPERATOR || validator->ast->tokens[expression->body[1].start].carry != OPERATOR_AS) {
+        addValidationError(validator, ERROR_INVALID_OPERATOR, expression->body[1].start);
+    } else if (expression->body[2].type != NODE_IDENTIFIER) {
+        addValidationError(validator, ERROR_EXPECTED_IDENTIFIER, expression->body[2].start);
+    }
+}
+
+void addValidationError (Validator* validator, ErrorType code, int token) {
+    int position = validator->ast->tokens[token].start;
+    if (validator->report) reportError(validator->ast->full_code, position, code);
+    if (validator->error_count == 0) {
+        validator->first_error = code;
+        validator->first_position = position;
+    }
+    validator->error_count++;
+}
+
+void linkCallChains (Node* node) {
+    int length = getNodeBodyLength(node->body);
+    if (node->type == NODE_FUNCTION_CALL) {
+        int chain = -1;
+        for (int i = length - 1; i >= 0; i--) {
+            if (node->body[i].type == NODE_WHEN || node->body[i].type == NODE_WHILE || node->body[i].type == NODE_FOR || node->body[i].type == NODE_PFOR) {
+                chain = i;
+            }
+            node->body[i].chain = chain;
+        }
+    }
+    for (int i = 0; i < length; i++) {
+        linkCallChains(&node->body[i]);
+    }
+}
+
+#endif
@@ -15,6 +15,7 @@
 
 #include "token.h"
 #include "strtools.h"
+#include "allocator.h"
 
 typedef struct {
     DataType dataType;
@@ -26,6 +27,7 @@ typedef struct {
     Type type;
     void* value;
     int constant;
+    int literal; // temporary values are literals, they are owned by whoever evaluated them and must be destroyed by them
 } Variable;
 
 /**
@@ -39,6 +41,16 @@ typedef struct {
 */
 Variable createVariable (const char* name, const DataType type, void* valueptr, const int constant, int array);
 
+/**
+ * @brief Create a literal, a nameless temporary value owned by whoever evaluated it
+ * @param type The type of the literal
+ * @param valueptr The pointer to the value of the literal
+ * @param constant Whether or not the literal is constant
+ * @param array Whether or not the literal is an array (0 means no array, everything above 1 means array, 2 means array of arrays, etc.)
+ * @return The literal
+*/
+Variable createLiteral (const DataType type, void* valueptr, const int constant, int array);
+
 /**
  * @brief Create a null terminated variable
  * @return The null terminated variable
@@ -59,6 +71,18 @@ int getVariablesLength (const Variable* list);
 */
 void destroyVariable (Variable* variable);
 
+/**
+ * @brief Destroys a variable only if it's a literal, borrowed variables are left untouched
+ * @param variable The variable to destroy
+*/
+void destroyLiteral (Variable* variable);
+
+/**
+ * @brief Destroys the value of a variable, keeping the name
+ * @param variable The variable to destroy the value of
+*/
+void destroyValue (Variable* variable);
+
 /**
  * @brief Convert a variable to a string
  * @param variable The variable to convert
@@ -128,13 +152,27 @@ int compareType (Type left, Type right);
 
 int printType (Type t);
 
+#include "bitarray.h"
+#include "matrix.h"
+#include "packedarray.h"
+
 Variable createVariable (const char* name, const DataType type, void* valueptr, const int constant, int array) {
     Variable variable;
-    variable.name = malloc(sizeof(char) * (strlen(name) + 1));
-    strcpy(variable.name, name);
+    variable.name = NULL;
+    if (name != NULL) {
+        variable.name = malloc(sizeof(char) * (strlen(name) + 1));
+        strcpy(variable.name, name);
+    }
     variable.type = (Type){type, array};
     variable.value = valueptr;
     variable.constant = constant;
+    variable.literal = 0;
+    return variable;
+}
+
+Variable createLiteral (const DataType type, void* valueptr, const int constant, int array) {
+    Variable variable = createVariable(NULL, type, valueptr, constant, array);
+    variable.literal = 1;
     return variable;
 }
 
@@ -144,10 +182,13 @@ Variable createNullTerminatedVariable () {
     variable.name = NULL;
     variable.value = NULL;
     variable.constant = 0;
+    variable.literal = 0;
     return variable;
 }
 
 int getVariablesLength (const Variable* list) {
+    if (list[0].type.dataType == TYPE_BITS) return ((const BitArray*)list)->length;
+    if (list[0].type.dataType == TYPE_MATRIX) return ((const Matrix*)list)->length;
     int length = 0;
     while (list[length].type.dataType != D_NULL) {
         length++;
@@ -156,32 +197,23 @@ int getVariablesLength (const Variable* list) {
 }
 
 void destroyVariable (Variable* variable) {
-    // if the variable is already destroyed, return
-    if (variable->name == NULL) {
-        return;
-    }
-    free(variable->name);
-    variable->name = NULL;
-
-    if (variable->type.array) {
-        Variable* array = (Variable*)variable->value;
-        int array_length = getVariablesLength(array);
-        for (int i = 0; i < array_length; i++) {
-            destroyVariable(&array[i]);
-        }
+    // literals don't have a name, destroying an already destroyed variable is a no-op
+    if (variable->name != NULL) {
+        free(variable->name);
+        variable->name = NULL;
     }
+    destroyValue(variable);
+}
 
-    switch (variable->type.dataType) {
-        default:
-            if (variable->value == NULL) return;
-            free(variable->value);
-            variable->value = NULL;
-            break;
+void destroyLiteral (Variable* variable) {
+    if (variable->literal) {
+        destroyVariable(variable);
     }
 }
 
 void destroyValue (Variable* variable) {
-    if (variable->type.array) {
+    if (variable->value == NULL) return;
+    if (variable->type.array && !isPackedArray(variable)) {
         Variable* array = (Variable*)variable->value;
         int array_length = getVariablesLength(array);
         for (int i = 0; i < array_length; i++) {
@@ -192,7 +224,7 @@ void destroyValue (Variable* variable) {
     switch (variable->type.dataType) {
         default:
             if (variable->value == NULL) return;
-            free(variable->value);
+            freeValue(variable->value);
             variable->value = NULL;
             break;
     }
@@ -209,6 +241,8 @@ void destroyVariableRef (Variable* variable) {
 char* toString (Variable* variable) {
     char* str = NULL;
     
+    if (isBitArray(variable)) return bitArrayToString((BitArray*)variable->value);
+    if (isMatrix(variable)) return matrixToString((Matrix*)variable->value);
     if (variable->type.array) {
         int array_length = getVariablesLength((Variable*)variable->value);
         str = malloc(sizeof(char) * 3);
@@ -278,65 +312,68 @@ char* toString (Variable* variable) {
 }
 
 Variable cloneVariable (const Variable* variable) {
-    Variable new_variable = createVariable("-lit", variable->type.dataType, NULL, variable->constant, variable->type.array);
+    Variable new_variable = createLiteral(variable->type.dataType, NULL, variable->constant, variable->type.array);
     if (!variable->type.array) {
         switch (variable->type.dataType) {
             case TYPE_CHAR:
-                new_variable.value = malloc(sizeof(char));
+                new_variable.value = allocValue(sizeof(char));
                 *(char*)new_variable.value = *(char*)variable->value;
                 break;
             case TYPE_STRING:
-                new_variable.value = malloc(sizeof(char) * (strlen((char*)variable->value) + 1));
-                strcpy((char*)new_variable.value, (char*)variable->value);
+                new_variable.value = allocString((char*)variable->value);
                 break;
             case TYPE_BOOL:
-                new_variable.value = malloc(sizeof(int));
+                new_variable.value = allocValue(sizeof(int));
                 *(int*)new_variable.value = *(int*)variable->value;
                 break;
             case TYPE_BYTE:
-                new_variable.value = malloc(sizeof(signed char));
+                new_variable.value = allocValue(sizeof(signed char));
                 *(signed char*)new_variable.value = *(signed char*)variable->value;
                 break;
             case TYPE_SHORT:
-                new_variable.value = malloc(sizeof(short));
+                new_variable.value = allocValue(sizeof(short));
                 *(short*)new_variable.value = *(short*)variable->value;
                 break;
             case TYPE_INT:
-                new_variable.value = malloc(sizeof(int));
+                new_variable.value = allocValue(sizeof(int));
                 *(int*)new_variable.value = *(int*)variable->value;
                 break;
             case TYPE_LONG:
-                new_variable.value = malloc(sizeof(long long int));
+                new_variable.value = allocValue(sizeof(long long int));
                 *(long long int*)new_variable.value = *(long long int*)variable->value;
                 break;
             case TYPE_UBYTE:
-                new_variable.value = malloc(sizeof(unsigned char));
+                new_variable.value = allocValue(sizeof(unsigned char));
                 *(unsigned char*)new_variable.value = *(unsigned char*)variable->value;
                 break;
             case TYPE_USHORT:
-                new_variable.value = malloc(sizeof(unsigned short));
+                new_variable.value = allocValue(sizeof(unsigned short));
                 *(unsigned short*)new_variable.value = *(unsigned short*)variable->value;
                 break;
             case TYPE_UINT:
-                new_variable.value = malloc(sizeof(unsigned int));
+                new_variable.value = allocValue(sizeof(unsigned int));
                 *(unsigned int*)new_variable.value = *(unsigned int*)variable->value;
                 break;
             case TYPE_ULONG:
-                new_variable.value = malloc(sizeof(unsigned long long int));
+                new_variable.value = allocValue(sizeof(unsigned long long int));
                 *(unsigned long long int*)new_variable.value = *(unsigned long long int*)variable->value;
                 break;
             case TYPE_FLOAT:
-                new_variable.value = malloc(sizeof(float));
+                new_variable.value = allocValue(sizeof(float));
                 *(float*)new_variable.value = *(float*)variable->value;
                 break;
             case TYPE_DOUBLE:
-                new_variable.value = malloc(sizeof(double));
+                new_variable.value = allocValue(sizeof(double));
                 *(double*)new_variable.value = *(double*)variable->value;
                 break;
             default:
                 // for now, nothing happens
                 break;
         }
+    } else if (isBitArray(variable)) {
+        new_variable.value = cloneBitArray((BitArray*)variable->value);
+    } else if (isMatrix(variable)) {
+        new_variable.value = cloneMatrix((Matrix*)variable->value);
     } else {
         Variable* array = (Variable*)variable->value;
         int array_length = getVariablesLength(array);
@@ -371,6 +408,8 @@ void* cloneValue (const Variable* variable) {
                 return NULL;
         }
     }
+    if (isBitArray(variable)) return cloneBitArray((BitArray*)variable->value);
+    if (isMatrix(variable)) return cloneMatrix((Matrix*)variable->value);
     Variable* array = (Variable*)variable->value;
     int array_length = getVariablesLength(array);
     Variable* new_array = malloc(sizeof(Variable) * (array_length + 1));
@@ -513,14 +552,10 @@ int castValue (Variable* variable, Type type) {
                     return ERROR_ARRAY_CAST_ERROR;
                 case TYPE_STRING: {}
                     char* res = toString(variable);
-                    void* new_value = malloc(sizeof(char) * (strlen(res) + 1));
-                    strcpy((char*)new_value, res);
-                    free (res);
-                    char* name = malloc(sizeof(char) * (strlen(variable->name) + 1));
-                    strcpy(name, variable->name);
-                    destroyVariable(variable);
-                    *variable = createVariable(name, TYPE_STRING, new_value, 0, 0);
-
+                    destroyValue(variable);
+                    variable->value = res;
+                    variable->type = (Type){TYPE_STRING, 0};
+                    variable->constant = 0;
                     break;
                 case TYPE_BYTE:
                 case TYPE_SHORT:
@@ -534,17 +569,19 @@ int castValue (Variable* variable, Type type) {
                 case TYPE_DOUBLE:
                 case TYPE_BOOL: {}
                     int array_length = getVariablesLength((Variable*)variable->value);
-                    int* len_val = malloc(sizeof(int));
+                    int* len_val = allocValue(sizeof(int));
                     *len_val = array_length;
-                    Variable* val = malloc(sizeof(Variable));
-                    *val = createVariable(variable->name, TYPE_INT, len_val, 0, 0);
-                    int cRes = castValue(val, type);
-                    if (cRes) return cRes;
-
-                    destroyVariable(variable);
-                    *variable = cloneVariable(val);
-                    destroyVariable(val);
-                    free(val);
+                    Variable val = createLiteral(TYPE_INT, len_val, 0, 0);
+                    int cRes = castValue(&val, type);
+                    if (cRes) {
+                        destroyVariable(&val);
+                        return cRes;
+                    }
+
+                    destroyValue(variable);
+                    variable->value = val.value;
+                    variable->type = val.type;
+                    variable->constant = 0;
                     break;
             }
             return 0;
@@ -563,72 +600,71 @@ int castValue (Variable* variable, Type type) {
     void* new_value = NULL;
     switch (type.dataType) {
         case TYPE_BYTE:
-            new_value = malloc(sizeof(char));
+            new_value = allocValue(sizeof(char));
             *(signed char*)new_value = getSignedNumber(variable);
             variable->type.dataType = TYPE_BYTE;
             break;
         case TYPE_SHORT:
-            new_value = malloc(sizeof(short));
+            new_value = allocValue(sizeof(short));
             *(short*)new_value = getSignedNumber(variable);
             variable->type.dataType = TYPE_SHORT;
             break;
         case TYPE_INT:
-            new_value = malloc(sizeof(int));
+            new_value = allocValue(sizeof(int));
             *(int*)new_value = getSignedNumber(variable);
             variable->type.dataType = TYPE_INT;
             break;
         case TYPE_LONG:
-            new_value = malloc(sizeof(long long int));
+            new_value = allocValue(sizeof(long long int));
             *(long long int*)new_value = getSignedNumber(variable);
             variable->type.dataType = TYPE_LONG;
             break;
         case TYPE_CHAR:
         case TYPE_UBYTE:
-            new_value = malloc(sizeof(unsigned char));
+            new_value = allocValue(sizeof(unsigned char));
             *(unsigned char*)new_value = getUnsignedNumber(variable);
             variable->type.dataType = type.dataType;
             break;
         case TYPE_USHORT:
-            new_value = malloc(sizeof(unsigned short));
+            new_value = allocValue(sizeof(unsigned short));
             *(unsigned short*)new_value = getUnsignedNumber(variable);
             variable->type.dataType = TYPE_USHORT;
             break;
         case TYPE_UINT:
-            new_value = malloc(sizeof(unsigned int));
+            new_value = allocValue(sizeof(unsigned int));
             *(unsigned int*)new_value = getUnsignedNumber(variable);
             variable->type.dataType = TYPE_UINT;
             break;
         case TYPE_ULONG:
-            new_value = malloc(sizeof(unsigned long long int));
+            new_value = allocValue(sizeof(unsigned long long int));
             *(unsigned long long int*)new_value = getUnsignedNumber(variable);
             variable->type.dataType = TYPE_ULONG;
             break;
         case TYPE_FLOAT:
-            new_value = malloc(sizeof(float));
+            new_value = allocValue(sizeof(float));
             *(float*)new_value = getFloatNumber(variable);
             variable->type.dataType = TYPE_FLOAT;
             break;
         case TYPE_DOUBLE:
-            new_value = malloc(sizeof(double));
+            new_value = allocValue(sizeof(double));
             *(double*)new_value = getFloatNumber(variable);
             variable->type.dataType = TYPE_DOUBLE;
             break;
         case TYPE_BOOL:
-            new_value = malloc(sizeof(int));
+            new_value = allocValue(sizeof(int));
             *(int*)new_value = getSignedNumber(variable) != 0;
             variable->type.dataType = TYPE_BOOL;
             break;
         case TYPE_STRING: {}
             char* res = toString(variable);
-            new_value = malloc(sizeof(char) * (strlen(res) + 1));
-            strcpy((char*)new_value, res);
+            new_value = allocString(res);
             variable->type.dataType = TYPE_STRING;
             free(res);
             break;
         default:
             break;
     }
-    free(variable->value);
+    freeValue(variable->value);
     variable->value = new_value;
     return 0;
 }
@@ -640,6 +676,7 @@ int castArray (Variable* variable, Type type) {
     if (!getIfCastable(variable->type.dataType, type.dataType) && variable->type.dataType != TYPE_ARRAY) {
         return ERROR_CAST_ERROR;
     }
+    unpackArray(variable);
     int array_length = getVariablesLength((Variable*)variable->value);
     int array_depth = variable->type.array;
 
@@ -668,6 +705,7 @@ int pushArray (Variable* arr, Variable* val) {
     if (arr->type.array == 0) {
         return ERROR_ARRAY_CAST_ERROR;
     }
+    unpackArray(arr);
     if (arr->value == NULL) {
         arr->value = malloc(sizeof(Variable) * 2);
         ((Variable*)arr->value)[0] = cloneVariable(val);
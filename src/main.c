@@ -18,6 +18,7 @@
 #include "includes/ast_debug.h"
 #include "includes/ast.h"
 #include "includes/process.h"
+#include "includes/astcache.h"
 
 #define VERSION "0.9.1.1"
 #define PROGRAM_NAME "Dosato"
@@ -33,6 +34,11 @@ int QUIT (int code);
 
 // global variables
 int debug = 0;
+int eager_logic = 0;
+int use_cache = 1;
+int inline_functions = 1;
+int jobs = 0;
+int trim_threshold = 0;
 
 int main (int argc, char** argv)
 {
@@ -51,6 +57,11 @@ int main (int argc, char** argv)
         printf("\t-v, --version: Show the version number\n");
         printf("\t(PROGRAM_NAME): Run a file\n");
         printf("\t(PROGRAM_NAME) -d, --debug: Run a file in debug mode\n");
+        printf("\t(PROGRAM_NAME) -e, --eager: Always evaluate both sides of && and ||\n");
+        printf("\t(PROGRAM_NAME) --no-inline: Don't replace calls to small functions with the expression they return\n");
+        printf("\t(PROGRAM_NAME) --no-cache: Don't use the parsed program cache (DOSATO_CACHE sets its directory)\n");
+        printf("\t(PROGRAM_NAME) -j, --jobs (N): The amount of threads parsing imported modules and running PFOR loops, defaults to one per core\n");
+        printf("\t(PROGRAM_NAME) --trim-threshold (KB): The amount of free small value memory kept before empty slabs are given back to the system, defaults to 1024\n");
         
         return QUIT(0);
     }
@@ -74,8 +85,15 @@ int main (int argc, char** argv)
         return QUIT(1);
     }
     
-    // check if the file should be run in debug mode
-    debug = argv[2] != NULL && (!strcmp(argv[2], "-d") || !strcmp(argv[2], "--debug"));
+    // check the run flags
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "-d") || !strcmp(argv[i], "--debug")) debug = 1;
+        if (!strcmp(argv[i], "-e") || !strcmp(argv[i], "--eager")) eager_logic = 1;
+        if (!strcmp(argv[i], "--no-cache")) use_cache = 0;
+        if (!strcmp(argv[i], "--no-inline")) inline_functions = 0;
+        if ((!strcmp(argv[i], "-j") || !strcmp(argv[i], "--jobs")) && i + 1 < argc) jobs = atoi(argv[++i]);
+        if (!strcmp(argv[i], "--trim-threshold") && i + 1 < argc) trim_threshold = atoi(argv[++i]);
+    }
 
     // get the size of the file
     long long int size = 0;
@@ -97,7 +115,28 @@ int main (int argc, char** argv)
     }
 
     // the main process, containing the entry point of the program
-    Process main = createProcess(debug, 1, loadAST(argv[1], contents));
+    // parsed programs are cached by their contents, so unchanged scripts start without parsing
+    char* cache_dir = NULL;
+    if (use_cache) {
+        const char* cache_env = getenv("DOSATO_CACHE");
+        if (cache_env != NULL) {
+            // an empty DOSATO_CACHE turns the cache off
+            if (cache_env[0] != '\0') {
+                cache_dir = malloc(strlen(cache_env) + 1);
+                strcpy(cache_dir, cache_env);
+            }
+        } else {
+            cache_dir = getDefaultASTCacheDir();
+        }
+    }
+    Process main = createProcess(debug, 1, loadCachedAST(argv[1], contents, cache_dir, VERSION));
+    main.eager_logic = eager_logic;
+    main.inline_functions = inline_functions;
+    main.cache_dir = cache_dir; // imported modules share the cache, the process frees it
+    main.version = VERSION;
+    if (trim_threshold > 0) main.allocator->trim_threshold = (size_t)trim_threshold * 1024;
+    main.threads = jobs;
+    preloadModules(&main, jobs); // parse the imported modules on all cores before the program runs
 
     free(contents);
     /// DEBUG ///